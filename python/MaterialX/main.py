@@ -9,6 +9,23 @@ for Elements and Values.
 """
 
 
+#
+# Method Dispatch
+#
+
+_typedMethods = {}
+
+def _getTypedMethod(cls, prefix, typeName):
+    """Return the type-specific method of the given class, caching the
+       result to avoid string concatenation and attribute lookups per call."""
+    key = (cls, prefix, typeName)
+    method = _typedMethods.get(key)
+    if method is None:
+        method = getattr(cls, prefix + typeName)
+        _typedMethods[key] = method
+    return method
+
+
 #
 # Element
 #
@@ -25,7 +42,7 @@ def _isA(self, elementClass, category = ''):
 
 def _addChild(self, elementClass, name, typeString = ''):
     "Add a child element of the given subclass, name, and optional type string."
-    method = getattr(self.__class__, "_addChild" + elementClass.__name__)
+    method = _getTypedMethod(self.__class__, "_addChild", elementClass.__name__)
     return method(self, name, typeString)
 
 def _getChild(self, name):
@@ -36,18 +53,18 @@ def _getChild(self, name):
 
 def _getChildOfType(self, elementClass, name):
     "Return the child element, if any, with the given name and subclass."
-    method = getattr(self.__class__, "_getChildOfType" + elementClass.__name__)
+    method = _getTypedMethod(self.__class__, "_getChildOfType", elementClass.__name__)
     return method(self, name)
 
 def _getChildrenOfType(self, elementClass):
     """Return a list of all child elements that are instances of the given type.
        The returned list maintains the order in which children were added."""
-    method = getattr(self.__class__, "_getChildrenOfType" + elementClass.__name__)
+    method = _getTypedMethod(self.__class__, "_getChildrenOfType", elementClass.__name__)
     return method(self)
 
 def _removeChildOfType(self, elementClass, name):
     "Remove the typed child element, if any, with the given name."
-    method = getattr(self.__class__, "_removeChildOfType" + elementClass.__name__)
+    method = _getTypedMethod(self.__class__, "_removeChildOfType", elementClass.__name__)
     method(self, name)
 
 Element.isA = _isA
@@ -64,7 +81,7 @@ Element.removeChildOfType = _removeChildOfType
 
 def _setValue(self, value, typeString = ''):
     "Set the typed value of an element."
-    method = getattr(self.__class__, "_setValue" + typeToName(value.__class__))
+    method = _getTypedMethod(self.__class__, "_setValue", typeToName(value.__class__))
     method(self, value, typeString)
     
 def _getValue(self):
@@ -91,7 +108,7 @@ def _setParameterValue(self, name, value, typeString = ''):
         if connectedNode:
             input.setType(connectedNode.getType())
         return input
-    method = getattr(self.__class__, "_setParameterValue" + typeToName(value.__class__))
+    method = _getTypedMethod(self.__class__, "_setParameterValue", typeToName(value.__class__))
     return method(self, name, value, typeString)
 
 def _getParameterValue(self, name):
@@ -138,7 +155,7 @@ def _addOverride(self, name, typeString = '', value = ''):
 def _setOverrideValue(self, name, value, typeString = ''):
     """Set the value of an override by its name, creating a child element
        to hold the override if needed."""
-    method = getattr(self.__class__, "_setOverrideValue" + typeToName(value.__class__))
+    method = _getTypedMethod(self.__class__, "_setOverrideValue", typeToName(value.__class__))
     return method(self, name, value, typeString)
 
 def _addShaderRef(self, name = '', node = ''):
@@ -170,7 +187,7 @@ def _addGeomAttr(self, name, value = None, typeString = ''):
 def _setGeomAttrValue(self, name, value, typeString = ''):
     """Set the value of a geomattr by its name, creating a child element
        to hold the geomattr if needed."""
-    method = getattr(self.__class__, "_setGeomAttrValue" + typeToName(value.__class__))
+    method = _getTypedMethod(self.__class__, "_setGeomAttrValue", typeToName(value.__class__))
     return method(self, name, value, typeString)
 
 GeomInfo.addGeomAttr = _addGeomAttr
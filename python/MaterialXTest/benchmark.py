@@ -0,0 +1,84 @@
+import os
+import sys
+import threading
+import time
+
+import MaterialX as mx
+
+"""
+Threaded benchmark for MaterialX Python.
+
+Loads, validates, and serializes a document repeatedly, first from a single
+thread and then from a pool of threads, reporting the speedup of the threaded
+run.  Each thread loads its own document, and the GIL is released while
+documents are parsed, validated, and serialized, so these steps may run in
+parallel.  The remaining Python code of each iteration still holds the GIL,
+which limits the speedup that can be observed.
+
+Usage: python benchmark.py [threadCount] [iterationsPerThread]
+"""
+
+
+#--------------------------------------------------------------------------------
+_fileDir = os.path.dirname(os.path.abspath(__file__))
+_libraryDir = os.path.join(_fileDir, '../../documents/Libraries/')
+_exampleDir = os.path.join(_fileDir, '../../documents/Examples/')
+_searchPath = _libraryDir + ';' + _exampleDir
+_libraryFilename = 'mx_stdlib_defs.mtlx'
+
+
+#--------------------------------------------------------------------------------
+def processDocument():
+    "Load, validate, and serialize a single document."
+    doc = mx.createDocument()
+    mx.readFromXmlFile(doc, _libraryFilename, _searchPath)
+    valid, message = doc.validate()
+    if not valid:
+        raise RuntimeError(message)
+    mx.writeToXmlString(doc)
+
+def runSerial(iterationCount):
+    "Process the given number of documents from the calling thread."
+    start = time.time()
+    for i in range(iterationCount):
+        processDocument()
+    return time.time() - start
+
+def runThreaded(threadCount, iterationsPerThread):
+    "Process documents concurrently from the given number of threads."
+    errors = []
+    def worker():
+        try:
+            for i in range(iterationsPerThread):
+                processDocument()
+        except Exception as e:
+            errors.append(e)
+
+    threads = [threading.Thread(target = worker) for i in range(threadCount)]
+    start = time.time()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.time() - start
+    if errors:
+        raise errors[0]
+    return elapsed
+
+
+#--------------------------------------------------------------------------------
+if __name__ == '__main__':
+    threadCount = int(sys.argv[1]) if len(sys.argv) > 1 else 4
+    iterationsPerThread = int(sys.argv[2]) if len(sys.argv) > 2 else 10
+    totalCount = threadCount * iterationsPerThread
+
+    # Warm up caches and lazily-initialized state.
+    processDocument()
+
+    serialTime = runSerial(totalCount)
+    threadedTime = runThreaded(threadCount, iterationsPerThread)
+
+    print('Documents processed:  %d' % totalCount)
+    print('Serial time:          %.3fs (%.1f docs/s)' % (serialTime, totalCount / serialTime))
+    print('Threaded time:        %.3fs (%.1f docs/s, %d threads)' % (threadedTime, totalCount / threadedTime, threadCount))
+    print('Speedup:              %.2fx' % (serialTime / threadedTime))
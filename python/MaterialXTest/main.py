@@ -1,8 +1,15 @@
 import os
+import struct
+import threading
 import unittest
 
 import MaterialX as mx
 
+try:
+    import numpy
+except ImportError:
+    numpy = None
+
 """
 Unit tests for MaterialX Python.
 """
@@ -123,8 +130,10 @@ class TestLoadContent(unittest.TestCase):
             # Copy the document.
             copiedDoc = doc.copy()
             self.assertTrue(copiedDoc == doc)
+            self.assertTrue(copiedDoc.getContentHash() == doc.getContentHash())
             copiedDoc.addLook()
             self.assertTrue(copiedDoc != doc)
+            self.assertTrue(copiedDoc.getContentHash() != doc.getContentHash())
 
             # Traverse the document tree (implicit iterator).
             valueElementCount = 0
@@ -144,6 +153,17 @@ class TestLoadContent(unittest.TestCase):
             self.assertTrue(valueElementCount > 0)
             self.assertTrue(maxElementDepth > 0)
 
+            # Traverse the document tree (batch traversal).
+            elems = doc.traverseTreeAsList()
+            parents, depths, categories, names = doc.traverseTreeAsArrays()
+            self.assertTrue(len(elems) == len(parents) == len(depths) == len(categories) == len(names))
+            self.assertTrue(max(depths) == maxElementDepth)
+            for i, elem in enumerate(elems):
+                self.assertTrue(elem.getName() == names[i])
+                self.assertTrue(elem.getCategory() == categories[i])
+                if parents[i] >= 0:
+                    self.assertTrue(elem.getParent() is elems[parents[i]])
+
             # Traverse the dataflow graph from each shader input to its source nodes.
             for material in doc.getMaterials():
                 self.assertTrue(material.getReferencedShaderDefs())
@@ -156,6 +176,13 @@ class TestLoadContent(unittest.TestCase):
                         for edge in param.traverseGraph(material):
                             edgeCount += 1
                 self.assertTrue(edgeCount > 0)
+                batchEdgeCount = 0
+                for shader in material.getReferencedShaderDefs():
+                    for input in shader.getInputs():
+                        batchEdgeCount += len(input.traverseGraphAsList(material))
+                    for param in shader.getParameters():
+                        batchEdgeCount += len(param.traverseGraphAsList(material))
+                self.assertTrue(batchEdgeCount == edgeCount)
 
             # Serialize to XML.
             xmlString = mx.writeToXmlString(doc, False)
@@ -175,6 +202,220 @@ class TestLoadContent(unittest.TestCase):
                 if elem.isA(mx.Node):
                     self.assertTrue(elem.getReferencedNodeDef())
 
+            # Verify that batch resolution matches per-node resolution.
+            nodes = [elem for elem in doc2.traverseTree() if elem.isA(mx.Node)]
+            nodeDefs = doc2.getNodeDefsForNodes(nodes)
+            self.assertTrue(nodeDefs == [doc2.getNodeDefForNode(node) for node in nodes])
+            implementations = doc2.getImplementationsForNodes(nodes, '', 'osl')
+            self.assertTrue(implementations == [node.getImplementation('', 'osl') for node in nodes])
+
+
+#--------------------------------------------------------------------------------
+class TestDataTypes(unittest.TestCase):
+    def test_BufferProtocol(self):
+        # Vector and color data is exposed through the buffer protocol.
+        color = mx.Color3(0.1, 0.2, 0.3)
+        self.assertTrue(bytes(bytearray(color)) == struct.pack('3f', 0.1, 0.2, 0.3))
+        color[1] = 0.5
+        self.assertTrue(bytes(bytearray(color)) == struct.pack('3f', 0.1, 0.5, 0.3))
+        self.assertTrue(len(bytearray(mx.Matrix4x4())) == 16 * struct.calcsize('f'))
+
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_NumPyArrays(self):
+        # Create zero-copy views of vectors and matrices.
+        vec = mx.Vector3(1, 2, 3)
+        array = numpy.asarray(vec)
+        array[0] = 4
+        self.assertTrue(vec == mx.Vector3(4, 2, 3))
+        self.assertTrue(numpy.asarray(mx.Matrix4x4(list(range(16)))).shape == (4, 4))
+
+        # Get and set the values of many elements in a single call.
+        doc = mx.createDocument()
+        nodeDef = doc.addNodeDef('nodeDef1', 'color3', 'node1')
+        params = [nodeDef.addParameter('param%d' % i, 'color3') for i in range(100)]
+        values = numpy.random.rand(len(params), 3).astype(numpy.float32)
+        mx.setValuesFromArray(params, values, 'color3')
+        self.assertTrue(numpy.allclose(mx.getValuesAsArray(params), values))
+        self.assertTrue(params[1].getValue() == mx.Color3(*values[1]))
+        self.assertRaises(LookupError, mx.setValuesFromArray, params, values, 'vector2')
+
+
+#--------------------------------------------------------------------------------
+class TestColumnar(unittest.TestCase):
+    def test_ExportColumnarTable(self):
+        doc = mx.createDocument()
+        mx.readFromXmlFile(doc, _libraryFilename, _searchPath)
+        table = mx.exportColumnarTable(doc)
+        self.assertTrue(table.getElementCount() == len(doc.traverseTreeAsList()))
+        self.assertTrue(table.getAttributeCount() > 0)
+        self.assertTrue('nodedef' in table.categoryDictionary)
+
+    @unittest.skipIf(numpy is None, 'NumPy is not available')
+    def test_ColumnarArrays(self):
+        doc = mx.createDocument()
+        mx.readFromXmlFile(doc, _libraryFilename, _searchPath)
+        table = mx.exportColumnarTable(doc)
+        parents, depths, categories, names = doc.traverseTreeAsArrays()
+        self.assertTrue(list(table.elementParents) == parents)
+        self.assertTrue([table.categoryDictionary[i] for i in table.elementCategories] == categories)
+
+        # String columns are exported in the Arrow offset and data layout.
+        offsets, data = table.elementNames
+        self.assertTrue(len(offsets) == table.getElementCount() + 1)
+        self.assertTrue(data[offsets[0]:offsets[1]].decode('utf-8') == doc.getName())
+        self.assertTrue(data[offsets[1]:offsets[2]].decode('utf-8') == names[1])
+        offsets, data = table.attributeValues
+        self.assertTrue(len(offsets) == table.getAttributeCount() + 1)
+        self.assertTrue(offsets[-1] == len(data))
+
+        # Aggregate attribute statistics without per-element objects.
+        counts = numpy.bincount(table.attributeNames)
+        self.assertTrue(counts.sum() == table.getAttributeCount())
+
+
+#--------------------------------------------------------------------------------
+class TestDiff(unittest.TestCase):
+    def test_DiffAndPatch(self):
+        doc = mx.createDocument()
+        mx.readFromXmlFile(doc, _libraryFilename, _searchPath)
+        modified = doc.copy()
+        self.assertTrue(len(mx.diffDocuments(doc, modified)) == 0)
+        modified.getNodeDefs()[0].setAttribute('custom', 'value')
+        modified.addNodeGraph('addedGraph')
+        patch = mx.diffDocuments(doc, modified)
+        self.assertTrue(len(patch) == 2)
+        self.assertTrue(patch[0].type == mx.ElementEdit.TypeAddElement)
+        self.assertTrue(patch[1].type == mx.ElementEdit.TypeSetAttribute)
+        mx.applyPatch(doc, patch)
+        self.assertTrue(doc == modified)
+
+
+#--------------------------------------------------------------------------------
+class TestMaterialSignature(unittest.TestCase):
+    def test_MaterialSignature(self):
+        doc = mx.createDocument()
+        doc.addNodeDef('shader1', 'surfaceshader', 'simpleSrf').addParameter('roughness', 'float')
+        signatures = []
+        for value in [0.25, 0.75]:
+            material = doc.addMaterial()
+            shaderRef = material.addShaderRef('sr1', 'simpleSrf')
+            shaderRef.addBindParam('roughness', 'float').setValue(value)
+            signatures.append(mx.getMaterialSignature(material))
+        self.assertTrue(signatures[0].topologyKey == signatures[1].topologyKey)
+        self.assertTrue(signatures[0].parameterNames == ['sr1/roughness'])
+        self.assertTrue(signatures[1].parameterValues[0].getData() == 0.75)
+
+
+#--------------------------------------------------------------------------------
+class TestRevision(unittest.TestCase):
+    def test_Revision(self):
+        doc = mx.createDocument()
+        revision = doc.getRevision()
+        param = doc.addNodeDef('shader1', 'surfaceshader', 'simpleSrf').addParameter('roughness', 'float')
+        param.setPublicName('editRoughness')
+        self.assertTrue(doc.getRevision() > revision)
+        self.assertTrue(doc.getAllPublicElements() == [param])
+
+
+#--------------------------------------------------------------------------------
+class TestReferencedLibraries(unittest.TestCase):
+    def test_ReferencedLibraries(self):
+        lib = mx.createDocument()
+        mx.readFromXmlFile(lib, _libraryFilename, _searchPath)
+        doc = mx.createDocument()
+        doc.addReferencedLibrary(lib)
+        self.assertTrue(doc.getReferencedLibraries() == [lib])
+        self.assertTrue(doc.getNodeDef('ND_add__color3'))
+        self.assertTrue(len(doc.getMatchingNodeDefs('add')) == len(lib.getMatchingNodeDefs('add')))
+        self.assertTrue(len(doc.getNodeDefs()) == 0)
+        self.assertTrue('xi:include' in mx.writeToXmlString(doc))
+        doc.removeReferencedLibrary(lib)
+        self.assertFalse(doc.hasReferencedLibraries())
+        self.assertFalse(doc.getNodeDef('ND_add__color3'))
+
+
+#--------------------------------------------------------------------------------
+class TestRenameAndMove(unittest.TestCase):
+    def test_RenameAndMove(self):
+        doc = mx.createDocument()
+        nodeGraph = doc.addNodeGraph('graph1')
+        constant = nodeGraph.addNode('constant', 'constant1', 'color3')
+        output = nodeGraph.addOutput('out', 'color3')
+        output.setConnectedNode(constant)
+        constant.setName('constant2', updateConnections=True)
+        self.assertTrue(output.getNodeName() == 'constant2')
+        self.assertTrue(output.getConnectedNode() == constant)
+        nodeGraph2 = doc.addNodeGraph('graph2')
+        constant.moveTo(nodeGraph2)
+        self.assertTrue(constant.getParent() == nodeGraph2)
+        self.assertTrue(constant.getNamePath() == 'graph2/constant2')
+        self.assertFalse(nodeGraph.getNode('constant2'))
+
+
+#--------------------------------------------------------------------------------
+class TestElementIds(unittest.TestCase):
+    def test_ElementIds(self):
+        doc = mx.createDocument()
+        nodeGraph = doc.addNodeGraph()
+        node = nodeGraph.addNode('constant')
+        self.assertTrue(doc.getElementById(node.getId()) == node)
+        self.assertTrue(node.getId() < doc.getElementIdBound())
+        nodeId = node.getId()
+        nodeGraph.removeNode(node.getName())
+        self.assertFalse(doc.getElementById(nodeId))
+
+
+#--------------------------------------------------------------------------------
+class TestMemoryUsage(unittest.TestCase):
+    def test_MemoryUsage(self):
+        doc = mx.createDocument()
+        mx.readFromXmlFile(doc, _libraryFilename, _searchPath)
+        usage = doc.getMemoryUsage()
+        self.assertTrue(usage.elementCount == len(doc.traverseTreeAsList()))
+        self.assertTrue(usage.categoryCounts['nodedef'] == len(doc.getNodeDefs()))
+        self.assertTrue(usage.getTotalBytes() == sum(usage.categoryBytes.values()) + usage.cacheBytes)
+        self.assertTrue(usage.getBytesPerElement() > 0)
+
+
+#--------------------------------------------------------------------------------
+class TestInstrumentation(unittest.TestCase):
+    def test_Instrumentation(self):
+        mx.Instrumentation.reset()
+        mx.Instrumentation.setEnabled(True)
+        doc = mx.createDocument()
+        mx.readFromXmlFile(doc, _libraryFilename, _searchPath)
+        doc.getMatchingNodeDefs('add')
+        mx.Instrumentation.setEnabled(False)
+
+        timers = mx.Instrumentation.getTimerStats()
+        self.assertTrue(timers['readFromXmlFile'].count == 1)
+        self.assertTrue(timers['xml/parse'].totalTime > 0.0)
+        self.assertTrue(mx.Instrumentation.getCounters()['Document::Cache/miss'] == 1)
+        self.assertTrue('Document::Cache::refresh' in mx.Instrumentation.getReport())
+        self.assertTrue('traceEvents' in mx.Instrumentation.getChromeTrace())
+        mx.Instrumentation.reset()
+
+
+#--------------------------------------------------------------------------------
+class TestThreading(unittest.TestCase):
+    def test_ConcurrentLoad(self):
+        # Load and serialize the standard library from multiple threads.
+        results = [None] * 4
+        def worker(index):
+            doc = mx.createDocument()
+            mx.readFromXmlFile(doc, _libraryFilename, _searchPath)
+            results[index] = (doc.validate()[0], mx.writeToXmlString(doc))
+        threads = [threading.Thread(target = worker, args = (i,)) for i in range(len(results))]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        # Verify that all threads produced identical, valid documents.
+        for result in results:
+            self.assertTrue(result[0])
+            self.assertTrue(result[1] == results[0][1])
+
 
 #--------------------------------------------------------------------------------
 if __name__ == '__main__':
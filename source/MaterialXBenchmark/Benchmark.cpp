@@ -0,0 +1,95 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXBenchmark/Benchmark.h>
+
+#include <MaterialXGenerator/Generator.h>
+
+#include <MaterialXFormat/XmlIo.h>
+
+const std::string BENCHMARK_SEARCH_PATH = "documents/Libraries;documents/Examples";
+
+std::vector<BenchmarkCase>& getBenchmarkCases()
+{
+    static std::vector<BenchmarkCase> cases;
+    return cases;
+}
+
+mx::DocumentPtr loadStandardLibrary()
+{
+    mx::DocumentPtr lib = mx::createDocument();
+    mx::readFromXmlFile(lib, "mx_stdlib_defs.mtlx", BENCHMARK_SEARCH_PATH);
+    return lib;
+}
+
+mx::DocumentPtr createLargeDocument(size_t graphCount, size_t nodesPerGraph)
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    doc->importLibrary(loadStandardLibrary());
+
+    // Define a custom node with a node graph implementation.
+    mx::NodeDefPtr nodeDef = doc->addNodeDef("ND_benchmark_blend", "color3", "benchmark_blend");
+    nodeDef->addInput("fg", "color3");
+    nodeDef->addInput("bg", "color3");
+    mx::NodeGraphPtr implGraph = doc->addNodeGraph("IMP_benchmark_blend");
+    implGraph->setNodeDef(nodeDef->getName());
+    mx::NodePtr implMultiply = implGraph->addNode("multiply", "multiply1", "color3");
+    implMultiply->addInput("in1", "color3")->setInterfaceName("fg");
+    implMultiply->addInput("in2", "color3")->setInterfaceName("bg");
+    mx::NodePtr implAdd = implGraph->addNode("add", "add1", "color3");
+    implAdd->setConnectedNode("in1", implMultiply);
+    implAdd->addInput("in2", "color3")->setInterfaceName("bg");
+    implGraph->addOutput("out", "color3")->setConnectedNode(implAdd);
+
+    // Create node graphs with long chains of nodes.  Since graph traversal
+    // visits each path through a graph separately, secondary inputs draw upon
+    // values or a shared constant rather than earlier nodes in the chain.
+    for (size_t i = 0; i < graphCount; i++)
+    {
+        mx::NodeGraphPtr graph = doc->addNodeGraph("graph" + std::to_string(i));
+        mx::NodePtr constant = graph->addNode("constant", "constant1", "color3");
+        constant->setParameterValue("value", mx::Color3(0.5f, 0.5f, 0.5f));
+        mx::NodePtr prev = constant;
+        for (size_t j = 0; j < nodesPerGraph; j++)
+        {
+            static const std::string categories[] = { "add", "multiply", "benchmark_blend", "mix" };
+            const std::string& category = categories[j % 4];
+            mx::NodePtr node = graph->addNode(category, category + std::to_string(j), "color3");
+            if (category == "add" || category == "multiply")
+            {
+                node->setConnectedNode("in1", prev);
+                node->addInput("in2", "color3")->setValue(mx::Color3(0.25f, 0.5f, 0.75f));
+            }
+            else if (category == "benchmark_blend")
+            {
+                node->setConnectedNode("fg", prev);
+                node->addInput("bg", "color3")->setValue(mx::Color3(0.75f, 0.5f, 0.25f));
+            }
+            else
+            {
+                node->setConnectedNode("fg", prev);
+                node->setConnectedNode("bg", constant);
+                node->addInput("mask", "float")->setValue(0.5f);
+            }
+            prev = node;
+        }
+        graph->addOutput("out", "color3")->setConnectedNode(prev);
+    }
+
+    return doc;
+}
+
+mx::DocumentPtr createGeneratedDocument()
+{
+    mx::GeneratorOptions options;
+    options.nodeGraphCount = 50;
+    options.nodesPerGraph = 200;
+    options.graphDepth = 20;
+    options.materialCount = 100;
+    options.lookCount = 4;
+    options.materialAssignsPerLook = 5000;
+    options.geomInfoCount = 5000;
+    return mx::generateDocument(loadStandardLibrary(), options);
+}
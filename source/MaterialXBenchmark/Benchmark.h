@@ -0,0 +1,151 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_BENCHMARK_H
+#define MATERIALX_BENCHMARK_H
+
+/// @file
+/// A minimal harness for MaterialX microbenchmarks
+
+#include <MaterialXCore/Document.h>
+
+#include <chrono>
+#include <map>
+
+namespace mx = MaterialX;
+
+/// The search path for documents used by benchmarks, relative to the
+/// benchmark executable.
+extern const std::string BENCHMARK_SEARCH_PATH;
+
+/// @class BenchmarkState
+/// The state of a single benchmark case, which records the duration of
+/// each timed iteration.
+class BenchmarkState
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit BenchmarkState(size_t iterations) :
+        _iterations(iterations),
+        _itemCount(0)
+    {
+    }
+    ~BenchmarkState() { }
+
+    /// Measure the given function, calling it once as an untimed warm-up
+    /// and then once for each timed iteration.
+    template <class F> void measure(F func)
+    {
+        measure([](){}, func);
+    }
+
+    /// Measure the given function, calling the given setup function before
+    /// each call outside of the timed region.
+    template <class S, class F> void measure(S setup, F func)
+    {
+        setup();
+        func();
+        for (size_t i = 0; i < _iterations; i++)
+        {
+            setup();
+            Clock::time_point start = Clock::now();
+            func();
+            _samples.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+        }
+    }
+
+    /// Set the number of items processed by each iteration, which is used
+    /// to report throughput.
+    void setItemCount(size_t count)
+    {
+        _itemCount = count;
+    }
+
+    /// Return the number of items processed by each iteration.
+    size_t getItemCount() const
+    {
+        return _itemCount;
+    }
+
+    /// Return the duration in seconds of each timed iteration.
+    const std::vector<double>& getSamples() const
+    {
+        return _samples;
+    }
+
+    /// Set the value of a named metric, which is reported alongside the
+    /// timings of the benchmark.
+    void setMetric(const std::string& name, double value)
+    {
+        _metrics[name] = value;
+    }
+
+    /// Return the named metrics of the benchmark.
+    const std::map<std::string, double>& getMetrics() const
+    {
+        return _metrics;
+    }
+
+  private:
+    size_t _iterations;
+    size_t _itemCount;
+    std::vector<double> _samples;
+    std::map<std::string, double> _metrics;
+};
+
+/// A function implementing a benchmark case.
+using BenchmarkFunction = void (*)(BenchmarkState&);
+
+/// @class BenchmarkCase
+/// A named benchmark case.
+class BenchmarkCase
+{
+  public:
+    std::string name;
+    BenchmarkFunction function;
+};
+
+/// Return the global list of registered benchmark cases.
+std::vector<BenchmarkCase>& getBenchmarkCases();
+
+/// @class BenchmarkRegistrar
+/// A helper class that registers a benchmark case during static
+/// initialization.
+class BenchmarkRegistrar
+{
+  public:
+    BenchmarkRegistrar(const char* name, BenchmarkFunction function)
+    {
+        getBenchmarkCases().push_back(BenchmarkCase{ name, function });
+    }
+};
+
+/// Load the standard library definitions into a new document.
+mx::DocumentPtr loadStandardLibrary();
+
+/// Create a large, deterministic document for benchmarking, containing the
+/// given number of node graphs with the given number of nodes each.  The
+/// standard library is imported, and a fraction of the nodes are instances
+/// of a custom node with a node graph implementation.
+mx::DocumentPtr createLargeDocument(size_t graphCount, size_t nodesPerGraph);
+
+/// Generate a large synthetic document for benchmarking, with node graphs
+/// drawn from the standard library, materials, looks with thousands of
+/// material assignments, and geominfos.
+mx::DocumentPtr createGeneratedDocument();
+
+#define MATERIALX_BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define MATERIALX_BENCHMARK_CONCAT(a, b) MATERIALX_BENCHMARK_CONCAT_IMPL(a, b)
+
+/// Define and register a benchmark case with the given name.  The body of
+/// the case receives a BenchmarkState named "state".
+#define BENCHMARK_CASE(NAME)                                                                        \
+static void MATERIALX_BENCHMARK_CONCAT(benchmarkCase, __LINE__)(BenchmarkState& state);             \
+static BenchmarkRegistrar MATERIALX_BENCHMARK_CONCAT(benchmarkRegistrar, __LINE__)(NAME,            \
+    &MATERIALX_BENCHMARK_CONCAT(benchmarkCase, __LINE__));                                          \
+static void MATERIALX_BENCHMARK_CONCAT(benchmarkCase, __LINE__)(BenchmarkState& state)
+
+#endif
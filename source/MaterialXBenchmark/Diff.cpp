@@ -0,0 +1,70 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXBenchmark/Benchmark.h>
+
+#include <MaterialXCore/Diff.h>
+
+#include <MaterialXGenerator/Generator.h>
+
+BENCHMARK_CASE("diff/smallChange/million")
+{
+    // Each iteration edits a handful of elements in a document of roughly one
+    // million elements, then diffs it against the original.
+    mx::GeneratorOptions options;
+    options.nodeGraphCount = 1000;
+    options.nodesPerGraph = 300;
+    options.graphDepth = 30;
+    options.materialCount = 100;
+    options.lookCount = 4;
+    options.materialAssignsPerLook = 20000;
+    options.geomInfoCount = 20000;
+    mx::DocumentPtr source = mx::generateDocument(loadStandardLibrary(), options);
+    mx::DocumentPtr dest = source->copy();
+    std::vector<mx::NodeGraphPtr> graphs = dest->getNodeGraphs();
+    state.setItemCount(source->getMemoryUsage().elementCount);
+
+    size_t iteration = 0;
+    state.measure([&]()
+    {
+        iteration++;
+        for (size_t i = 0; i < 10; i++)
+        {
+            mx::NodeGraphPtr graph = graphs[(iteration * 10 + i) % graphs.size()];
+            graph->getNodes()[i]->setAttribute("iteration", std::to_string(iteration));
+        }
+    },
+    [&]()
+    {
+        mx::DocumentPatch patch = mx::diffDocuments(source, dest);
+        if (patch.empty())
+        {
+            throw mx::Exception("Unexpected empty patch");
+        }
+    });
+}
+
+BENCHMARK_CASE("diff/applyPatch/generated")
+{
+    mx::DocumentPtr source = createGeneratedDocument();
+    mx::DocumentPtr dest = source->copy();
+    for (mx::NodeGraphPtr graph : dest->getNodeGraphs())
+    {
+        graph->getNodes()[0]->setAttribute("modified", "true");
+        graph->addNode("constant", "addedConstant", "color3");
+    }
+    mx::DocumentPatch patch = mx::diffDocuments(source, dest);
+    state.setItemCount(patch.size());
+
+    mx::DocumentPtr patched;
+    state.measure([&]()
+    {
+        patched = source->copy();
+    },
+    [&]()
+    {
+        mx::applyPatch(patched, patch);
+    });
+}
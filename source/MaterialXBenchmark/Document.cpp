@@ -0,0 +1,199 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXBenchmark/Benchmark.h>
+
+#include <MaterialXGenerator/Generator.h>
+
+BENCHMARK_CASE("document/cache/refresh")
+{
+    // Each iteration invalidates the document cache by modifying an
+    // attribute, then queries the cache to trigger a refresh.
+    mx::DocumentPtr doc = createLargeDocument(100, 100);
+    bool toggle = false;
+    state.measure([&]()
+    {
+        toggle = !toggle;
+        doc->setColorSpace(toggle ? "lin_rec709" : "gamma22");
+    },
+    [&]()
+    {
+        doc->getMatchingNodeDefs("add");
+    });
+}
+
+BENCHMARK_CASE("document/cache/lookup")
+{
+    mx::DocumentPtr doc = createLargeDocument(100, 100);
+    state.setItemCount(1000);
+    state.measure([&]()
+    {
+        for (size_t i = 0; i < 1000; i++)
+        {
+            doc->getMatchingNodeDefs("add");
+        }
+    });
+}
+
+BENCHMARK_CASE("document/validate/stdlib")
+{
+    mx::DocumentPtr lib = loadStandardLibrary();
+    state.measure([&]()
+    {
+        lib->validate();
+    });
+}
+
+BENCHMARK_CASE("document/validate/large")
+{
+    mx::DocumentPtr doc = createLargeDocument(100, 100);
+    state.measure([&]()
+    {
+        doc->validate();
+    });
+}
+
+BENCHMARK_CASE("document/validate/generated")
+{
+    mx::DocumentPtr doc = createGeneratedDocument();
+    state.measure([&]()
+    {
+        doc->validate();
+    });
+}
+
+BENCHMARK_CASE("document/memoryUsage/stdlib")
+{
+    mx::DocumentPtr lib = loadStandardLibrary();
+    lib->getMatchingNodeDefs("add");
+    mx::MemoryUsage usage;
+    state.measure([&]()
+    {
+        usage = lib->getMemoryUsage();
+    });
+    state.setItemCount(usage.elementCount);
+    state.setMetric("totalBytes", (double) usage.getTotalBytes());
+    state.setMetric("bytesPerElement", usage.getBytesPerElement());
+}
+
+BENCHMARK_CASE("document/memoryUsage/generated")
+{
+    mx::DocumentPtr doc = createGeneratedDocument();
+    doc->getMatchingNodeDefs("add");
+    mx::MemoryUsage usage;
+    state.measure([&]()
+    {
+        usage = doc->getMemoryUsage();
+    });
+    state.setItemCount(usage.elementCount);
+    state.setMetric("totalBytes", (double) usage.getTotalBytes());
+    state.setMetric("bytesPerElement", usage.getBytesPerElement());
+}
+
+BENCHMARK_CASE("document/contentHash/generated")
+{
+    // Each iteration invalidates the hash of the document root, which is then
+    // recomputed from the cached hashes of its children.
+    mx::DocumentPtr doc = createGeneratedDocument();
+    doc->getContentHash();
+    bool toggle = false;
+    state.measure([&]()
+    {
+        toggle = !toggle;
+        doc->setColorSpace(toggle ? "lin_rec709" : "gamma22");
+    },
+    [&]()
+    {
+        doc->getContentHash();
+    });
+}
+
+BENCHMARK_CASE("document/equality/generated")
+{
+    // Compare against a copy that differs only in its final element.  Each
+    // iteration invalidates the root hashes, which are then recomputed from
+    // the cached hashes of their children.
+    mx::DocumentPtr doc = createGeneratedDocument();
+    mx::DocumentPtr docCopy = doc->copy();
+    docCopy->getLooks().back()->getMaterialAssigns().back()->setGeom("/modified");
+    state.measure([&]()
+    {
+        doc->setColorSpace("");
+        docCopy->setColorSpace("");
+    },
+    [&]()
+    {
+        if (*doc == *docCopy)
+        {
+            throw mx::Exception("Unexpected document equality");
+        }
+    });
+}
+
+BENCHMARK_CASE("document/copy/large")
+{
+    mx::DocumentPtr doc = createLargeDocument(100, 100);
+    state.measure([&]()
+    {
+        doc->copy();
+    });
+}
+
+BENCHMARK_CASE("document/nodedef/resolve")
+{
+    mx::DocumentPtr doc = createGeneratedDocument();
+    std::vector<mx::NodePtr> nodes;
+    for (mx::NodeGraphPtr nodeGraph : doc->getNodeGraphs())
+    {
+        std::vector<mx::NodePtr> graphNodes = nodeGraph->getNodes();
+        nodes.insert(nodes.end(), graphNodes.begin(), graphNodes.end());
+    }
+    state.setItemCount(nodes.size());
+    state.measure([&]()
+    {
+        for (mx::NodePtr node : nodes)
+        {
+            node->getReferencedNodeDef();
+        }
+    });
+}
+
+BENCHMARK_CASE("document/nodedef/resolve/batch")
+{
+    mx::DocumentPtr doc = createGeneratedDocument();
+    std::vector<mx::NodePtr> nodes;
+    for (mx::NodeGraphPtr nodeGraph : doc->getNodeGraphs())
+    {
+        std::vector<mx::NodePtr> graphNodes = nodeGraph->getNodes();
+        nodes.insert(nodes.end(), graphNodes.begin(), graphNodes.end());
+    }
+    state.setItemCount(nodes.size());
+    state.measure([&]()
+    {
+        doc->getNodeDefsForNodes(nodes);
+    });
+}
+
+BENCHMARK_CASE("document/memoryUsage/referencedLibrary")
+{
+    // Compare a generated document referencing the standard library with
+    // one importing it.
+    mx::DocumentPtr lib = loadStandardLibrary();
+    mx::GeneratorOptions options;
+    options.materialAssignsPerLook = 100;
+    mx::DocumentPtr importingDoc = mx::generateDocument(lib, options);
+    options.referenceLibrary = true;
+    mx::DocumentPtr referencingDoc = mx::generateDocument(lib, options);
+    referencingDoc->getMatchingNodeDefs("add");
+    mx::MemoryUsage usage;
+    state.measure([&]()
+    {
+        usage = referencingDoc->getMemoryUsage();
+    });
+    size_t importingBytes = importingDoc->getMemoryUsage().getTotalBytes();
+    state.setItemCount(usage.elementCount);
+    state.setMetric("totalBytes", (double) usage.getTotalBytes());
+    state.setMetric("importingTotalBytes", (double) importingBytes);
+}
@@ -0,0 +1,196 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXBenchmark/Benchmark.h>
+
+#include <MaterialXEval/Evaluator.h>
+#include <MaterialXEval/Optimizer.h>
+
+namespace {
+
+const size_t IMAGE_RESOLUTION = 512;
+
+// Create a layered procedural pattern, combining fractal noise, cell noise
+// and ramps through compositing and adjustment nodes.
+mx::OutputPtr createPatternGraph(mx::DocumentPtr doc)
+{
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph("NG_pattern");
+
+    mx::NodePtr position = nodeGraph->addNode("position", "position1", "vector3");
+    mx::NodePtr scale = nodeGraph->addNode("multiply", "scale1", "vector3");
+    scale->setConnectedNode("in1", position);
+    scale->addInput("in2", "vector3")->setValue(mx::Vector3(8.0f, 8.0f, 8.0f));
+    mx::NodePtr fractal = nodeGraph->addNode("fractal3d", "fractal1", "color3");
+    fractal->setConnectedNode("position", scale);
+    fractal->setParameterValue("octaves", 4);
+    mx::NodePtr cells = nodeGraph->addNode("cellnoise2d", "cells1", "float");
+    mx::NodePtr ramp = nodeGraph->addNode("ramptb", "ramp1", "color3");
+    ramp->setParameterValue("valuet", mx::Color3(0.9f, 0.6f, 0.3f));
+    ramp->setParameterValue("valueb", mx::Color3(0.1f, 0.2f, 0.4f));
+    mx::NodePtr mix = nodeGraph->addNode("mix", "mix1", "color3");
+    mix->setConnectedNode("fg", fractal);
+    mix->setConnectedNode("bg", ramp);
+    mix->setConnectedNode("mask", cells);
+    mx::NodePtr contrast = nodeGraph->addNode("contrast", "contrast1", "color3");
+    contrast->setConnectedNode("in", mix);
+    contrast->setParameterValue("amount", mx::Color3(1.5f, 1.5f, 1.5f));
+    mx::NodePtr saturate = nodeGraph->addNode("saturate", "saturate1", "color3");
+    saturate->setConnectedNode("in", contrast);
+    saturate->setParameterValue("amount", 0.5f);
+    mx::NodePtr clamp = nodeGraph->addNode("clamp", "clamp1", "color3");
+    clamp->setConnectedNode("in", saturate);
+
+    mx::OutputPtr output = nodeGraph->addOutput("out", "color3");
+    output->setConnectedNode(clamp);
+    return output;
+}
+
+void evaluatePattern(BenchmarkState& state, size_t threadCount)
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    doc->importLibrary(loadStandardLibrary());
+    mx::EvalProgramPtr program = mx::EvalProgram::compile(createPatternGraph(doc));
+    mx::SampleBatch samples;
+    samples.setGrid(IMAGE_RESOLUTION, IMAGE_RESOLUTION);
+    mx::EvalOptions options;
+    options.threadCount = threadCount;
+    mx::SampleBuffer result;
+    state.setItemCount(samples.getSampleCount());
+    state.setMetric("instructions", (double) program->getInstructions().size());
+    state.setMetric("registers", (double) program->getRegisterCount());
+
+    state.measure([&]()
+    {
+        program->evaluate(samples, result, options);
+    });
+}
+
+// Optimize a chain of constant arithmetic with the given number of steps,
+// which feeds a varying node and has an unused branch at each step.
+void optimizeChain(BenchmarkState& state, size_t stepCount)
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    doc->importLibrary(loadStandardLibrary());
+    mx::NodeGraphPtr nodeGraph;
+    mx::OptimizerStats stats;
+    state.setItemCount(stepCount * 2);
+
+    state.measure([&]()
+    {
+        if (nodeGraph)
+        {
+            doc->removeNodeGraph(nodeGraph->getName());
+        }
+        nodeGraph = doc->addNodeGraph();
+        mx::NodePtr previous = nodeGraph->addNode("constant", "constant1", "float");
+        previous->setParameterValue("value", 1.0f);
+        for (size_t i = 0; i < stepCount; i++)
+        {
+            mx::NodePtr multiply = nodeGraph->addNode("multiply", mx::EMPTY_STRING, "float");
+            multiply->setConnectedNode("in1", previous);
+            multiply->addInput("in2", "float")->setValue(1.001f);
+            mx::NodePtr unused = nodeGraph->addNode("add", mx::EMPTY_STRING, "float");
+            unused->setConnectedNode("in1", multiply);
+            previous = multiply;
+        }
+        mx::NodePtr noise = nodeGraph->addNode("noise2d", "noise1", "float");
+        mx::NodePtr add = nodeGraph->addNode("add", "result1", "float");
+        add->setConnectedNode("in1", previous);
+        add->setConnectedNode("in2", noise);
+        mx::OutputPtr output = nodeGraph->addOutput("out", "float");
+        output->setConnectedNode(add);
+    },
+    [&]()
+    {
+        stats = mx::optimizeNodeGraph(nodeGraph);
+    });
+
+    state.setMetric("folded", (double) stats.foldedNodes);
+    state.setMetric("removed", (double) stats.removedNodes);
+}
+
+} // anonymous namespace
+
+BENCHMARK_CASE("eval/pattern/serial")
+{
+    evaluatePattern(state, 1);
+}
+
+BENCHMARK_CASE("eval/pattern/threaded")
+{
+    evaluatePattern(state, 0);
+}
+
+BENCHMARK_CASE("eval/compile/chain")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    doc->importLibrary(loadStandardLibrary());
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    mx::NodePtr previous = nodeGraph->addNode("texcoord", "texcoord1", "vector2");
+    for (size_t i = 0; i < 1000; i++)
+    {
+        mx::NodePtr add = nodeGraph->addNode("add", mx::EMPTY_STRING, "vector2");
+        add->setConnectedNode("in1", previous);
+        add->addInput("in2", "vector2")->setValue(mx::Vector2((float) i, 0.5f));
+        previous = add;
+    }
+    mx::OutputPtr output = nodeGraph->addOutput("out", "vector2");
+    output->setConnectedNode(previous);
+    state.setItemCount(1000);
+
+    state.measure([&]()
+    {
+        mx::EvalProgram::compile(output);
+    });
+}
+
+BENCHMARK_CASE("eval/optimize/chain")
+{
+    optimizeChain(state, 500);
+}
+
+BENCHMARK_CASE("eval/optimize/chain/large")
+{
+    optimizeChain(state, 4000);
+}
+
+BENCHMARK_CASE("eval/optimize/switches")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    doc->importLibrary(loadStandardLibrary());
+    mx::NodeGraphPtr nodeGraph;
+    mx::OptimizerStats stats;
+    state.setItemCount(2000);
+
+    state.measure([&]()
+    {
+        // Build a chain of switches with constant selectors, each choosing
+        // between the previous switch and a varying node.
+        if (nodeGraph)
+        {
+            doc->removeNodeGraph(nodeGraph->getName());
+        }
+        nodeGraph = doc->addNodeGraph();
+        mx::NodePtr previous = nodeGraph->addNode("noise2d", "noise1", "float");
+        for (size_t i = 0; i < 1000; i++)
+        {
+            mx::NodePtr noise = nodeGraph->addNode("noise2d", mx::EMPTY_STRING, "float");
+            mx::NodePtr switchNode = nodeGraph->addNode("switch", mx::EMPTY_STRING, "float");
+            switchNode->setConnectedNode("in1", previous);
+            switchNode->setConnectedNode("in2", noise);
+            switchNode->setParameterValue("which", 0.0f);
+            previous = switchNode;
+        }
+        mx::OutputPtr output = nodeGraph->addOutput("out", "float");
+        output->setConnectedNode(previous);
+    },
+    [&]()
+    {
+        stats = mx::optimizeNodeGraph(nodeGraph);
+    });
+
+    state.setMetric("collapsed", (double) stats.collapsedConditionals);
+    state.setMetric("removed", (double) stats.removedNodes);
+}
@@ -0,0 +1,188 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXBenchmark/Benchmark.h>
+
+#include <MaterialXCore/Util.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+namespace {
+
+const size_t DEFAULT_ITERATIONS = 10;
+
+class BenchmarkResult
+{
+  public:
+    std::string name;
+    size_t itemCount;
+    std::vector<double> samples;
+    std::map<std::string, double> metrics;
+};
+
+double getMedian(std::vector<double> samples)
+{
+    if (samples.empty())
+        return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t mid = samples.size() / 2;
+    return (samples.size() % 2) ? samples[mid] : (samples[mid - 1] + samples[mid]) * 0.5;
+}
+
+void writeJson(std::ostream& stream, const std::vector<BenchmarkResult>& results, size_t iterations)
+{
+    stream << std::setprecision(9);
+    stream << "{\n";
+    stream << "  \"version\": \"" << mx::getVersionString() << "\",\n";
+    stream << "  \"iterations\": " << iterations << ",\n";
+    stream << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchmarkResult& result = results[i];
+        const std::vector<double>& samples = result.samples;
+        double minTime = samples.empty() ? 0.0 : *std::min_element(samples.begin(), samples.end());
+        double maxTime = samples.empty() ? 0.0 : *std::max_element(samples.begin(), samples.end());
+        double meanTime = samples.empty() ? 0.0 : std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+        double medianTime = getMedian(samples);
+
+        stream << (i ? ",\n" : "\n");
+        stream << "    {\n";
+        stream << "      \"name\": \"" << mx::escapeJsonString(result.name) << "\",\n";
+        stream << "      \"iterations\": " << samples.size() << ",\n";
+        stream << "      \"items\": " << result.itemCount << ",\n";
+        stream << "      \"min\": " << minTime << ",\n";
+        stream << "      \"median\": " << medianTime << ",\n";
+        stream << "      \"mean\": " << meanTime << ",\n";
+        stream << "      \"max\": " << maxTime;
+        if (result.itemCount && medianTime > 0.0)
+        {
+            stream << ",\n      \"itemsPerSecond\": " << result.itemCount / medianTime;
+        }
+        if (!result.metrics.empty())
+        {
+            stream << ",\n      \"metrics\": {";
+            for (auto it = result.metrics.begin(); it != result.metrics.end(); ++it)
+            {
+                stream << (it == result.metrics.begin() ? "\n" : ",\n");
+                stream << "        \"" << mx::escapeJsonString(it->first) << "\": " << it->second;
+            }
+            stream << "\n      }";
+        }
+        stream << "\n    }";
+    }
+    stream << "\n  ]\n";
+    stream << "}\n";
+}
+
+void printUsage()
+{
+    std::cerr << "Usage: MaterialXBenchmark [options]\n"
+                 "  --output <file>     Write JSON results to the given file (default: stdout)\n"
+                 "  --filter <string>   Run only benchmarks whose names contain the given string\n"
+                 "  --iterations <n>    Number of timed iterations per benchmark (default: "
+              << DEFAULT_ITERATIONS << ")\n"
+                 "  --list              List the available benchmarks\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char* const argv[])
+{
+    std::string outputFilename;
+    std::string filter;
+    size_t iterations = DEFAULT_ITERATIONS;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--output" && i + 1 < argc)
+        {
+            outputFilename = argv[++i];
+        }
+        else if (arg == "--filter" && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else if (arg == "--iterations" && i + 1 < argc)
+        {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--list")
+        {
+            listOnly = true;
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // Sort cases by name, for a stable order across platforms and builds.
+    std::vector<BenchmarkCase> cases = getBenchmarkCases();
+    std::stable_sort(cases.begin(), cases.end(), [](const BenchmarkCase& a, const BenchmarkCase& b)
+    {
+        return a.name < b.name;
+    });
+
+    std::vector<BenchmarkResult> results;
+    for (const BenchmarkCase& benchmarkCase : cases)
+    {
+        if (!filter.empty() && benchmarkCase.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+        if (listOnly)
+        {
+            std::cout << benchmarkCase.name << std::endl;
+            continue;
+        }
+
+        BenchmarkState state(iterations);
+        try
+        {
+            benchmarkCase.function(state);
+        }
+        catch (std::exception& e)
+        {
+            std::cerr << benchmarkCase.name << " failed: " << e.what() << std::endl;
+            return 1;
+        }
+
+        BenchmarkResult result{ benchmarkCase.name, state.getItemCount(), state.getSamples(), state.getMetrics() };
+        std::cerr << std::left << std::setw(48) << result.name << " median "
+                  << std::fixed << std::setprecision(6) << getMedian(result.samples) << "s" << std::endl;
+        results.push_back(result);
+    }
+
+    if (listOnly)
+    {
+        return 0;
+    }
+
+    if (outputFilename.empty())
+    {
+        writeJson(std::cout, results, iterations);
+    }
+    else
+    {
+        std::ofstream stream(outputFilename);
+        if (!stream)
+        {
+            std::cerr << "Unable to open output file: " << outputFilename << std::endl;
+            return 1;
+        }
+        writeJson(stream, results, iterations);
+    }
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXBenchmark/Benchmark.h>
+
+#include <MaterialXCore/MaterialCache.h>
+
+BENCHMARK_CASE("material/signature/generated")
+{
+    mx::DocumentPtr doc = createGeneratedDocument();
+    std::vector<mx::MaterialPtr> materials = doc->getMaterials();
+    mx::MaterialCache<std::string> cache;
+    auto compile = [](mx::MaterialPtr material, const mx::MaterialSignature&)
+    {
+        return std::make_shared<std::string>(material->getName());
+    };
+    state.setItemCount(materials.size());
+
+    state.measure([&]()
+    {
+        for (mx::MaterialPtr material : materials)
+        {
+            cache.getArtifact(material, compile);
+        }
+    });
+
+    state.setMetric("topologies", (double) cache.getArtifactCount());
+}
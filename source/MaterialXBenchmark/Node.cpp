@@ -0,0 +1,109 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXBenchmark/Benchmark.h>
+
+#include <MaterialXFormat/XmlIo.h>
+
+BENCHMARK_CASE("node/flattenSubgraphs/large")
+{
+    // Each iteration flattens a fresh copy of the same source graph.
+    mx::DocumentPtr doc = createLargeDocument(1, 500);
+    mx::NodeGraphPtr graph = doc->getNodeGraph("graph0");
+    mx::NodeGraphPtr flatGraph;
+    state.setItemCount(graph->getNodes().size());
+    state.measure([&]()
+    {
+        if (flatGraph)
+        {
+            doc->removeNodeGraph(flatGraph->getName());
+        }
+        flatGraph = doc->addNodeGraph();
+        flatGraph->copyContentFrom(graph);
+    },
+    [&]()
+    {
+        flatGraph->flattenSubgraphs();
+    });
+}
+
+BENCHMARK_CASE("node/topologicalSort/large")
+{
+    mx::DocumentPtr doc = createLargeDocument(1, 10000);
+    mx::NodeGraphPtr graph = doc->getNodeGraph("graph0");
+    state.setItemCount(graph->getNodes().size());
+    state.measure([&]()
+    {
+        graph->topologicalSort();
+    });
+}
+
+BENCHMARK_CASE("node/implementation/resolve")
+{
+    mx::DocumentPtr doc = createLargeDocument(1, 10000);
+    mx::DocumentPtr impl = mx::createDocument();
+    mx::readFromXmlFile(impl, "mx_stdlib_impl_osl.mtlx", BENCHMARK_SEARCH_PATH);
+    doc->importLibrary(impl);
+    std::vector<mx::NodePtr> nodes = doc->getNodeGraph("graph0")->getNodes();
+    state.setItemCount(nodes.size());
+    state.measure([&]()
+    {
+        doc->getImplementationsForNodes(nodes, "", "osl");
+    });
+}
+
+BENCHMARK_CASE("node/addNode/unnamed")
+{
+    // Each iteration adds unnamed nodes to a fresh graph.
+    const size_t nodeCount = 100000;
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeGraphPtr graph;
+    state.setItemCount(nodeCount);
+    state.measure([&]()
+    {
+        if (graph)
+        {
+            doc->removeNodeGraph(graph->getName());
+        }
+        graph = doc->addNodeGraph();
+    },
+    [&]()
+    {
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            graph->addNode("constant");
+        }
+    });
+}
+
+BENCHMARK_CASE("node/removeChildren/half")
+{
+    // Each iteration removes every other node from a fresh graph.
+    const size_t nodeCount = 100000;
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeGraphPtr graph;
+    state.setItemCount(nodeCount / 2);
+    state.measure([&]()
+    {
+        if (graph)
+        {
+            doc->removeNodeGraph(graph->getName());
+        }
+        graph = doc->addNodeGraph();
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            graph->addNode("constant");
+        }
+    },
+    [&]()
+    {
+        bool remove = false;
+        graph->removeChildren([&remove](mx::ElementPtr)
+        {
+            remove = !remove;
+            return remove;
+        });
+    });
+}
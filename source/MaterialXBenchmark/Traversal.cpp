@@ -0,0 +1,112 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXBenchmark/Benchmark.h>
+
+BENCHMARK_CASE("traversal/traverseTree/large")
+{
+    mx::DocumentPtr doc = createLargeDocument(100, 100);
+    size_t elementCount = 0;
+    for (mx::ElementPtr elem : doc->traverseTree())
+    {
+        elementCount++;
+    }
+    state.setItemCount(elementCount);
+    state.measure([&]()
+    {
+        size_t count = 0;
+        for (mx::ElementPtr elem : doc->traverseTree())
+        {
+            count++;
+        }
+        if (count != elementCount)
+        {
+            throw mx::Exception("Inconsistent tree traversal");
+        }
+    });
+}
+
+BENCHMARK_CASE("traversal/traverseGraph/large")
+{
+    mx::DocumentPtr doc = createLargeDocument(20, 100);
+    std::vector<mx::OutputPtr> outputs;
+    for (mx::NodeGraphPtr graph : doc->getNodeGraphs())
+    {
+        for (mx::OutputPtr output : graph->getOutputs())
+        {
+            outputs.push_back(output);
+        }
+    }
+    state.measure([&]()
+    {
+        for (mx::OutputPtr output : outputs)
+        {
+            for (mx::Edge edge : output->traverseGraph())
+            {
+                (void) edge;
+            }
+        }
+    });
+}
+
+BENCHMARK_CASE("traversal/getChildrenOfType/stdlib")
+{
+    mx::DocumentPtr lib = loadStandardLibrary();
+    state.setItemCount(lib->getChildren().size());
+    state.measure([&]()
+    {
+        lib->getChildrenOfType<mx::NodeDef>();
+    });
+}
+
+BENCHMARK_CASE("traversal/getChildrenOfType/large")
+{
+    mx::DocumentPtr doc = createLargeDocument(100, 100);
+    std::vector<mx::NodeGraphPtr> graphs = doc->getNodeGraphs();
+    state.setItemCount(graphs.size());
+    state.measure([&]()
+    {
+        for (mx::NodeGraphPtr graph : graphs)
+        {
+            graph->getNodes();
+        }
+    });
+}
+
+BENCHMARK_CASE("traversal/childrenOfType/stdlib")
+{
+    mx::DocumentPtr lib = loadStandardLibrary();
+    size_t count = 0;
+    state.setItemCount(lib->getChildren().size());
+    state.measure([&]()
+    {
+        count = 0;
+        for (mx::NodeDefPtr nodeDef : lib->childrenOfType<mx::NodeDef>())
+        {
+            count += nodeDef ? 1 : 0;
+        }
+    });
+    state.setMetric("nodeDefCount", (double) count);
+}
+
+BENCHMARK_CASE("traversal/childrenOfType/large")
+{
+    mx::DocumentPtr doc = createLargeDocument(100, 100);
+    std::vector<mx::NodeGraphPtr> graphs = doc->getNodeGraphs();
+    size_t count = 0;
+    state.setItemCount(graphs.size());
+    state.measure([&]()
+    {
+        count = 0;
+        for (mx::NodeGraphPtr graph : graphs)
+        {
+            for (mx::NodePtr node : graph->childrenOfType<mx::Node>())
+            {
+                count += node ? 1 : 0;
+            }
+        }
+    });
+    state.setMetric("nodeCount", (double) count);
+}
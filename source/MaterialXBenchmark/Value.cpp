@@ -0,0 +1,74 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXBenchmark/Benchmark.h>
+
+namespace {
+
+const size_t VALUE_COUNT = 10000;
+
+} // anonymous namespace
+
+BENCHMARK_CASE("value/parse/float")
+{
+    state.setItemCount(VALUE_COUNT);
+    state.measure([]()
+    {
+        for (size_t i = 0; i < VALUE_COUNT; i++)
+        {
+            mx::Value::createValueFromStrings("0.25", "float");
+        }
+    });
+}
+
+BENCHMARK_CASE("value/parse/color3")
+{
+    state.setItemCount(VALUE_COUNT);
+    state.measure([]()
+    {
+        for (size_t i = 0; i < VALUE_COUNT; i++)
+        {
+            mx::Value::createValueFromStrings("0.1, 0.2, 0.3", "color3");
+        }
+    });
+}
+
+BENCHMARK_CASE("value/parse/matrix44")
+{
+    state.setItemCount(VALUE_COUNT);
+    state.measure([]()
+    {
+        for (size_t i = 0; i < VALUE_COUNT; i++)
+        {
+            mx::Value::createValueFromStrings("1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1", "matrix44");
+        }
+    });
+}
+
+BENCHMARK_CASE("value/format/color3")
+{
+    mx::ValuePtr value = mx::Value::createValue(mx::Color3(0.1f, 0.2f, 0.3f));
+    state.setItemCount(VALUE_COUNT);
+    state.measure([&]()
+    {
+        for (size_t i = 0; i < VALUE_COUNT; i++)
+        {
+            value->getValueString();
+        }
+    });
+}
+
+BENCHMARK_CASE("value/format/matrix44")
+{
+    mx::ValuePtr value = mx::Value::createValue(mx::Matrix4x4());
+    state.setItemCount(VALUE_COUNT);
+    state.measure([&]()
+    {
+        for (size_t i = 0; i < VALUE_COUNT; i++)
+        {
+            value->getValueString();
+        }
+    });
+}
@@ -0,0 +1,87 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXBenchmark/Benchmark.h>
+
+#include <MaterialXFormat/XmlIo.h>
+
+BENCHMARK_CASE("xmlio/read/stdlib")
+{
+    state.measure([]()
+    {
+        loadStandardLibrary();
+    });
+}
+
+BENCHMARK_CASE("xmlio/write/stdlib")
+{
+    mx::DocumentPtr lib = loadStandardLibrary();
+    state.measure([&]()
+    {
+        mx::writeToXmlString(lib);
+    });
+}
+
+BENCHMARK_CASE("xmlio/read/large")
+{
+    std::string xmlString = mx::writeToXmlString(createLargeDocument(100, 100), false);
+    state.setItemCount(xmlString.size());
+    state.measure([&]()
+    {
+        mx::DocumentPtr doc = mx::createDocument();
+        mx::readFromXmlString(doc, xmlString);
+    });
+}
+
+BENCHMARK_CASE("xmlio/write/large")
+{
+    mx::DocumentPtr doc = createLargeDocument(100, 100);
+    state.measure([&]()
+    {
+        mx::writeToXmlString(doc, false);
+    });
+}
+
+BENCHMARK_CASE("xmlio/read/generated")
+{
+    std::string xmlString = mx::writeToXmlString(createGeneratedDocument(), false);
+    state.setItemCount(xmlString.size());
+    state.measure([&]()
+    {
+        mx::DocumentPtr doc = mx::createDocument();
+        mx::readFromXmlString(doc, xmlString);
+    });
+}
+
+BENCHMARK_CASE("xmlio/write/generated")
+{
+    mx::DocumentPtr doc = createGeneratedDocument();
+    state.measure([&]()
+    {
+        mx::writeToXmlString(doc, false);
+    });
+}
+
+BENCHMARK_CASE("xmlio/readAsync/stdlib")
+{
+    // Each iteration loads several copies of the standard library
+    // concurrently.
+    const size_t loadCount = 8;
+    mx::XmlLoadOptions options;
+    options.searchPath = BENCHMARK_SEARCH_PATH;
+    state.setItemCount(loadCount);
+    state.measure([&]()
+    {
+        std::vector<mx::XmlLoadTaskPtr> tasks;
+        for (size_t i = 0; i < loadCount; i++)
+        {
+            tasks.push_back(mx::readFromXmlFileAsync("mx_stdlib_defs.mtlx", options));
+        }
+        for (mx::XmlLoadTaskPtr task : tasks)
+        {
+            task->get();
+        }
+    });
+}
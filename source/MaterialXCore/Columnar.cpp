@@ -0,0 +1,83 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXCore/Columnar.h>
+
+#include <MaterialXCore/Element.h>
+
+#include <unordered_map>
+
+namespace MaterialX
+{
+
+namespace {
+
+// Return the index of the given string in the dictionary, adding it if
+// it is not yet present.
+int encodeString(const string& str, vector<string>& dictionary, std::unordered_map<string, int>& indexMap)
+{
+    auto it = indexMap.find(str);
+    if (it != indexMap.end())
+        return it->second;
+    int index = (int) dictionary.size();
+    dictionary.push_back(str);
+    indexMap[str] = index;
+    return index;
+}
+
+} // anonymous namespace
+
+//
+// ColumnarTable methods
+//
+
+void ColumnarTable::clear()
+{
+    elementParents.clear();
+    elementCategories.clear();
+    elementNames.clear();
+    attributeElements.clear();
+    attributeNames.clear();
+    attributeValues.clear();
+    categoryDictionary.clear();
+    attributeNameDictionary.clear();
+}
+
+//
+// Global functions
+//
+
+ColumnarTable exportColumnarTable(ConstElementPtr root)
+{
+    ColumnarTable table;
+    std::unordered_map<string, int> categoryIndices;
+    std::unordered_map<string, int> attributeNameIndices;
+
+    // Track the row index of the most recent element at each depth, from
+    // which the parent of each subsequent element is derived.
+    vector<int> ancestorRows;
+    for (TreeIterator it = root->traverseTree().begin(); it != TreeIterator::end(); ++it)
+    {
+        ElementPtr elem = it.getElement();
+        size_t depth = it.getElementDepth();
+        int row = (int) table.elementNames.size();
+
+        ancestorRows.resize(depth);
+        table.elementParents.push_back(depth ? ancestorRows.back() : -1);
+        table.elementCategories.push_back(encodeString(elem->getCategory(), table.categoryDictionary, categoryIndices));
+        table.elementNames.push_back(elem->getName());
+        ancestorRows.push_back(row);
+
+        for (const string& attrName : elem->getAttributeNames())
+        {
+            table.attributeElements.push_back(row);
+            table.attributeNames.push_back(encodeString(attrName, table.attributeNameDictionary, attributeNameIndices));
+            table.attributeValues.push_back(elem->getAttribute(attrName));
+        }
+    }
+    return table;
+}
+
+} // namespace MaterialX
@@ -0,0 +1,96 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_COLUMNAR_H
+#define MATERIALX_COLUMNAR_H
+
+/// @file
+/// Columnar export of element trees
+
+#include <MaterialXCore/Library.h>
+
+namespace MaterialX
+{
+
+using ConstElementPtr = shared_ptr<const class Element>;
+
+/// @class ColumnarTable
+/// A flattened, column-oriented representation of an element tree, intended
+/// for bulk analysis of document content.
+///
+/// Elements are stored in depth-first pre-order, with the row index of each
+/// element serving as its identifier.  Attributes are stored in a separate
+/// table that refers to elements by row index.  Categories and attribute
+/// names are dictionary-encoded, with each entry storing an index into the
+/// corresponding string dictionary.
+/// @sa exportColumnarTable
+class ColumnarTable
+{
+  public:
+    ColumnarTable() { }
+    ~ColumnarTable() { }
+
+    /// Return the number of rows in the element table.
+    size_t getElementCount() const
+    {
+        return elementNames.size();
+    }
+
+    /// Return the number of rows in the attribute table.
+    size_t getAttributeCount() const
+    {
+        return attributeValues.size();
+    }
+
+    /// Clear all tables and dictionaries.
+    void clear();
+
+  public:
+    /// @name Element Table
+    /// @{
+
+    /// The row index of the parent of each element, or -1 for the root of
+    /// the exported tree.
+    vector<int> elementParents;
+
+    /// The index of each element's category in the category dictionary.
+    vector<int> elementCategories;
+
+    /// The name of each element.
+    vector<string> elementNames;
+
+    /// @}
+    /// @name Attribute Table
+    /// @{
+
+    /// The row index of the element that owns each attribute.
+    vector<int> attributeElements;
+
+    /// The index of each attribute's name in the attribute name dictionary.
+    vector<int> attributeNames;
+
+    /// The value string of each attribute.
+    vector<string> attributeValues;
+
+    /// @}
+    /// @name Dictionaries
+    /// @{
+
+    /// The unique element categories, in order of first appearance.
+    vector<string> categoryDictionary;
+
+    /// The unique attribute names, in order of first appearance.
+    vector<string> attributeNameDictionary;
+
+    /// @}
+};
+
+/// Flatten the element tree rooted at the given element into a columnar
+/// table, visiting each element in a single depth-first pass.
+ColumnarTable exportColumnarTable(ConstElementPtr root);
+
+} // namespace MaterialX
+
+#endif
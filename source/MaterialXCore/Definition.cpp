@@ -23,9 +23,9 @@ const string Implementation::LANGUAGE_ATTRIBUTE = "language";
 vector<ShaderRefPtr> NodeDef::getInstantiatingShaderRefs() const
 {
     vector<ShaderRefPtr> shaderRefs;
-    for (MaterialPtr mat : getRoot()->getChildrenOfType<Material>())
+    for (MaterialPtr mat : getRoot()->childrenOfType<Material>())
     {
-        for (ShaderRefPtr shaderRef : mat->getShaderRefs())
+        for (ShaderRefPtr shaderRef : mat->childrenOfType<ShaderRef>())
         {
             if (shaderRef->getReferencedShaderDef() == getSelf())
             {
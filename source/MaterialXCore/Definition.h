@@ -28,11 +28,11 @@ using ImplementationPtr = shared_ptr<class Implementation>;
 ///
 /// A NodeDef provides the declaration of a node interface, which may then
 /// be instantiated as a Node or a ShaderRef.
-class NodeDef : public InterfaceElement
+class NodeDef : public ConcreteElement<NodeDef, InterfaceElement>
 {
   public:
     NodeDef(ElementPtr parent, const string& name) :
-        InterfaceElement(parent, CATEGORY, name)
+        ConcreteElement<NodeDef, InterfaceElement>(parent, CATEGORY, name)
     {
     }
     virtual ~NodeDef() { }
@@ -84,11 +84,11 @@ class NodeDef : public InterfaceElement
 
 /// @class TypeDef
 /// A type definition element within a Document.
-class TypeDef : public Element
+class TypeDef : public ConcreteElement<TypeDef, Element>
 {
   public:
     TypeDef(ElementPtr parent, const string& name) :
-        Element(parent, CATEGORY, name)
+        ConcreteElement<TypeDef, Element>(parent, CATEGORY, name)
     {
     }
     virtual ~TypeDef() { }
@@ -103,11 +103,11 @@ class TypeDef : public Element
 /// An Implementation is used to associate external source code with a specific
 /// NodeDef, providing a definition for the node that may eiher be universal or
 /// restricted to a specific target.
-class Implementation : public InterfaceElement
+class Implementation : public ConcreteElement<Implementation, InterfaceElement>
 {
   public:
     Implementation(ElementPtr parent, const string& name) :
-        InterfaceElement(parent, CATEGORY, name)
+        ConcreteElement<Implementation, InterfaceElement>(parent, CATEGORY, name)
     {
     }
     virtual ~Implementation() { }
@@ -0,0 +1,295 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXCore/Diff.h>
+
+#include <algorithm>
+
+namespace MaterialX
+{
+
+namespace {
+
+string getChildPath(const string& parentPath, const string& name)
+{
+    return parentPath.empty() ? name : parentPath + NAME_PATH_SEPARATOR + name;
+}
+
+ElementEdit createEdit(ElementEdit::Type type, const string& path)
+{
+    ElementEdit edit;
+    edit.type = type;
+    edit.path = path;
+    return edit;
+}
+
+void diffAttributes(ConstElementPtr source, ConstElementPtr dest, const string& path, DocumentPatch& patch)
+{
+    const vector<string>& sourceNames = source->getAttributeNames();
+    const vector<string>& destNames = dest->getAttributeNames();
+
+    // Remove attributes that are missing from the destination, and find the
+    // longest prefix of remaining attributes that already matches the
+    // destination order.
+    vector<string> retainedNames;
+    for (const string& name : sourceNames)
+    {
+        if (dest->hasAttribute(name))
+        {
+            retainedNames.push_back(name);
+        }
+        else
+        {
+            ElementEdit edit = createEdit(ElementEdit::TypeRemoveAttribute, path);
+            edit.attribute = name;
+            patch.push_back(edit);
+        }
+    }
+    size_t prefix = 0;
+    while (prefix < retainedNames.size() && prefix < destNames.size() &&
+           retainedNames[prefix] == destNames[prefix])
+    {
+        prefix++;
+    }
+
+    // Since new attributes are appended, attributes after the matching
+    // prefix are removed and then assigned in destination order.
+    for (size_t i = prefix; i < retainedNames.size(); i++)
+    {
+        ElementEdit edit = createEdit(ElementEdit::TypeRemoveAttribute, path);
+        edit.attribute = retainedNames[i];
+        patch.push_back(edit);
+    }
+    for (size_t i = 0; i < destNames.size(); i++)
+    {
+        const string& value = dest->getAttribute(destNames[i]);
+        if (i >= prefix || source->getAttribute(destNames[i]) != value)
+        {
+            ElementEdit edit = createEdit(ElementEdit::TypeSetAttribute, path);
+            edit.attribute = destNames[i];
+            edit.value = value;
+            patch.push_back(edit);
+        }
+    }
+}
+
+// Return a detached copy of the given element, held within the given
+// document.  The returned pointer shares ownership of the holding document,
+// which keeps the copy alive for as long as the pointer.
+ConstElementPtr createDetachedCopy(ConstElementPtr elem, DocumentPtr holder)
+{
+    ElementPtr copy = holder->addChildOfCategory(elem->getCategory(),
+                                                 holder->createValidChildName(elem->getName()));
+    copy->copyContentFrom(elem);
+    return ConstElementPtr(holder, copy.get());
+}
+
+void diffElements(ConstElementPtr source, ConstElementPtr dest, const string& path,
+                  DocumentPatch& patch, DocumentPtr& holder)
+{
+    if (source->getContentHash() == dest->getContentHash())
+    {
+        return;
+    }
+
+    diffAttributes(source, dest, path, patch);
+
+    const vector<ElementPtr>& sourceChildren = source->getChildren();
+    const vector<ElementPtr>& destChildren = dest->getChildren();
+
+    // In the common case, children match one-to-one and only their contents
+    // differ.
+    bool matchingChildren = sourceChildren.size() == destChildren.size();
+    for (size_t i = 0; matchingChildren && i < sourceChildren.size(); i++)
+    {
+        matchingChildren = sourceChildren[i]->getName() == destChildren[i]->getName() &&
+                           sourceChildren[i]->getCategory() == destChildren[i]->getCategory();
+    }
+    if (matchingChildren)
+    {
+        for (size_t i = 0; i < sourceChildren.size(); i++)
+        {
+            diffElements(sourceChildren[i], destChildren[i], getChildPath(path, sourceChildren[i]->getName()),
+                         patch, holder);
+        }
+        return;
+    }
+
+    // Remove children that are missing from the destination, or whose
+    // categories have changed.
+    auto isRetained = [](ConstElementPtr child, ConstElementPtr otherParent)
+    {
+        ElementPtr other = otherParent->getChild(child->getName());
+        return other && other->getCategory() == child->getCategory();
+    };
+    vector<string> currentOrder;
+    for (ElementPtr child : sourceChildren)
+    {
+        if (isRetained(child, dest))
+        {
+            currentOrder.push_back(child->getName());
+        }
+        else
+        {
+            patch.push_back(createEdit(ElementEdit::TypeRemoveElement, getChildPath(path, child->getName())));
+        }
+    }
+
+    // Add and move children into destination order, tracking the order of
+    // the patched element as edits are emitted.
+    for (size_t i = 0; i < destChildren.size(); i++)
+    {
+        ElementPtr child = destChildren[i];
+        const string& name = child->getName();
+        if (!isRetained(child, source))
+        {
+            ElementEdit edit = createEdit(ElementEdit::TypeAddElement, getChildPath(path, name));
+            edit.category = child->getCategory();
+            edit.index = (int) i;
+            if (!holder)
+            {
+                holder = createDocument();
+            }
+            edit.content = createDetachedCopy(child, holder);
+            patch.push_back(edit);
+            currentOrder.insert(currentOrder.begin() + i, name);
+        }
+        else if (currentOrder[i] != name)
+        {
+            ElementEdit edit = createEdit(ElementEdit::TypeMoveElement, getChildPath(path, name));
+            edit.index = (int) i;
+            patch.push_back(edit);
+            currentOrder.erase(std::find(currentOrder.begin() + i, currentOrder.end(), name));
+            currentOrder.insert(currentOrder.begin() + i, name);
+        }
+    }
+
+    // Recurse into retained children.
+    for (ElementPtr child : destChildren)
+    {
+        if (isRetained(child, source))
+        {
+            diffElements(source->getChild(child->getName()), child, getChildPath(path, child->getName()),
+                         patch, holder);
+        }
+    }
+}
+
+ElementPtr getElementAtPath(DocumentPtr doc, const string& path)
+{
+    ElementPtr elem = doc;
+    if (path.empty())
+    {
+        return elem;
+    }
+    for (const string& name : splitString(path, NAME_PATH_SEPARATOR))
+    {
+        elem = elem->getChild(name);
+        if (!elem)
+        {
+            throw Exception("No element found at path: " + path);
+        }
+    }
+    return elem;
+}
+
+// Return the parent of the element at the given path, along with the name of
+// the element within its parent.
+std::pair<ElementPtr, string> getParentAtPath(DocumentPtr doc, const string& path)
+{
+    size_t pos = path.rfind(NAME_PATH_SEPARATOR);
+    if (pos == string::npos)
+    {
+        return std::make_pair(ElementPtr(doc), path);
+    }
+    return std::make_pair(getElementAtPath(doc, path.substr(0, pos)), path.substr(pos + 1));
+}
+
+} // anonymous namespace
+
+//
+// ElementEdit methods
+//
+
+string ElementEdit::asString() const
+{
+    switch (type)
+    {
+        case TypeAddElement:
+            return "add " + path + " (" + category + ") at " + std::to_string(index);
+        case TypeRemoveElement:
+            return "remove " + path;
+        case TypeMoveElement:
+            return "move " + path + " to " + std::to_string(index);
+        case TypeSetAttribute:
+            return "set " + path + " " + attribute + "=\"" + value + "\"";
+        case TypeRemoveAttribute:
+            return "remove " + path + " " + attribute;
+    }
+    return EMPTY_STRING;
+}
+
+//
+// Global functions
+//
+
+DocumentPatch diffDocuments(ConstDocumentPtr source, ConstDocumentPtr dest)
+{
+    // Added elements are copied into a holder document shared by the patch.
+    DocumentPatch patch;
+    DocumentPtr holder;
+    diffElements(source, dest, EMPTY_STRING, patch, holder);
+    return patch;
+}
+
+void applyPatch(DocumentPtr doc, const DocumentPatch& patch)
+{
+    ScopedUpdate update(doc);
+    for (const ElementEdit& edit : patch)
+    {
+        switch (edit.type)
+        {
+            case ElementEdit::TypeAddElement:
+            {
+                std::pair<ElementPtr, string> parent = getParentAtPath(doc, edit.path);
+                ElementPtr child = parent.first->addChildOfCategory(edit.category, parent.second);
+                if (edit.content)
+                {
+                    child->copyContentFrom(edit.content);
+                }
+                parent.first->setChildIndex(parent.second, edit.index);
+                break;
+            }
+            case ElementEdit::TypeRemoveElement:
+            {
+                std::pair<ElementPtr, string> parent = getParentAtPath(doc, edit.path);
+                if (!parent.first->getChild(parent.second))
+                {
+                    throw Exception("No element found at path: " + edit.path);
+                }
+                parent.first->removeChild(parent.second);
+                break;
+            }
+            case ElementEdit::TypeMoveElement:
+            {
+                std::pair<ElementPtr, string> parent = getParentAtPath(doc, edit.path);
+                if (!parent.first->getChild(parent.second))
+                {
+                    throw Exception("No element found at path: " + edit.path);
+                }
+                parent.first->setChildIndex(parent.second, edit.index);
+                break;
+            }
+            case ElementEdit::TypeSetAttribute:
+                getElementAtPath(doc, edit.path)->setAttribute(edit.attribute, edit.value);
+                break;
+            case ElementEdit::TypeRemoveAttribute:
+                getElementAtPath(doc, edit.path)->removeAttribute(edit.attribute);
+                break;
+        }
+    }
+}
+
+} // namespace MaterialX
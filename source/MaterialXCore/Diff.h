@@ -0,0 +1,108 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_DIFF_H
+#define MATERIALX_DIFF_H
+
+/// @file
+/// Structural differences between documents
+
+#include <MaterialXCore/Library.h>
+
+#include <MaterialXCore/Document.h>
+
+namespace MaterialX
+{
+
+/// @class ElementEdit
+/// A single edit within a DocumentPatch, addressing its target element by
+/// name path relative to the document root.
+/// @sa diffDocuments
+/// @sa applyPatch
+class ElementEdit
+{
+  public:
+    enum Type
+    {
+        /// Add a copy of the content element at the given path and index.
+        TypeAddElement = 0,
+        /// Remove the element at the given path.
+        TypeRemoveElement = 1,
+        /// Move the element at the given path to the given child index
+        /// within its current parent.  Elements are never moved between
+        /// parents, which is instead expressed as a removal and an addition.
+        TypeMoveElement = 2,
+        /// Set the given attribute of the element at the given path.
+        TypeSetAttribute = 3,
+        /// Remove the given attribute of the element at the given path.
+        TypeRemoveAttribute = 4
+    };
+
+  public:
+    ElementEdit() :
+        type(TypeAddElement),
+        index(0)
+    {
+    }
+    ~ElementEdit() { }
+
+    /// Return a single-line description of this edit.
+    string asString() const;
+
+  public:
+    /// The type of the edit.
+    Type type;
+
+    /// The name path of the target element.
+    string path;
+
+    /// For element additions, the category of the new element.
+    string category;
+
+    /// For element additions and moves, the child index of the element
+    /// within its parent.
+    int index;
+
+    /// For attribute edits, the name of the attribute.
+    string attribute;
+
+    /// For attribute assignments, the new value of the attribute.
+    string value;
+
+    /// For element additions, the element whose attributes and descendants
+    /// are copied to the new element.  Patches returned by diffDocuments
+    /// hold detached copies of the added elements, which remain valid after
+    /// the compared documents are modified or destroyed.
+    ConstElementPtr content;
+};
+
+/// A sequence of edits transforming one document into another.
+using DocumentPatch = vector<ElementEdit>;
+
+/// Return the edits that transform the first document into the second.
+///
+/// Elements are matched by name within each parent, so a change in the order
+/// of siblings is expressed as moves, while an element that changes parents
+/// is expressed as a removal and an addition.  Elements whose categories
+/// differ are replaced.
+///
+/// Subtrees with equal content hashes are skipped without traversal, so the
+/// cost of a diff is proportional to the size of the changed branches once
+/// hashes have been computed.  Equal hashes are trusted without a full
+/// comparison, so a collision of 64-bit hashes, while vanishingly unlikely,
+/// would cause a difference to be missed.
+/// @param source The original document.
+/// @param dest The modified document.
+/// @return A patch which, when applied to the original document, produces
+///    a document equal to the modified one.
+DocumentPatch diffDocuments(ConstDocumentPtr source, ConstDocumentPtr dest);
+
+/// Apply the edits of the given patch to a document, in order.
+/// @throws Exception if an edit addresses an element that does not exist.
+void applyPatch(DocumentPtr doc, const DocumentPatch& patch);
+
+} // namespace MaterialX
+
+#endif
@@ -5,11 +5,15 @@
 
 #include <MaterialXCore/Document.h>
 
+#include <MaterialXCore/Instrumentation.h>
 #include <MaterialXCore/Util.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iterator>
 #include <mutex>
 #include <sstream>
+#include <unordered_set>
 
 namespace MaterialX
 {
@@ -27,20 +31,133 @@ const string Document::REQUIRE_STRING_OVERRIDE = "override";
 
 namespace {
 
-template<class T> shared_ptr<T> replaceChild(ElementPtr parent, ElementPtr origChild, string newChildName = EMPTY_STRING)
+// Replace the given child with a copy of the given subclass, retaining its
+// name and index.  Elements that keep their subclass should instead be
+// renamed or moved in place.
+template<class T> shared_ptr<T> replaceChild(ElementPtr parent, ElementPtr origChild)
 {
-    if (newChildName.empty())
-    {
-        newChildName = origChild->getName();
-    }
-    int origIndex = parent->getChildIndex(origChild->getName());
-    parent->removeChild(origChild->getName());
-    shared_ptr<T> newChild = parent->addChild<T>(newChildName);
-    parent->setChildIndex(newChildName, origIndex);
+    const string& name = origChild->getName();
+    int origIndex = parent->getChildIndex(name);
+    parent->removeChild(name);
+    shared_ptr<T> newChild = parent->addChild<T>(name);
+    parent->setChildIndex(name, origIndex);
     newChild->copyContentFrom(origChild);
     return newChild;
 }
 
+// Separates the fields of nodedef index keys, and cannot appear in names.
+const char KEY_SEPARATOR = '\n';
+
+string getNodeDefTypeKey(const string& category, const string& type)
+{
+    return category + KEY_SEPARATOR + type;
+}
+
+// Return a key combining the category, type, and input names and types of
+// the given node, which determine the nodedef that it references.
+string getNodeSignatureKey(const Node& node)
+{
+    string key = getNodeDefTypeKey(node.getCategory(), node.getType());
+    vector<std::pair<const string*, const string*>> inputs;
+    for (ElementPtr child : node.getChildren())
+    {
+        InputPtr input = child->asA<Input>();
+        if (input)
+        {
+            inputs.emplace_back(&input->getName(), &input->getType());
+        }
+    }
+    std::sort(inputs.begin(), inputs.end(),
+        [](const std::pair<const string*, const string*>& lhs, const std::pair<const string*, const string*>& rhs)
+        {
+            return *lhs.first < *rhs.first;
+        });
+    for (const auto& input : inputs)
+    {
+        key += KEY_SEPARATOR;
+        key += *input.first;
+        key += KEY_SEPARATOR;
+        key += *input.second;
+    }
+    return key;
+}
+
+// Return true if the input types of the given node are compatible with the
+// given nodedef.
+bool isNodeDefCompatible(const Node& node, NodeDefPtr nodeDef)
+{
+    for (ElementPtr child : node.getChildren())
+    {
+        InputPtr input = child->asA<Input>();
+        if (input)
+        {
+            InputPtr matchingInput = nodeDef->getInput(input->getName());
+            if (matchingInput && matchingInput->getType() != input->getType())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Append the libraries referenced by the given document to the given
+// vector, depth first, skipping those in the given set of visited libraries.
+void collectLibraries(const Document& doc, vector<ConstDocumentPtr>& libraries,
+                      std::unordered_set<const Document*>& visited)
+{
+    for (ConstDocumentPtr library : doc.getReferencedLibraries())
+    {
+        if (visited.insert(library.get()).second)
+        {
+            libraries.push_back(library);
+            collectLibraries(*library, libraries, visited);
+        }
+    }
+}
+
+// Return the libraries referenced by the given document, directly or
+// indirectly, in depth-first order and without duplicates.
+vector<ConstDocumentPtr> collectLibraries(const Document& doc)
+{
+    vector<ConstDocumentPtr> libraries;
+    std::unordered_set<const Document*> visited;
+    collectLibraries(doc, libraries, visited);
+    return libraries;
+}
+
+string getImplementationKey(const string& nodeDef, const string& target, const string& language)
+{
+    return nodeDef + KEY_SEPARATOR + target + KEY_SEPARATOR + language;
+}
+
+// Return the rank of the given implementation for the given target and
+// language, or -1 if the implementation is incompatible with them.  An
+// implementation with no target or language is compatible with all targets
+// or languages, but is ranked below one that matches them explicitly.
+int getImplementationRank(ElementPtr implementation, const string& target, const string& language)
+{
+    const string& implTarget = implementation->getTarget();
+    if (!implTarget.empty() && implTarget != target)
+    {
+        return -1;
+    }
+
+    ImplementationPtr impl = implementation->asA<Implementation>();
+    const string& implLanguage = impl ? impl->getLanguage() : EMPTY_STRING;
+    if (!language.empty() && !implLanguage.empty() && implLanguage != language)
+    {
+        return -1;
+    }
+
+    int rank = implTarget.empty() ? 0 : 2;
+    if (!language.empty() && implLanguage == language)
+    {
+        rank++;
+    }
+    return rank;
+}
+
 } // anonymous namespace
 
 //
@@ -60,7 +177,9 @@ class Document::Cache
 {
   public:
     Cache() :
-        valid(false)
+        valid(false),
+        revision(0),
+        libraryRevision(0)
     {
     }
     ~Cache() { }
@@ -70,22 +189,45 @@ class Document::Cache
         // Thread synchronization for multiple concurrent readers of a single document.
         std::lock_guard<std::mutex> guard(mutex);
 
-        if (!valid)
+        // Referenced libraries are not observed by this document, so edits to
+        // them are detected through their revisions.  Since adding or
+        // removing a reference changes the revision of the referencing
+        // library, the flattened list is only collected again on a change.
+        DocumentPtr document = doc.lock();
+        uint64_t currentLibraryRevision = getLibraryRevision();
+        if (currentLibraryRevision != libraryRevision)
         {
+            libraries = collectLibraries(*document);
+            currentLibraryRevision = getLibraryRevision();
+            valid = false;
+        }
+
+        if (valid && currentLibraryRevision == libraryRevision)
+        {
+            Instrumentation::incrementCounter("Document::Cache/hit");
+        }
+        else
+        {
+            ScopedTimer timer("Document::Cache::refresh");
+            Instrumentation::incrementCounter("Document::Cache/miss");
+
             // Clear the existing cache.
             portElementMap.clear();
             publicElementMap.clear();
             nodeDefMap.clear();
+            nodeDefTypeMap.clear();
             implementationMap.clear();
+            {
+                std::lock_guard<std::mutex> memoGuard(memoMutex);
+                nodeDefSignatureMap.clear();
+                implementationSelectionMap.clear();
+            }
 
             // Traverse the document to build a new cache.
-            for (ElementPtr elem : doc.lock()->traverseTree())
+            for (ElementPtr elem : document->traverseTree())
             {
                 PortElementPtr portElem = elem->asA<PortElement>();
                 ValueElementPtr valueElem = elem->asA<ValueElement>();
-                NodeDefPtr nodeDef = elem->asA<NodeDef>();
-                NodeGraphPtr nodeGraph = elem->asA<NodeGraph>();
-                ImplementationPtr implementation = elem->asA<Implementation>();
 
                 if (portElem && portElem->hasNodeName())
                 {
@@ -99,48 +241,210 @@ class Document::Cache
                         valueElem->getPublicName(),
                         valueElem));
                 }
-                if (nodeDef && nodeDef->hasNode())
+                addDefinition(elem);
+            }
+
+            // Add the definitions of referenced libraries, which follow those
+            // of the document itself.
+            for (ConstDocumentPtr library : libraries)
+            {
+                for (ElementPtr elem : library->getChildren())
                 {
-                    nodeDefMap.insert(std::pair<string, NodeDefPtr>(
-                        nodeDef->getNode(),
-                        nodeDef));
+                    addDefinition(elem);
                 }
-                if (nodeGraph && nodeGraph->hasNodeDef())
+            }
+
+            valid = true;
+            libraryRevision = currentLibraryRevision;
+        }
+    }
+
+    // Return the sum of the revisions of the referenced libraries.
+    uint64_t getLibraryRevision() const
+    {
+        uint64_t sum = 0;
+        for (ConstDocumentPtr library : libraries)
+        {
+            sum += library->getRevision();
+        }
+        return sum;
+    }
+
+    // Add the given element to the nodedef and implementation maps, if it is
+    // a nodedef or node implementation.
+    void addDefinition(ElementPtr elem)
+    {
+        NodeDefPtr nodeDef = elem->asA<NodeDef>();
+        NodeGraphPtr nodeGraph = elem->asA<NodeGraph>();
+        ImplementationPtr implementation = elem->asA<Implementation>();
+
+        if (nodeDef && nodeDef->hasNode())
+        {
+            nodeDefMap.insert(std::pair<string, NodeDefPtr>(
+                nodeDef->getNode(),
+                nodeDef));
+            nodeDefTypeMap[getNodeDefTypeKey(nodeDef->getNode(), nodeDef->getType())].push_back(nodeDef);
+        }
+        if (nodeGraph && nodeGraph->hasNodeDef())
+        {
+            implementationMap[nodeGraph->getNodeDef()].push_back(nodeGraph);
+        }
+        if (implementation && implementation->hasNodeDef())
+        {
+            implementationMap[implementation->getNodeDef()].push_back(implementation);
+        }
+    }
+
+    // Return the nodedef referenced by the given node, memoizing the result
+    // by node signature.  The cache must be valid.
+    NodeDefPtr resolveNodeDef(const Node& node)
+    {
+        string key = getNodeSignatureKey(node);
+        {
+            std::lock_guard<std::mutex> guard(memoMutex);
+            auto it = nodeDefSignatureMap.find(key);
+            if (it != nodeDefSignatureMap.end())
+            {
+                return it->second;
+            }
+        }
+
+        NodeDefPtr result;
+        auto it = nodeDefTypeMap.find(getNodeDefTypeKey(node.getCategory(), node.getType()));
+        if (it != nodeDefTypeMap.end())
+        {
+            for (NodeDefPtr nodeDef : it->second)
+            {
+                if (isNodeDefCompatible(node, nodeDef))
                 {
-                    implementationMap.insert(std::pair<string, ElementPtr>(
-                        nodeGraph->getNodeDef(),
-                        nodeGraph));
+                    result = nodeDef;
+                    break;
                 }
-                if (implementation && implementation->hasNodeDef())
+            }
+        }
+
+        std::lock_guard<std::mutex> guard(memoMutex);
+        nodeDefSignatureMap.emplace(key, result);
+        return result;
+    }
+
+    // Return the highest-ranked implementation of the given nodedef for the
+    // given target and language, memoizing the result.  Ties are broken by
+    // document order.  The cache must be valid.
+    ElementPtr resolveImplementation(const string& nodeDef, const string& target, const string& language)
+    {
+        string key = getImplementationKey(nodeDef, target, language);
+        {
+            std::lock_guard<std::mutex> guard(memoMutex);
+            auto it = implementationSelectionMap.find(key);
+            if (it != implementationSelectionMap.end())
+            {
+                return it->second;
+            }
+        }
+
+        ElementPtr result;
+        auto it = implementationMap.find(nodeDef);
+        if (it != implementationMap.end())
+        {
+            int bestRank = -1;
+            for (ElementPtr implementation : it->second)
+            {
+                int rank = getImplementationRank(implementation, target, language);
+                if (rank > bestRank)
                 {
-                    implementationMap.insert(std::pair<string, ElementPtr>(
-                        implementation->getNodeDef(),
-                        implementation));
+                    result = implementation;
+                    bestRank = rank;
                 }
             }
+        }
 
-            valid = true;
+        std::lock_guard<std::mutex> guard(memoMutex);
+        implementationSelectionMap.emplace(key, result);
+        return result;
+    }
+
+    // Return the implementation of the given node for the given target and
+    // language.  The cache must be valid.
+    ElementPtr resolveImplementation(const Node& node, const string& target, const string& language)
+    {
+        NodeDefPtr nodeDef = resolveNodeDef(node);
+        if (!nodeDef)
+        {
+            return ElementPtr();
         }
+        return resolveImplementation(nodeDef->getName(), target, language);
+    }
+
+    // Return the bytes used by the cache maps and their keys.
+    size_t getMemoryUsage()
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+
+        size_t bytes = MemoryUsage::getHashMapBytes(portElementMap) +
+                       MemoryUsage::getHashMapBytes(publicElementMap) +
+                       MemoryUsage::getHashMapBytes(nodeDefMap) +
+                       MemoryUsage::getHashMapBytes(nodeDefTypeMap) +
+                       MemoryUsage::getHashMapBytes(nodeDefSignatureMap) +
+                       MemoryUsage::getHashMapBytes(implementationMap) +
+                       MemoryUsage::getHashMapBytes(implementationSelectionMap);
+        for (const auto& pair : portElementMap)
+            bytes += MemoryUsage::getStringBytes(pair.first);
+        for (const auto& pair : publicElementMap)
+            bytes += MemoryUsage::getStringBytes(pair.first);
+        for (const auto& pair : nodeDefMap)
+            bytes += MemoryUsage::getStringBytes(pair.first);
+        for (const auto& pair : nodeDefTypeMap)
+            bytes += MemoryUsage::getStringBytes(pair.first) + MemoryUsage::getVectorBytes(pair.second);
+        for (const auto& pair : nodeDefSignatureMap)
+            bytes += MemoryUsage::getStringBytes(pair.first);
+        for (const auto& pair : implementationMap)
+            bytes += MemoryUsage::getStringBytes(pair.first) + MemoryUsage::getVectorBytes(pair.second);
+        for (const auto& pair : implementationSelectionMap)
+            bytes += MemoryUsage::getStringBytes(pair.first);
+        bytes += MemoryUsage::getVectorBytes(libraries);
+        return bytes;
     }
 
   public:
     weak_ptr<Document> doc;
     std::mutex mutex;
     bool valid;
+    std::atomic<uint64_t> revision;
+    uint64_t libraryRevision;
+    vector<ConstDocumentPtr> libraries;
     std::unordered_multimap<string, PortElementPtr> portElementMap;
     std::unordered_multimap<string, ValueElementPtr> publicElementMap;
     std::unordered_multimap<string, NodeDefPtr> nodeDefMap;
-    std::unordered_multimap<string, ElementPtr> implementationMap;
+    std::unordered_map<string, vector<NodeDefPtr>> nodeDefTypeMap;
+    std::unordered_map<string, vector<ElementPtr>> implementationMap;
+    std::mutex memoMutex;
+    std::unordered_map<string, NodeDefPtr> nodeDefSignatureMap;
+    std::unordered_map<string, ElementPtr> implementationSelectionMap;
 };
 
+//
+// MemoryUsage methods
+//
+
+size_t MemoryUsage::getStringBytes(const string& str)
+{
+    static const size_t inlineCapacity = string().capacity();
+    return str.capacity() > inlineCapacity ? str.capacity() + 1 : 0;
+}
+
 //
 // Document methods
 //
 
 Document::Document(ElementPtr parent, const string& name) :
-    Element(parent, CATEGORY, name),
+    ConcreteElement<Document, Element>(parent, CATEGORY, name),
     _cache(std::unique_ptr<Cache>(new Cache))
 {
+    // The document holds the first id, and enters itself into the table
+    // once it is owned by a shared pointer.
+    _id = 0;
+    _elementTable.resize(1);
 }
 
 Document::~Document()
@@ -159,6 +463,14 @@ void Document::initialize()
     onInitialize();
 
     clearContent();
+    _libraries.clear();
+    _cache->libraries.clear();
+
+    // All elements other than the document have been released, so restart
+    // the ids of new elements from the lowest values.
+    _elementTable.assign(1, getSelf());
+    _freeElementIds.clear();
+
     setVersionString(DOCUMENT_VERSION_STRING);
 }
 
@@ -175,6 +487,52 @@ void Document::importLibrary(ConstDocumentPtr library)
     }
 }
 
+void Document::addReferencedLibrary(ConstDocumentPtr library)
+{
+    if (std::find(_libraries.begin(), _libraries.end(), library) != _libraries.end())
+    {
+        return;
+    }
+
+    vector<ConstDocumentPtr> libraries = collectLibraries(*library);
+    libraries.insert(libraries.begin(), library);
+    for (ConstDocumentPtr referenced : libraries)
+    {
+        if (referenced.get() == this)
+        {
+            throw ExceptionFoundCycle("Encountered a cycle in library references: " + library->getSourceUri());
+        }
+    }
+
+    _libraries.push_back(library);
+    _cache->libraries = collectLibraries(*this);
+    _cache->valid = false;
+    _cache->revision++;
+}
+
+void Document::removeReferencedLibrary(ConstDocumentPtr library)
+{
+    auto it = std::find(_libraries.begin(), _libraries.end(), library);
+    if (it != _libraries.end())
+    {
+        _libraries.erase(it);
+        _cache->libraries = collectLibraries(*this);
+        _cache->valid = false;
+        _cache->revision++;
+    }
+}
+
+TreeIterator Document::traverseTreeWithLibraries() const
+{
+    vector<ConstDocumentPtr> libraries = collectLibraries(*this);
+    vector<ElementPtr> roots(1, std::const_pointer_cast<Element>(getSelf()));
+    for (ConstDocumentPtr library : libraries)
+    {
+        roots.push_back(std::const_pointer_cast<Document>(library));
+    }
+    return TreeIterator(roots);
+}
+
 std::pair<int, int> Document::getVersionIntegers()
 {
     string versionString = getVersionString();
@@ -227,20 +585,57 @@ vector<NodeDefPtr> Document::getMatchingNodeDefs(const string& nodeName) const
     return nodeDefs;
 }
 
+NodeDefPtr Document::getNodeDefForNode(const Node& node) const
+{
+    _cache->refresh();
+    return _cache->resolveNodeDef(node);
+}
+
+vector<NodeDefPtr> Document::getNodeDefsForNodes(const vector<NodePtr>& nodes) const
+{
+    ScopedTimer timer("Document::getNodeDefsForNodes");
+    _cache->refresh();
+    vector<NodeDefPtr> nodeDefs;
+    nodeDefs.reserve(nodes.size());
+    for (NodePtr node : nodes)
+    {
+        nodeDefs.push_back(_cache->resolveNodeDef(*node));
+    }
+    return nodeDefs;
+}
+
 vector<ElementPtr> Document::getMatchingImplementations(const string& nodeDef) const
 {
     // Refresh the cache.
     _cache->refresh();
 
-    // Find all implementations matching the given nodedef string.
-    vector<ElementPtr> implementations;
-    auto keyRange = _cache->implementationMap.equal_range(nodeDef);
-    for (auto it = keyRange.first; it != keyRange.second; ++it)
+    // Return all implementations matching the given nodedef string.
+    auto it = _cache->implementationMap.find(nodeDef);
+    if (it != _cache->implementationMap.end())
     {
-        implementations.push_back(it->second);
+        return it->second;
     }
+    return vector<ElementPtr>();
+}
 
-    // Return the matches.
+ElementPtr Document::getImplementationForNode(const Node& node, const string& target, const string& language) const
+{
+    _cache->refresh();
+    return _cache->resolveImplementation(node, target, language);
+}
+
+vector<ElementPtr> Document::getImplementationsForNodes(const vector<NodePtr>& nodes,
+                                                        const string& target,
+                                                        const string& language) const
+{
+    ScopedTimer timer("Document::getImplementationsForNodes");
+    _cache->refresh();
+    vector<ElementPtr> implementations;
+    implementations.reserve(nodes.size());
+    for (NodePtr node : nodes)
+    {
+        implementations.push_back(_cache->resolveImplementation(*node, target, language));
+    }
     return implementations;
 }
 
@@ -276,6 +671,20 @@ vector<ElementPtr> Document::getPublicElements(const string& publicName) const
     return publicElements;
 }
 
+vector<ValueElementPtr> Document::getAllPublicElements() const
+{
+    // Refresh the cache.
+    _cache->refresh();
+
+    vector<ValueElementPtr> publicElements;
+    publicElements.reserve(_cache->publicElementMap.size());
+    for (const auto& pair : _cache->publicElementMap)
+    {
+        publicElements.push_back(pair.second);
+    }
+    return publicElements;
+}
+
 StringMap Document::getFilenameStringMap(const string& geom) const
 {
     StringMap map;
@@ -331,8 +740,37 @@ void Document::generateRequireString()
     setRequireString(requireStr);
 }
 
+MemoryUsage Document::getMemoryUsage() const
+{
+    MemoryUsage usage;
+    for (ElementPtr elem : traverseTree())
+    {
+        size_t ownedBytes = usage.getTotalBytes() - usage.cacheBytes;
+        elem->addMemoryUsage(usage);
+        ownedBytes = usage.getTotalBytes() - usage.cacheBytes - ownedBytes;
+
+        usage.elementCount++;
+        usage.categoryCounts[elem->getCategory()]++;
+        usage.categoryBytes[elem->getCategory()] += ownedBytes;
+    }
+    return usage;
+}
+
+void Document::addMemoryUsage(MemoryUsage& usage) const
+{
+    Element::addMemoryUsage(usage);
+
+    // Referenced libraries are shared rather than owned, so only the list
+    // of references is charged to this document.
+    usage.childContainerBytes += MemoryUsage::getVectorBytes(_libraries);
+    usage.cacheBytes += sizeof(Cache) + _cache->getMemoryUsage() +
+                        MemoryUsage::getVectorBytes(_elementTable) +
+                        MemoryUsage::getVectorBytes(_freeElementIds);
+}
+
 bool Document::validate(string* message) const
 {
+    ScopedTimer timer("Document::validate");
     bool res = true;
     validateRequire(hasVersionString(), res, message, "Missing version string");
     return Element::validate(message) && res;
@@ -340,6 +778,7 @@ bool Document::validate(string* message) const
 
 void Document::upgradeVersion()
 {
+    ScopedTimer timer("Document::upgradeVersion");
     std::pair<int, int> versions = getVersionIntegers();
     int majorVersion = versions.first;
     int minorVersion = versions.second;
@@ -489,7 +928,7 @@ void Document::upgradeVersion()
                     NodeDefPtr nodeDef = getNodeDef(shaderRef->getName());
                     if (nodeDef && !nodeDef->getNode().empty())
                     {
-                        replaceChild<ShaderRef>(mat, shaderRef, nodeDef->getNode());
+                        shaderRef->setName(nodeDef->getNode());
                     }
                 }
             }
@@ -528,7 +967,7 @@ void Document::upgradeVersion()
                     NodeDefPtr nodeDef = getNodeDef(shaderRef->getName());
                     if (nodeDef && !nodeDef->getNode().empty())
                     {
-                        replaceChild<ShaderRef>(mat, shaderRef, nodeDef->getNode());
+                        shaderRef->setName(nodeDef->getNode());
                     }
                 }
             }
@@ -573,24 +1012,82 @@ void Document::upgradeVersion()
     }
 }
 
+uint64_t Document::getRevision() const
+{
+    return _cache->revision.load(std::memory_order_relaxed);
+}
+
+ElementPtr Document::getElementById(size_t id) const
+{
+    if (id >= _elementTable.size())
+    {
+        return ElementPtr();
+    }
+    return _elementTable[id].lock();
+}
+
+size_t Document::acquireElementId(ElementPtr elem)
+{
+    if (_freeElementIds.empty())
+    {
+        _elementTable.push_back(elem);
+        return _elementTable.size() - 1;
+    }
+    size_t id = _freeElementIds.back();
+    _freeElementIds.pop_back();
+    _elementTable[id] = elem;
+    return id;
+}
+
+void Document::releaseElementId(size_t id)
+{
+    if (id < _elementTable.size())
+    {
+        _elementTable[id].reset();
+        _freeElementIds.push_back(id);
+    }
+}
+
 void Document::onAddElement(ElementPtr, ElementPtr)
 {
     _cache->valid = false;
+    _cache->revision++;
 }
 
 void Document::onRemoveElement(ElementPtr, ElementPtr)
 {
     _cache->valid = false;
+    _cache->revision++;
+}
+
+void Document::onRemoveElements(ElementPtr, const vector<ElementPtr>&)
+{
+    _cache->valid = false;
+    _cache->revision++;
+}
+
+void Document::onRenameElement(ElementPtr, const string&)
+{
+    _cache->valid = false;
+    _cache->revision++;
+}
+
+void Document::onMoveElement(ElementPtr, ElementPtr)
+{
+    _cache->valid = false;
+    _cache->revision++;
 }
 
 void Document::onSetAttribute(ElementPtr, const string&, const string&)
 {
     _cache->valid = false;
+    _cache->revision++;
 }
 
 void Document::onRemoveAttribute(ElementPtr, const string&)
 {
     _cache->valid = false;
+    _cache->revision++;
 }
 
 } // namespace MaterialX
@@ -15,11 +15,104 @@
 #include <MaterialXCore/Material.h>
 #include <MaterialXCore/Node.h>
 
+#include <map>
+
 namespace MaterialX
 {
 
 extern const string DOCUMENT_VERSION_STRING;
 
+/// @class MemoryUsage
+/// An estimate of the memory used by a Document, broken down by the kind of
+/// storage.
+///
+/// Container and string sizes are derived from their current capacities,
+/// while allocator overhead and per-node bookkeeping of the standard library
+/// are approximated.
+/// @sa Document::getMemoryUsage
+class MemoryUsage
+{
+  public:
+    MemoryUsage() :
+        elementCount(0),
+        elementBytes(0),
+        attributeBytes(0),
+        childContainerBytes(0),
+        cacheBytes(0),
+        stringBytes(0)
+    {
+    }
+    ~MemoryUsage() { }
+
+    /// Return the total estimated bytes across all kinds of storage.
+    size_t getTotalBytes() const
+    {
+        return elementBytes + attributeBytes + childContainerBytes + cacheBytes + stringBytes;
+    }
+
+    /// Return the total estimated bytes divided by the number of elements.
+    double getBytesPerElement() const
+    {
+        return elementCount ? (double) getTotalBytes() / elementCount : 0.0;
+    }
+
+    /// @name Estimation Helpers
+    /// Helpers for the estimates made by Element::addMemoryUsage.
+    /// @{
+
+    /// Return the heap bytes used by the character data of the given string,
+    /// which are zero for strings stored inline by the small string
+    /// optimization.
+    static size_t getStringBytes(const string& str);
+
+    /// Return the bytes used by the buckets and nodes of the given hash map,
+    /// excluding any heap data owned by its keys and values.
+    template<class M> static size_t getHashMapBytes(const M& map)
+    {
+        size_t nodeBytes = sizeof(typename M::value_type) + sizeof(void*) + sizeof(size_t);
+        return map.bucket_count() * sizeof(void*) + map.size() * nodeBytes;
+    }
+
+    /// Return the bytes used by the storage of the given vector, excluding
+    /// any heap data owned by its items.
+    template<class T> static size_t getVectorBytes(const vector<T>& vec)
+    {
+        return vec.capacity() * sizeof(T);
+    }
+
+    /// @}
+
+  public:
+    /// The number of elements in the document, including the document itself.
+    size_t elementCount;
+
+    /// The number of elements of each category.
+    std::map<string, size_t> categoryCounts;
+
+    /// The bytes owned by elements of each category, excluding cached data.
+    std::map<string, size_t> categoryBytes;
+
+    /// The bytes used by element objects and their shared pointer control
+    /// blocks.
+    size_t elementBytes;
+
+    /// The bytes used by attribute maps and attribute order vectors.
+    size_t attributeBytes;
+
+    /// The bytes used by child maps and child order vectors, and by the
+    /// lists of libraries referenced by documents.
+    size_t childContainerBytes;
+
+    /// The bytes used by cached data, including the lookup maps of the
+    /// document cache, the element id table, and the memoized resolutions
+    /// of materials.
+    size_t cacheBytes;
+
+    /// The heap bytes used by the character data of element names,
+    /// categories, source URIs and attributes.
+    size_t stringBytes;
+};
+
 /// A shared pointer to a Document
 using DocumentPtr = shared_ptr<class Document>;
 /// A shared pointer to a const Document
@@ -30,7 +123,7 @@ using ConstDocumentPtr = shared_ptr<const class Document>;
 /// MaterialX ownership hierarchy.
 ///
 /// Use the factory function createDocument() to create a Document instance.
-class Document : public Element
+class Document : public ConcreteElement<Document, Element>
 {
   public:
     Document(ElementPtr parent, const string& name);
@@ -52,6 +145,10 @@ class Document : public Element
     {
         DocumentPtr doc = createDocument<Document>();
         doc->copyContentFrom(getSelf(), true);
+        for (ConstDocumentPtr library : _libraries)
+        {
+            doc->addReferencedLibrary(library);
+        }
         return doc;
     }
 
@@ -59,8 +156,54 @@ class Document : public Element
     /// The contents of the library document are copied into this one, and
     /// are assigned the source URI of the library.
     /// @param library The library document to be imported.
+    /// @sa addReferencedLibrary
     void importLibrary(ConstDocumentPtr library);
 
+    /// @name Library References
+    /// @{
+
+    /// Add a reference to the given library document, making its contents
+    /// available to this document without copying them.
+    ///
+    /// A single library may be referenced by any number of documents, and
+    /// the elements of a referenced library remain owned by the library.
+    /// Name lookups of nodedefs and implementations, nodedef and
+    /// implementation matching, and traverseTreeWithLibraries consult the
+    /// referenced libraries after the contents of this document, including
+    /// the libraries that they reference in turn.  Referenced libraries are
+    /// written as XIncludes of their source URIs.
+    ///
+    /// Libraries are intended to be treated as read-only while referenced,
+    /// since edits to their contents may affect all referencing documents.
+    /// @param library The library document to be referenced.
+    /// @throws Exception if the library is this document, or if it
+    ///    references this document.
+    void addReferencedLibrary(ConstDocumentPtr library);
+
+    /// Remove the reference, if any, to the given library document.
+    void removeReferencedLibrary(ConstDocumentPtr library);
+
+    /// Return true if this document references any library documents.
+    bool hasReferencedLibraries() const
+    {
+        return !_libraries.empty();
+    }
+
+    /// Return the library documents directly referenced by this document,
+    /// in the order in which they were added.
+    const vector<ConstDocumentPtr>& getReferencedLibraries() const
+    {
+        return _libraries;
+    }
+
+    /// Traverse the tree of this document, followed by the tree of each
+    /// library that it references, directly or indirectly.  Each library is
+    /// visited once, and the root of each tree has a depth of zero.
+    /// @sa Element::traverseTree
+    TreeIterator traverseTreeWithLibraries() const;
+
+    /// @}
+
     /// @name Document Versions
     /// @{
 
@@ -158,6 +301,20 @@ class Document : public Element
         removeChildOfType<Material>(name);
     }
 
+    /// Return the resolved content of every Material in the document, in
+    /// document order.  Materials that are inherited by several others are
+    /// resolved only once.
+    /// @sa Material::getResolvedMaterial
+    vector<ResolvedMaterialPtr> getResolvedMaterials() const
+    {
+        vector<ResolvedMaterialPtr> resolved;
+        for (MaterialPtr material : getMaterials())
+        {
+            resolved.push_back(material->getResolvedMaterial());
+        }
+        return resolved;
+    }
+
     /// @}
     /// @name GeomInfo Elements
     /// @{
@@ -313,10 +470,11 @@ class Document : public Element
         return child;
     }
 
-    /// Return the NodeDef, if any, with the given name.
+    /// Return the NodeDef, if any, with the given name, searching the
+    /// referenced libraries if this document has no such NodeDef.
     NodeDefPtr getNodeDef(const string& name) const
     {
-        return getChildOfType<NodeDef>(name);
+        return getChildOfTypeWithLibraries<NodeDef>(name);
     }
 
     /// Return a vector of all NodeDef elements in the document.
@@ -331,14 +489,58 @@ class Document : public Element
         removeChildOfType<NodeDef>(name);
     }
 
-    /// Return a vector of all NodeDef elements that match the given node name.
+    /// Return a vector of all NodeDef elements that match the given node name,
+    /// including those of referenced libraries.
     vector<NodeDefPtr> getMatchingNodeDefs(const string& nodeName) const;
 
+    /// Return the NodeDef, if any, that the given node references.
+    ///
+    /// Candidate nodedefs are indexed by node category and output type, and
+    /// the first candidate whose input types are compatible with those of
+    /// the node is selected.  Results are memoized by node signature, the
+    /// combination of the node's category, type, and input names and types,
+    /// so that nodes sharing a signature are resolved in constant time.
+    /// @sa Node::getReferencedNodeDef
+    NodeDefPtr getNodeDefForNode(const Node& node) const;
+
+    /// Return the NodeDef referenced by each of the given nodes, refreshing
+    /// the document cache at most once for the batch.  Entries for nodes
+    /// without a matching NodeDef are empty.
+    vector<NodeDefPtr> getNodeDefsForNodes(const vector<NodePtr>& nodes) const;
+
     /// Return a vector of all node implementations that match the given
-    /// NodeDef string.  Note that a node implementation may be either an
+    /// NodeDef string, in document order, followed by those of referenced
+    /// libraries.  Note that a node implementation may be either an
     /// Implementation element or NodeGraph element.
     vector<ElementPtr> getMatchingImplementations(const string& nodeDef) const;
 
+    /// Return the implementation, if any, of the NodeDef that the given node
+    /// references, for the given target and language.
+    ///
+    /// An implementation with a target string is selected only for that
+    /// target, and is preferred over a generic implementation with no
+    /// target.  When a language is given, an Implementation element with a
+    /// different language is never selected, and one with a matching
+    /// language is preferred over one with no language.  Node graphs carry
+    /// no language, so they are selected for any language.  Remaining ties
+    /// are broken by document order.  Results are memoized by NodeDef,
+    /// target and language.
+    /// @param node The node whose implementation is requested.
+    /// @param target An optional target string.
+    /// @param language An optional language string.
+    /// @sa Node::getImplementation
+    ElementPtr getImplementationForNode(const Node& node,
+                                        const string& target = EMPTY_STRING,
+                                        const string& language = EMPTY_STRING) const;
+
+    /// Return the implementation of each of the given nodes for the given
+    /// target and language, refreshing the document cache at most once for
+    /// the batch.  Entries for nodes without an implementation are empty.
+    /// @sa getImplementationForNode
+    vector<ElementPtr> getImplementationsForNodes(const vector<NodePtr>& nodes,
+                                                  const string& target = EMPTY_STRING,
+                                                  const string& language = EMPTY_STRING) const;
+
     /// @}
     /// @name PropertySet Elements
     /// @{
@@ -385,10 +587,11 @@ class Document : public Element
         return addChild<Implementation>(name);
     }
 
-    /// Return the Implementation, if any, with the given name.
+    /// Return the Implementation, if any, with the given name, searching the
+    /// referenced libraries if this document has no such Implementation.
     ImplementationPtr getImplementation(const string& name) const
     {
-        return getChildOfType<Implementation>(name);
+        return getChildOfTypeWithLibraries<Implementation>(name);
     }
 
     /// Return a vector of all Implementation elements in the document.
@@ -414,6 +617,10 @@ class Document : public Element
     /// Return a vector of all elements with the given public name.
     vector<ElementPtr> getPublicElements(const string& publicName) const;
 
+    /// Return a vector of all value elements with public names, in
+    /// arbitrary order.
+    vector<ValueElementPtr> getAllPublicElements() const;
+
     /// @}
     /// @name Require String
     /// @{
@@ -498,6 +705,45 @@ class Document : public Element
     string applyStringSubstitutions(const string& filename,
                                     const string& geom = UNIVERSAL_GEOM_NAME) const;
 
+    /// @}
+    /// @name Revision
+    /// @{
+
+    /// Return the revision number of this document, which is incremented
+    /// by every addition or removal of an element and every change to an
+    /// attribute.  Derived data may be tagged with the revision at which
+    /// it was computed, and reused while the revision is unchanged.
+    uint64_t getRevision() const;
+
+    /// @}
+    /// @name Element Ids
+    /// @{
+
+    /// Return the element of this document with the given id, or an empty
+    /// shared pointer if no element currently holds the id.
+    /// @sa Element::getId
+    ElementPtr getElementById(size_t id) const;
+
+    /// Return an upper bound on the ids of the elements in this document, so
+    /// that an array of this size may be indexed by element id.
+    size_t getElementIdBound() const
+    {
+        return _elementTable.size();
+    }
+
+    /// @}
+    /// @name Memory Usage
+    /// @{
+
+    /// Return an estimate of the memory used by this document, computed by
+    /// a traversal of the document tree and its cache.
+    MemoryUsage getMemoryUsage() const;
+
+    /// Add an estimate of the memory owned by the document element, its
+    /// cache, its element id table and its list of referenced libraries to
+    /// the given usage.
+    void addMemoryUsage(MemoryUsage& usage) const override;
+
     /// @}
     /// @name Validation
     /// @{
@@ -521,6 +767,16 @@ class Document : public Element
     /// Called when an element is removed from the element tree.
     virtual void onRemoveElement(ElementPtr parent, ElementPtr elem);
 
+    /// Called when a set of child elements is removed from the element tree
+    /// in a single operation.
+    virtual void onRemoveElements(ElementPtr parent, const vector<ElementPtr>& elems);
+
+    /// Called when an element is given a new name.
+    virtual void onRenameElement(ElementPtr elem, const string& name);
+
+    /// Called when an element is moved to a new parent element.
+    virtual void onMoveElement(ElementPtr elem, ElementPtr parent);
+
     /// Called when an attribute of an element is set to a new value.
     virtual void onSetAttribute(ElementPtr elem, const string& attrib, const string& value);
 
@@ -555,8 +811,32 @@ class Document : public Element
     static const string REQUIRE_STRING_OVERRIDE;
 
   private:
+    template <class T> shared_ptr<T> getChildOfTypeWithLibraries(const string& name) const
+    {
+        shared_ptr<T> child = getChildOfType<T>(name);
+        for (size_t i = 0; !child && i < _libraries.size(); i++)
+        {
+            child = _libraries[i]->getChildOfTypeWithLibraries<T>(name);
+        }
+        return child;
+    }
+
+    // Enter the given element into the id table, reusing a free id where
+    // available, and return its id.  Releasing an id clears its entry and
+    // frees it for reuse.
+    size_t acquireElementId(ElementPtr elem);
+    void releaseElementId(size_t id);
+
+  private:
+    friend class Element;
+
     class Cache;
     std::unique_ptr<Cache> _cache;
+    vector<ConstDocumentPtr> _libraries;
+
+    // The element holding each id, along with the ids that are free for reuse.
+    vector<weak_ptr<Element>> _elementTable;
+    vector<size_t> _freeElementIds;
 };
 
 /// @class @ScopedUpdate
@@ -12,9 +12,14 @@
 #include <MaterialXCore/Node.h>
 #include <MaterialXCore/Util.h>
 
+#include <algorithm>
+#include <limits>
+
 namespace MaterialX
 {
 
+const size_t Element::INVALID_ID = std::numeric_limits<size_t>::max();
+
 const string Element::TYPE_ATTRIBUTE = "type";
 const string Element::FILE_PREFIX_ATTRIBUTE = "fileprefix";
 const string Element::GEOM_PREFIX_ATTRIBUTE = "geomprefix";
@@ -27,6 +32,41 @@ const string ValueElement::IMPLEMENTATION_NAME_ATTRIBUTE = "implname";
 
 Element::CreatorMap Element::_creatorMap;
 
+namespace {
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+// The approximate size of the shared pointer control block that make_shared
+// allocates along with each element, holding a vtable pointer along with use
+// and weak counts.
+const size_t SHARED_CONTROL_BLOCK_BYTES = sizeof(void*) + 2 * sizeof(long);
+
+// The maximum number of digits parsed as the numeric suffix of a name.
+const size_t MAX_NAME_SUFFIX_DIGITS = 9;
+
+// Combine the given bytes into a running FNV-1a hash.
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+// Combine the given string into a running hash, prefixed by its length so
+// that adjacent strings cannot alias one another.
+uint64_t hashString(uint64_t hash, const string& str)
+{
+    uint64_t size = str.size();
+    hash = hashBytes(hash, &size, sizeof(size));
+    return hashBytes(hash, str.data(), str.size());
+}
+
+} // anonymous namespace
+
 //
 // Element methods
 //
@@ -39,6 +79,12 @@ bool Element::operator==(const Element& rhs) const
         return false;
     }
 
+    // Compare content hashes, which are cached across comparisons.
+    if (this == &rhs)
+        return true;
+    if (getContentHash() != rhs.getContentHash())
+        return false;
+
     // Compare attributes.
     if (getAttributeNames() != rhs.getAttributeNames())
         return false;
@@ -66,6 +112,49 @@ bool Element::operator!=(const Element& rhs) const
     return !(*this == rhs);
 }
 
+uint64_t Element::getContentHash(bool includeName) const
+{
+    // The cached hash leaves out the name of this element, which is combined
+    // on request, so that a single cache serves both forms of the hash.
+    uint64_t hash = _contentHash.load(std::memory_order_relaxed);
+    if (!hash)
+    {
+        hash = hashString(FNV_OFFSET_BASIS, _category);
+        uint64_t attributeCount = _attributeOrder.size();
+        hash = hashBytes(hash, &attributeCount, sizeof(attributeCount));
+        for (const string& attr : _attributeOrder)
+        {
+            hash = hashString(hash, attr);
+            hash = hashString(hash, _attributeMap.at(attr));
+        }
+        for (ElementPtr child : _childOrder)
+        {
+            uint64_t childHash = child->getContentHash();
+            hash = hashBytes(hash, &childHash, sizeof(childHash));
+        }
+
+        // Reserve zero to denote an invalid cache.
+        if (!hash)
+        {
+            hash = 1;
+        }
+        _contentHash.store(hash, std::memory_order_relaxed);
+    }
+    return includeName ? hashString(hash, _name) : hash;
+}
+
+void Element::invalidateAncestorContentHashes()
+{
+    // A valid hash implies valid hashes for all descendants, so the walk
+    // stops at the first ancestor whose hash is already invalid.
+    Element* elem = this;
+    while (elem && elem->_contentHash.exchange(0, std::memory_order_relaxed))
+    {
+        ElementPtr parent = elem->_parent.lock();
+        elem = parent.get();
+    }
+}
+
 string Element::getNamePath(ConstElementPtr relativeTo) const
 {
     if (!relativeTo)
@@ -85,16 +174,133 @@ string Element::getNamePath(ConstElementPtr relativeTo) const
     return res;
 }
 
+void Element::setName(const string& name, bool updateConnections)
+{
+    if (name == _name)
+    {
+        return;
+    }
+
+    if (!isValidName(name))
+    {
+        throw Exception("Invalid element name: " + name);
+    }
+    ElementPtr parent = getParent();
+    if (parent && parent->_childMap.count(name))
+    {
+        throw Exception("Child name is not unique: " + name);
+    }
+
+    DocumentPtr doc = getDocument();
+
+    // Find connected ports while they still resolve to this element.
+    vector<PortElementPtr> connectedPorts;
+    if (updateConnections && isA<Node>())
+    {
+        for (PortElementPtr port : doc->getMatchingPorts(_name))
+        {
+            if (port->getConnectedNode() == getSelf())
+            {
+                connectedPorts.push_back(port);
+            }
+        }
+    }
+
+    // Handle change notifications.
+    ScopedUpdate update(doc);
+    doc->onRenameElement(getSelf(), name);
+
+    // The cached hash of this element leaves out its own name, so only the
+    // hashes of its ancestors are affected.
+    if (parent)
+    {
+        parent->_childMap.erase(_name);
+        parent->_childMap[name] = getSelf();
+        parent->invalidateContentHash();
+    }
+    _name = name;
+
+    for (PortElementPtr port : connectedPorts)
+    {
+        port->setNodeName(name);
+    }
+}
+
+void Element::moveTo(ElementPtr parent, int index)
+{
+    ElementPtr oldParent = getParent();
+    if (!oldParent)
+    {
+        throw Exception("Cannot move the root element: " + getName());
+    }
+    if (oldParent->getChild(_name) != getSelf())
+    {
+        throw Exception("Cannot move an element that has been removed: " + getName());
+    }
+    if (!parent || parent->getRoot() != getRoot())
+    {
+        throw Exception("Cannot move an element between documents: " + getNamePath());
+    }
+    for (ElementPtr elem = parent; elem; elem = elem->getParent())
+    {
+        if (elem == getSelf())
+        {
+            throw Exception("Cannot move an element within its own subtree: " + getNamePath());
+        }
+    }
+
+    if (parent == oldParent)
+    {
+        parent->setChildIndex(_name, index < 0 ? (int) parent->_childOrder.size() : index);
+        return;
+    }
+    if (parent->_childMap.count(_name))
+    {
+        throw Exception("Child name is not unique: " + _name);
+    }
+    if (index > (int) parent->_childOrder.size())
+    {
+        throw Exception("Invalid child index");
+    }
+
+    DocumentPtr doc = getDocument();
+
+    // Handle change notifications.
+    ScopedUpdate update(doc);
+    doc->onMoveElement(getSelf(), parent);
+
+    ElementPtr self = getSelf();
+    oldParent->unlinkChildElement(self);
+    parent->linkChildElement(self, index < 0 ? parent->_childOrder.size() : (size_t) index);
+    _parent = parent;
+
+    // Elements moved into or out of a removed subtree gain or lose their ids.
+    if (parent->_id == INVALID_ID)
+    {
+        releaseElementIds(*doc);
+    }
+    else if (_id == INVALID_ID)
+    {
+        acquireElementIds(*doc);
+    }
+}
+
 void Element::registerChildElement(ElementPtr child)
 {
     DocumentPtr doc = getDocument();
 
+    // Only elements within the document tree hold ids, so that the table of
+    // the document never refers to elements that it does not own.
+    if (_id != INVALID_ID)
+    {
+        child->_id = doc->acquireElementId(child);
+    }
+
     // Handle change notifications.
     ScopedUpdate update(doc);
     doc->onAddElement(getSelf(), child);
 
-    _childMap[child->getName()] = child;
-    _childOrder.push_back(child);
+    linkChildElement(child, _childOrder.size());
 }
 
 void Element::unregisterChildElement(ElementPtr child)
@@ -105,27 +311,114 @@ void Element::unregisterChildElement(ElementPtr child)
     ScopedUpdate update(doc);
     doc->onRemoveElement(getSelf(), child);
 
+    unlinkChildElement(child);
+    child->releaseElementIds(*doc);
+}
+
+void Element::unregisterChildElements(const vector<ElementPtr>& children)
+{
+    if (children.empty())
+    {
+        return;
+    }
+
+    DocumentPtr doc = getDocument();
+
+    // Handle change notifications.
+    ScopedUpdate update(doc);
+    doc->onRemoveElements(getSelf(), children);
+
+    // Compact the child order in a single pass, skipping each removed child
+    // and renumbering the children that remain.
+    for (ElementPtr child : children)
+    {
+        _childMap.erase(child->getName());
+        _childOrder[child->_childIndex].reset();
+    }
+    size_t count = 0;
+    for (ElementPtr& child : _childOrder)
+    {
+        if (child)
+        {
+            child->_childIndex = count;
+            _childOrder[count++].swap(child);
+        }
+    }
+    _childOrder.resize(count);
+    for (ElementPtr child : children)
+    {
+        childElementRemoved(child);
+        child->releaseElementIds(*doc);
+    }
+    invalidateContentHash();
+}
+
+void Element::linkChildElement(ElementPtr child, size_t index)
+{
+    _childMap[child->getName()] = child;
+    _childOrder.insert(_childOrder.begin() + index, child);
+    for (size_t i = index; i < _childOrder.size(); i++)
+    {
+        _childOrder[i]->_childIndex = i;
+    }
+    childElementAdded(child);
+    invalidateContentHash();
+}
+
+void Element::unlinkChildElement(ElementPtr child)
+{
+    // The stored index locates the child without a search, and only the
+    // children that follow it need to be renumbered.
+    size_t index = child->_childIndex;
     _childMap.erase(child->getName());
-    _childOrder.erase(
-        std::find(_childOrder.begin(), _childOrder.end(), child));
+    _childOrder.erase(_childOrder.begin() + index);
+    for (size_t i = index; i < _childOrder.size(); i++)
+    {
+        _childOrder[i]->_childIndex = i;
+    }
+    childElementRemoved(child);
+    invalidateContentHash();
+}
+
+void Element::acquireElementIds(Document& doc)
+{
+    if (_id == INVALID_ID)
+    {
+        _id = doc.acquireElementId(getSelf());
+    }
+    for (ElementPtr child : _childOrder)
+    {
+        child->acquireElementIds(doc);
+    }
+}
+
+void Element::releaseElementIds(Document& doc)
+{
+    if (_id != INVALID_ID)
+    {
+        doc.releaseElementId(_id);
+        _id = INVALID_ID;
+    }
+    for (ElementPtr child : _childOrder)
+    {
+        child->releaseElementIds(doc);
+    }
 }
 
 int Element::getChildIndex(const string& name) const
 {
     ElementPtr child = getChild(name);
-    vector<ElementPtr>::const_iterator it = std::find(_childOrder.begin(), _childOrder.end(), child);
-    if (it == _childOrder.end())
+    if (!child)
     {
         return -1;
     }
-    return (int) std::distance(_childOrder.begin(), it);
+    return (int) child->_childIndex;
 }
 
 void Element::setChildIndex(const string& name, int index)
 {
     ElementPtr child = getChild(name);
-    vector<ElementPtr>::iterator it = std::find(_childOrder.begin(), _childOrder.end(), child);
-    if (it == _childOrder.end())
+    if (!child)
     {
         return;
     }
@@ -135,8 +428,21 @@ void Element::setChildIndex(const string& name, int index)
         throw Exception("Invalid child index");
     }
 
-    _childOrder.erase(it);
-    _childOrder.insert(_childOrder.begin() + (size_t) index, child);
+    size_t oldIndex = child->_childIndex;
+    size_t newIndex = std::min((size_t) index, _childOrder.size() - 1);
+    if (newIndex < oldIndex)
+    {
+        std::rotate(_childOrder.begin() + newIndex, _childOrder.begin() + oldIndex, _childOrder.begin() + oldIndex + 1);
+    }
+    else
+    {
+        std::rotate(_childOrder.begin() + oldIndex, _childOrder.begin() + oldIndex + 1, _childOrder.begin() + newIndex + 1);
+    }
+    for (size_t i = std::min(oldIndex, newIndex); i <= std::max(oldIndex, newIndex); i++)
+    {
+        _childOrder[i]->_childIndex = i;
+    }
+    invalidateContentHash();
 }
 
 void Element::removeChild(const string& name)
@@ -150,6 +456,20 @@ void Element::removeChild(const string& name)
     unregisterChildElement(it->second);
 }
 
+size_t Element::removeChildren(const ElementPredicate& predicate)
+{
+    vector<ElementPtr> children;
+    for (ElementPtr child : _childOrder)
+    {
+        if (predicate(child))
+        {
+            children.push_back(child);
+        }
+    }
+    unregisterChildElements(children);
+    return children.size();
+}
+
 void Element::setAttribute(const string& attrib, const string& value)
 {
     DocumentPtr doc = getDocument();
@@ -163,6 +483,7 @@ void Element::setAttribute(const string& attrib, const string& value)
         _attributeOrder.push_back(attrib);
     }
     _attributeMap[attrib] = value;
+    invalidateContentHash();
 }
 
 void Element::removeAttribute(const string& attrib)
@@ -179,6 +500,7 @@ void Element::removeAttribute(const string& attrib)
         _attributeMap.erase(it);
         _attributeOrder.erase(
             std::find(_attributeOrder.begin(), _attributeOrder.end(), attrib));
+        invalidateContentHash();
     }
 }
 
@@ -294,15 +616,47 @@ void Element::clearContent()
 {
     _sourceUri = EMPTY_STRING;
     vector<string> attributeNames = getAttributeNames();
-    vector<ElementPtr> children = getChildren();
     for (const string& attr : attributeNames)
     {
         removeAttribute(attr);
     }
-    for (ElementPtr child : children)
+    removeChildren([](ElementPtr) { return true; });
+    _nameCounters.reset();
+}
+
+string Element::createValidChildName(string name)
+{
+    name = createValidName(name);
+    if (!_childMap.count(name))
     {
-        removeChild(child->getName());
+        return name;
     }
+
+    // Split the name into a prefix and a numeric suffix, treating names
+    // without a suffix as having an implicit suffix of one.
+    size_t split = name.length();
+    while (split > 0 && isdigit(name[split - 1]) && name.length() - split < MAX_NAME_SUFFIX_DIGITS)
+    {
+        split--;
+    }
+    size_t suffix = (split < name.length()) ? (size_t) std::stoull(name.substr(split)) : 1;
+    name.resize(split);
+
+    if (!_nameCounters)
+    {
+        _nameCounters.reset(new std::unordered_map<string, size_t>());
+    }
+    size_t& counter = (*_nameCounters)[name];
+    counter = std::max(counter, suffix + 1);
+
+    // The counter is left at the returned suffix, which is skipped by the
+    // next request once a child takes that name.
+    string candidate = name + std::to_string(counter);
+    while (_childMap.count(candidate))
+    {
+        candidate = name + std::to_string(++counter);
+    }
+    return candidate;
 }
 
 bool Element::validate(string* message) const
@@ -331,6 +685,42 @@ string Element::asString() const
     return res;
 }
 
+void Element::addMemoryUsage(MemoryUsage& usage) const
+{
+    usage.elementBytes += getObjectSize() + SHARED_CONTROL_BLOCK_BYTES;
+
+    usage.attributeBytes += MemoryUsage::getHashMapBytes(_attributeMap) +
+                            MemoryUsage::getVectorBytes(_attributeOrder);
+    usage.childContainerBytes += MemoryUsage::getHashMapBytes(_childMap) +
+                                 MemoryUsage::getVectorBytes(_childOrder);
+
+    usage.stringBytes += MemoryUsage::getStringBytes(_category) +
+                         MemoryUsage::getStringBytes(_name) +
+                         MemoryUsage::getStringBytes(_sourceUri);
+    for (const auto& pair : _attributeMap)
+    {
+        usage.stringBytes += MemoryUsage::getStringBytes(pair.first) +
+                             MemoryUsage::getStringBytes(pair.second);
+    }
+    for (const string& attrName : _attributeOrder)
+    {
+        usage.stringBytes += MemoryUsage::getStringBytes(attrName);
+    }
+    for (const auto& pair : _childMap)
+    {
+        usage.stringBytes += MemoryUsage::getStringBytes(pair.first);
+    }
+
+    if (_nameCounters)
+    {
+        usage.childContainerBytes += sizeof(*_nameCounters) + MemoryUsage::getHashMapBytes(*_nameCounters);
+        for (const auto& pair : *_nameCounters)
+        {
+            usage.stringBytes += MemoryUsage::getStringBytes(pair.first);
+        }
+    }
+}
+
 void Element::validateRequire(bool expression, bool& res, string* message, string errorDesc) const
 {
     if (!expression)
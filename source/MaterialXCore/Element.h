@@ -15,6 +15,10 @@
 #include <MaterialXCore/Util.h>
 #include <MaterialXCore/Value.h>
 
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+
 namespace MaterialX
 {
 
@@ -39,6 +43,10 @@ using ElementMap = std::unordered_map<string, ElementPtr>;
 /// A standard function taking an ElementPtr and returning a boolean.
 using ElementPredicate = std::function<bool(ElementPtr)>;
 
+class MemoryUsage;
+
+template <class T> class ChildView;
+
 /// @class Element
 /// The base class for MaterialX elements.
 ///
@@ -51,7 +59,10 @@ class Element : public enable_shared_from_this<Element>
         _category(category),
         _name(name),
         _parent(parent),
-        _root(parent ? parent->getRoot() : nullptr)
+        _root(parent ? parent->getRoot() : nullptr),
+        _id(INVALID_ID),
+        _childIndex(0),
+        _contentHash(0)
     {
     }
   public:
@@ -66,13 +77,34 @@ class Element : public enable_shared_from_this<Element>
 
   public:
     /// Return true if the given element tree, including all descendants,
-    /// is identical to this one.
+    /// is identical to this one.  Trees whose content hashes differ are
+    /// rejected without a full comparison.
     bool operator==(const Element& rhs) const;
 
     /// Return true if the given element tree, including all descendants,
     /// differs from this one.
     bool operator!=(const Element& rhs) const;
 
+    /// @name Content Hash
+    /// @{
+
+    /// Return a 64-bit hash of the structural content of this element tree,
+    /// covering the same categories, names, attributes and children that are
+    /// compared by operator==.  Equal trees have equal hashes, across
+    /// documents and across runs of the library.
+    ///
+    /// The hash of each element is cached, and combines the cached hashes
+    /// of its children, so that after a modification only the hashes of the
+    /// modified element and its ancestors are recomputed.
+    ///
+    /// @param includeName If false, then the name of this element is left
+    ///    out of the hash, while the names of its descendants are still
+    ///    covered, so that identical trees under different names, such as
+    ///    duplicated node graphs, have equal hashes.  Defaults to true.
+    uint64_t getContentHash(bool includeName = true) const;
+
+    /// @}
+
     /// @name Category
     /// @{
 
@@ -80,6 +112,7 @@ class Element : public enable_shared_from_this<Element>
     void setCategory(const string& category)
     {
         _category = category;
+        invalidateContentHash();
     }
 
     /// Return the element's category string.  The category of a MaterialX
@@ -94,15 +127,38 @@ class Element : public enable_shared_from_this<Element>
     /// @name Name
     /// @{
 
+    /// Set the element's name string.
+    /// If the given name is not a valid MaterialX name, or if the parent of
+    /// the element already has a child with the given name, then an
+    /// exception is thrown.
+    /// @param name The new name of the element.
+    /// @param updateConnections If true, and this element is a node, then
+    ///    the ports connected to the node are updated to reference its new
+    ///    name.  Defaults to false.
+    void setName(const string& name, bool updateConnections = false);
+
     /// Return the element's name string.  The name of a MaterialX element
-    /// must be unique among all elements at the same scope, and cannot be
-    /// modified after the element is created.
+    /// must be unique among all elements at the same scope.
     /// @todo The MaterialX notion of namespaces is not yet supported.
     const string& getName() const
     {
         return _name;
     }
 
+    /// Return the element's id, an integer that is unique among the elements
+    /// of its document and remains stable while the element belongs to it.
+    ///
+    /// The ids of removed elements are reused by elements added later, so
+    /// ids remain dense, and data for the elements of a document may be
+    /// stored in arrays indexed by id.  An element outside the tree of its
+    /// document, such as a removed element or a child added to a removed
+    /// element, has the id INVALID_ID.
+    /// @sa Document::getElementById
+    size_t getId() const
+    {
+        return _id;
+    }
+
     /// Return the element's hierarchical name path, relative to the root
     /// document.  The name of each ancestor will be prepended in turn,
     /// separated by forward slashes.
@@ -305,6 +361,14 @@ class Element : public enable_shared_from_this<Element>
         return children;
     }
 
+    /// Return a view of all child elements that are instances of the given
+    /// type, which iterates over them in the order in which they were added.
+    ///
+    /// Unlike getChildrenOfType, the view is evaluated lazily and performs no
+    /// allocations, so it is suited to inner loops.  The view is invalidated
+    /// when children are added to or removed from this element.
+    template<class T> ChildView<T> childrenOfType(const string& category = EMPTY_STRING) const;
+
     /// Set the index of the child, if any, with the given name.
     /// If the given index is out of bounds, then an exception is thrown.
     void setChildIndex(const string& name, int index);
@@ -316,6 +380,15 @@ class Element : public enable_shared_from_this<Element>
     /// Remove the child element, if any, with the given name.
     void removeChild(const string& name);
 
+    /// Remove all child elements for which the given predicate returns true.
+    ///
+    /// The remaining children keep their relative order, and the removal is
+    /// reported to the document as a single batch, so removing many children
+    /// takes time proportional to the number of children rather than to its
+    /// square.
+    /// @return The number of children that were removed.
+    size_t removeChildren(const ElementPredicate& predicate);
+
     /// Remove the child element, if any, with the given name and subclass.
     /// If a child with the given name exists, but belongs to a different
     /// subclass, then this method has no effect.
@@ -403,6 +476,18 @@ class Element : public enable_shared_from_this<Element>
         return _parent.lock();
     }
 
+    /// Move this element and its descendants to the given parent element,
+    /// which must belong to the same document.  The subtree is relinked
+    /// rather than copied, so existing pointers to its elements remain valid.
+    /// @param parent The new parent of this element.
+    /// @param index The index of this element among the children of its new
+    ///    parent.  If negative, then the element is placed after all existing
+    ///    children.
+    /// @throws Exception If the move would create a cycle, the new parent
+    ///    already has a child with this element's name, or the index is out
+    ///    of bounds.
+    void moveTo(ElementPtr parent, int index = -1);
+
     /// Return the root element of our tree.
     ElementPtr getRoot();
 
@@ -557,21 +642,36 @@ class Element : public enable_shared_from_this<Element>
 
     /// Using the input name as a starting point, modify it to create a valid,
     /// unique name for a child element.
-    string createValidChildName(string name)
-    {
-        name = createValidName(name);
-        while (_childMap.count(name))
-        {
-            name = incrementName(name);
-        }
-        return name;
-    }
+    ///
+    /// If the name is taken, its numeric suffix is incremented until a free
+    /// name is found.  The next suffix to try is remembered for each prefix,
+    /// so that generating many names from one prefix takes constant time per
+    /// name, and suffixes freed by removed children are not reused until
+    /// all children are cleared.
+    string createValidChildName(string name);
 
     /// Return a single-line description of this element, including its category,
     /// name, type, and value.
     string asString() const;
 
     /// @}
+    /// @name Memory Usage
+    /// @{
+
+    /// Add an estimate of the memory owned by this element, excluding its
+    /// child elements, to the given usage.  Subclasses that own additional
+    /// heap data override this method, calling the base implementation.
+    /// @sa Document::getMemoryUsage
+    virtual void addMemoryUsage(MemoryUsage& usage) const;
+
+    /// Return the size in bytes of this element object.  Concrete subclasses
+    /// derive from ConcreteElement, which returns the size of the subclass.
+    virtual size_t getObjectSize() const
+    {
+        return sizeof(Element);
+    }
+
+    /// @}
 
   protected:
     // Enforce a requirement within a validate method, updating the validation
@@ -579,6 +679,8 @@ class Element : public enable_shared_from_this<Element>
     void validateRequire(bool expression, bool& res, string* message, string errorDesc) const;
 
   public:
+    static const size_t INVALID_ID;
+
     static const string TYPE_ATTRIBUTE;
     static const string FILE_PREFIX_ATTRIBUTE;
     static const string GEOM_PREFIX_ATTRIBUTE;
@@ -586,8 +688,23 @@ class Element : public enable_shared_from_this<Element>
     static const string TARGET_ATTRIBUTE;
 
   protected:
-    virtual void registerChildElement(ElementPtr child);
-    virtual void unregisterChildElement(ElementPtr child);
+    void registerChildElement(ElementPtr child);
+    void unregisterChildElement(ElementPtr child);
+    void unregisterChildElements(const vector<ElementPtr>& children);
+
+    // Called when a child element is linked to or unlinked from this element,
+    // whether it is being added, removed, or moved between parents.
+    virtual void childElementAdded(ElementPtr) { }
+    virtual void childElementRemoved(ElementPtr) { }
+
+    // Invalidate the cached content hash of this element and its ancestors.
+    void invalidateContentHash()
+    {
+        if (_contentHash.load(std::memory_order_relaxed))
+        {
+            invalidateAncestorContentHashes();
+        }
+    }
 
   protected:
     string _category;
@@ -603,6 +720,34 @@ class Element : public enable_shared_from_this<Element>
     weak_ptr<Element> _parent;
     weak_ptr<Element> _root;
 
+    // The id of this element within its document, or INVALID_ID if the
+    // element has been removed from its document.
+    size_t _id;
+
+  private:
+    void invalidateAncestorContentHashes();
+
+    // Assign ids to this element and its descendants as they are attached
+    // to the given document, or release their ids as they are detached.
+    // Elements that already hold ids, or hold none, are left unchanged.
+    void acquireElementIds(Document& doc);
+    void releaseElementIds(Document& doc);
+
+    // Link a child element at the given index, or unlink it, without
+    // change notifications.
+    void linkChildElement(ElementPtr child, size_t index);
+    void unlinkChildElement(ElementPtr child);
+
+    // The index of this element within the child order of its parent.
+    size_t _childIndex;
+
+    // The cached content hash, where zero denotes an invalid cache.
+    mutable std::atomic<uint64_t> _contentHash;
+
+    // The next numeric suffix to try for each child name prefix, allocated
+    // on first use.
+    std::unique_ptr<std::unordered_map<string, size_t>> _nameCounters;
+
   private:
     Element(const Element&) = delete;
     Element& operator=(const Element&) = delete;
@@ -619,6 +764,23 @@ class Element : public enable_shared_from_this<Element>
     static CreatorMap _creatorMap;
 };
 
+/// @class ConcreteElement
+/// A helper base class for concrete Element subclasses.  A subclass T that
+/// would derive from Base instead derives from ConcreteElement<T, Base>, so
+/// that getObjectSize returns the size of T without a separate override in
+/// each subclass.
+template <class T, class Base> class ConcreteElement : public Base
+{
+  protected:
+    using Base::Base;
+
+  public:
+    size_t getObjectSize() const override
+    {
+        return sizeof(T);
+    }
+};
+
 /// @class TypedElement
 /// The base class for typed elements.
 class TypedElement : public Element
@@ -800,11 +962,11 @@ class ValueElement : public TypedElement
 
 /// @class GenericElement
 /// A generic element subclass, for instantiating elements with unrecognized categories.
-class GenericElement : public Element
+class GenericElement : public ConcreteElement<GenericElement, Element>
 {
   public:
     GenericElement(ElementPtr parent, const string& name) :
-        Element(parent, CATEGORY, name)
+        ConcreteElement<GenericElement, Element>(parent, CATEGORY, name)
     {
     }
     virtual ~GenericElement() { }
@@ -834,6 +996,117 @@ class ExceptionOrphanedElement : public Exception
     }
 };
 
+/// @class ChildView
+/// A lazily evaluated view of the children of an element that are instances
+/// of a given subclass, optionally restricted to a given category.
+/// @sa Element::childrenOfType
+template <class T> class ChildView
+{
+  public:
+    ChildView(const vector<ElementPtr>& children, const string& category) :
+        _begin(children.begin()),
+        _end(children.end()),
+        _category(category)
+    {
+    }
+    ~ChildView() { }
+
+    /// @class Iterator
+    /// A forward iterator over the children in a view.
+    class Iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = shared_ptr<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const shared_ptr<T>*;
+        using reference = shared_ptr<T>;
+
+      public:
+        Iterator(const ChildView* view, vector<ElementPtr>::const_iterator it) :
+            _view(view),
+            _it(it)
+        {
+            skipMismatches();
+        }
+        ~Iterator() { }
+
+        bool operator==(const Iterator& rhs) const
+        {
+            return _it == rhs._it;
+        }
+        bool operator!=(const Iterator& rhs) const
+        {
+            return !(*this == rhs);
+        }
+
+        /// Return the current child, cast to the subclass of the view.
+        shared_ptr<T> operator*() const
+        {
+            return std::static_pointer_cast<T>(*_it);
+        }
+
+        /// Advance to the next matching child.
+        Iterator& operator++()
+        {
+            ++_it;
+            skipMismatches();
+            return *this;
+        }
+
+      private:
+        void skipMismatches()
+        {
+            while (_it != _view->_end && !_view->matches(**_it))
+            {
+                ++_it;
+            }
+        }
+
+      private:
+        const ChildView* _view;
+        vector<ElementPtr>::const_iterator _it;
+    };
+
+    /// Return an iterator to the first matching child.
+    Iterator begin() const
+    {
+        return Iterator(this, _begin);
+    }
+
+    /// Return the end iterator of the view.
+    Iterator end() const
+    {
+        return Iterator(this, _end);
+    }
+
+    /// Return true if no children match the view.
+    bool empty() const
+    {
+        return begin() == end();
+    }
+
+  private:
+    bool matches(const Element& child) const
+    {
+        if (!dynamic_cast<const T*>(&child))
+            return false;
+        if (!_category.empty() && child.getCategory() != _category)
+            return false;
+        return true;
+    }
+
+  private:
+    vector<ElementPtr>::const_iterator _begin;
+    vector<ElementPtr>::const_iterator _end;
+    string _category;
+};
+
+template<class T> ChildView<T> Element::childrenOfType(const string& category) const
+{
+    return ChildView<T>(_childOrder, category);
+}
+
 template<class T> shared_ptr<T> Element::addChild(const string& name)
 {
     string childName = name;
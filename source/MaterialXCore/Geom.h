@@ -86,11 +86,11 @@ class GeomElement : public Element
 
 /// @class GeomInfo
 /// A geometry info element within a Document.
-class GeomInfo : public GeomElement
+class GeomInfo : public ConcreteElement<GeomInfo, GeomElement>
 {
   public:
     GeomInfo(ElementPtr parent, const string& name) :
-        GeomElement(parent, CATEGORY, name)
+        ConcreteElement<GeomInfo, GeomElement>(parent, CATEGORY, name)
     {
     }
     virtual ~GeomInfo() { }
@@ -140,11 +140,11 @@ class GeomInfo : public GeomElement
 
 /// @class GeomAttr
 /// A geometry attribute element within a GeomInfo.
-class GeomAttr : public ValueElement
+class GeomAttr : public ConcreteElement<GeomAttr, ValueElement>
 {
   public:
     GeomAttr(ElementPtr parent, const string& name) :
-        ValueElement(parent, CATEGORY, name)
+        ConcreteElement<GeomAttr, ValueElement>(parent, CATEGORY, name)
     {
     }
     virtual ~GeomAttr() { }
@@ -157,11 +157,11 @@ class GeomAttr : public ValueElement
 /// A collection element within a Document.
 /// @todo Add a Collection::containsGeom method that computes whether the
 ///     given Collection contains the specified geometry.
-class Collection : public Element
+class Collection : public ConcreteElement<Collection, Element>
 {
   public:
     Collection(ElementPtr parent, const string& name) :
-        Element(parent, CATEGORY, name)
+        ConcreteElement<Collection, Element>(parent, CATEGORY, name)
     {
     }
     virtual ~Collection() { }
@@ -237,11 +237,11 @@ class Collection : public Element
 
 /// @class CollectionAdd
 /// A collection add element within a Collection.
-class CollectionAdd : public GeomElement
+class CollectionAdd : public ConcreteElement<CollectionAdd, GeomElement>
 {
   public:
     CollectionAdd(ElementPtr parent, const string& name) :
-        GeomElement(parent, CATEGORY, name)
+        ConcreteElement<CollectionAdd, GeomElement>(parent, CATEGORY, name)
     {
     }
     virtual ~CollectionAdd() { }
@@ -252,11 +252,11 @@ class CollectionAdd : public GeomElement
 
 /// @class CollectionRemove
 /// A collection remove element within a Collection.
-class CollectionRemove : public GeomElement
+class CollectionRemove : public ConcreteElement<CollectionRemove, GeomElement>
 {
   public:
     CollectionRemove(ElementPtr parent, const string& name) :
-        GeomElement(parent, CATEGORY, name)
+        ConcreteElement<CollectionRemove, GeomElement>(parent, CATEGORY, name)
     {
     }
     virtual ~CollectionRemove() { }
@@ -0,0 +1,185 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXCore/Instrumentation.h>
+
+#include <MaterialXCore/Util.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+namespace MaterialX
+{
+
+std::atomic<bool> Instrumentation::_enabled(false);
+
+namespace {
+
+// The maximum number of trace events retained between resets.  Timers
+// continue to be aggregated once this limit is reached.
+const size_t MAX_TRACE_EVENTS = 1 << 20;
+
+class TraceEvent
+{
+  public:
+    const char* name;
+    size_t threadIndex;
+    Instrumentation::Clock::time_point start;
+    Instrumentation::Clock::time_point end;
+};
+
+class InstrumentationState
+{
+  public:
+    InstrumentationState() :
+        epoch(Instrumentation::Clock::now())
+    {
+    }
+
+    // Return a small integer identifying the calling thread.
+    size_t getThreadIndex()
+    {
+        std::thread::id id = std::this_thread::get_id();
+        auto it = threadIndices.find(id);
+        if (it != threadIndices.end())
+            return it->second;
+        size_t index = threadIndices.size();
+        threadIndices[id] = index;
+        return index;
+    }
+
+  public:
+    std::mutex mutex;
+    Instrumentation::Clock::time_point epoch;
+    TimerStatsMap timers;
+    CounterMap counters;
+    vector<TraceEvent> events;
+    std::unordered_map<std::thread::id, size_t> threadIndices;
+};
+
+InstrumentationState& getState()
+{
+    static InstrumentationState state;
+    return state;
+}
+
+} // anonymous namespace
+
+//
+// Instrumentation methods
+//
+
+void Instrumentation::recordTimer(const char* name, Clock::time_point start, Clock::time_point end)
+{
+    double duration = std::chrono::duration<double>(end - start).count();
+
+    InstrumentationState& state = getState();
+    std::lock_guard<std::mutex> guard(state.mutex);
+
+    TimerStats& stats = state.timers[name];
+    stats.minTime = stats.count ? std::min(stats.minTime, duration) : duration;
+    stats.maxTime = stats.count ? std::max(stats.maxTime, duration) : duration;
+    stats.totalTime += duration;
+    stats.count++;
+
+    if (state.events.size() < MAX_TRACE_EVENTS)
+    {
+        state.events.push_back(TraceEvent{ name, state.getThreadIndex(), start, end });
+    }
+}
+
+void Instrumentation::addToCounter(const char* name, long long amount)
+{
+    InstrumentationState& state = getState();
+    std::lock_guard<std::mutex> guard(state.mutex);
+    state.counters[name] += amount;
+}
+
+void Instrumentation::reset()
+{
+    InstrumentationState& state = getState();
+    std::lock_guard<std::mutex> guard(state.mutex);
+    state.epoch = Clock::now();
+    state.timers.clear();
+    state.counters.clear();
+    state.events.clear();
+}
+
+TimerStatsMap Instrumentation::getTimerStats()
+{
+    InstrumentationState& state = getState();
+    std::lock_guard<std::mutex> guard(state.mutex);
+    return state.timers;
+}
+
+CounterMap Instrumentation::getCounters()
+{
+    InstrumentationState& state = getState();
+    std::lock_guard<std::mutex> guard(state.mutex);
+    return state.counters;
+}
+
+string Instrumentation::getReport()
+{
+    TimerStatsMap timers = getTimerStats();
+    CounterMap counters = getCounters();
+
+    std::ostringstream stream;
+    stream << std::left << std::fixed << std::setprecision(6);
+    stream << std::setw(40) << "Timer" << std::setw(10) << "Count"
+           << std::setw(14) << "Total (s)" << std::setw(14) << "Mean (s)"
+           << std::setw(14) << "Min (s)" << "Max (s)" << std::endl;
+    for (const auto& pair : timers)
+    {
+        const TimerStats& stats = pair.second;
+        stream << std::setw(40) << pair.first << std::setw(10) << stats.count
+               << std::setw(14) << stats.totalTime << std::setw(14) << stats.totalTime / stats.count
+               << std::setw(14) << stats.minTime << stats.maxTime << std::endl;
+    }
+    if (!counters.empty())
+    {
+        stream << std::endl << std::setw(40) << "Counter" << "Value" << std::endl;
+        for (const auto& pair : counters)
+        {
+            stream << std::setw(40) << pair.first << pair.second << std::endl;
+        }
+    }
+    return stream.str();
+}
+
+string Instrumentation::getChromeTrace()
+{
+    InstrumentationState& state = getState();
+    std::lock_guard<std::mutex> guard(state.mutex);
+
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"traceEvents\":[";
+    const char* separator = "\n";
+    for (const TraceEvent& event : state.events)
+    {
+        double start = std::chrono::duration<double, std::micro>(event.start - state.epoch).count();
+        double duration = std::chrono::duration<double, std::micro>(event.end - event.start).count();
+        stream << separator << "{\"name\":\"" << escapeJsonString(event.name) << "\",\"cat\":\"MaterialX\",\"ph\":\"X\""
+               << ",\"ts\":" << start << ",\"dur\":" << duration
+               << ",\"pid\":0,\"tid\":" << event.threadIndex << "}";
+        separator = ",\n";
+    }
+    double timestamp = std::chrono::duration<double, std::micro>(Clock::now() - state.epoch).count();
+    for (const auto& pair : state.counters)
+    {
+        stream << separator << "{\"name\":\"" << escapeJsonString(pair.first) << "\",\"cat\":\"MaterialX\",\"ph\":\"C\""
+               << ",\"ts\":" << timestamp << ",\"pid\":0,\"tid\":0,\"args\":{\"value\":" << pair.second << "}}";
+        separator = ",\n";
+    }
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return stream.str();
+}
+
+} // namespace MaterialX
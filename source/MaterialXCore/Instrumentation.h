@@ -0,0 +1,152 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_INSTRUMENTATION_H
+#define MATERIALX_INSTRUMENTATION_H
+
+/// @file
+/// Lightweight timers and counters for hot paths in MaterialX
+
+#include <MaterialXCore/Library.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+
+namespace MaterialX
+{
+
+/// @class TimerStats
+/// Aggregate statistics for a named timer.
+class TimerStats
+{
+  public:
+    TimerStats() :
+        count(0),
+        totalTime(0.0),
+        minTime(0.0),
+        maxTime(0.0)
+    {
+    }
+    ~TimerStats() { }
+
+  public:
+    /// The number of completed timer scopes.
+    size_t count;
+
+    /// The total duration of all scopes, in seconds.
+    double totalTime;
+
+    /// The shortest duration of any scope, in seconds.
+    double minTime;
+
+    /// The longest duration of any scope, in seconds.
+    double maxTime;
+};
+
+/// A map from timer names to aggregate statistics.
+using TimerStatsMap = std::map<string, TimerStats>;
+
+/// A map from counter names to values.
+using CounterMap = std::map<string, long long>;
+
+/// @class Instrumentation
+/// Global collection of timers and counters for MaterialX operations.
+///
+/// Instrumentation is disabled by default, in which case each timer scope
+/// and counter increment costs a single relaxed atomic load.  When enabled,
+/// timer scopes are recorded both as aggregate statistics and as individual
+/// trace events, which may be exported in the Chrome trace event format.
+/// @sa ScopedTimer
+class Instrumentation
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Enable or disable the recording of timers and counters.
+    static void setEnabled(bool enabled)
+    {
+        _enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    /// Return true if timers and counters are being recorded.
+    static bool isEnabled()
+    {
+        return _enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Add the given amount to the named counter, if instrumentation is
+    /// enabled.
+    static void incrementCounter(const char* name, long long amount = 1)
+    {
+        if (isEnabled())
+        {
+            addToCounter(name, amount);
+        }
+    }
+
+    /// Record a completed timer scope with the given name.
+    static void recordTimer(const char* name, Clock::time_point start, Clock::time_point end);
+
+    /// Clear all recorded timers, counters and trace events.
+    static void reset();
+
+    /// Return the aggregate statistics of all recorded timers.
+    static TimerStatsMap getTimerStats();
+
+    /// Return the values of all recorded counters.
+    static CounterMap getCounters();
+
+    /// Return a human-readable report of all recorded timers and counters.
+    static string getReport();
+
+    /// Return all recorded trace events as a JSON string in the Chrome trace
+    /// event format, suitable for viewing in chrome://tracing.
+    static string getChromeTrace();
+
+  private:
+    static void addToCounter(const char* name, long long amount);
+
+  private:
+    static std::atomic<bool> _enabled;
+};
+
+/// @class ScopedTimer
+/// An RAII helper that records the duration of its scope as a named timer,
+/// if instrumentation is enabled when the scope is entered.
+///
+/// The given name must remain valid for the lifetime of the timer, and is
+/// typically a string literal.
+class ScopedTimer
+{
+  public:
+    explicit ScopedTimer(const char* name) :
+        _name(Instrumentation::isEnabled() ? name : nullptr)
+    {
+        if (_name)
+        {
+            _start = Instrumentation::Clock::now();
+        }
+    }
+    ~ScopedTimer()
+    {
+        if (_name)
+        {
+            Instrumentation::recordTimer(_name, _start, Instrumentation::Clock::now());
+        }
+    }
+
+  private:
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  private:
+    const char* _name;
+    Instrumentation::Clock::time_point _start;
+};
+
+} // namespace MaterialX
+
+#endif
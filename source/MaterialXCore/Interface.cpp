@@ -68,26 +68,25 @@ Edge Parameter::getUpstreamEdge(MaterialPtr material, size_t index)
         if (getParent()->isA<NodeDef>())
         {
             // Apply BindParam elements to the Parameter.
-            for (ShaderRefPtr shaderRef : material->getShaderRefs())
+            for (ShaderRefPtr shaderRef : material->childrenOfType<ShaderRef>())
             {
                 if (shaderRef->getReferencedShaderDef() == getParent())
                 {
-                    for (BindParamPtr bindParam : shaderRef->getBindParams())
+                    BindParamPtr bindParam = shaderRef->getBindParam(getName());
+                    if (bindParam && bindParam->hasValue())
                     {
-                        if (bindParam->getName() == getName() && bindParam->hasValue())
-                        {
-                            return Edge(getSelf(), nullptr, bindParam);
-                        }
+                        return Edge(getSelf(), nullptr, bindParam);
                     }
                 }
             }
         }
 
-        // Apply Override elements to the Parameter.
-        OverridePtr override = material->getOverride(getPublicName());
-        if (override)
+        // Apply Override elements to the Parameter, including those inherited
+        // by the material.
+        const OverrideBinding* binding = material->getOverrideBindings()->getBinding(getSelf()->asA<ValueElement>());
+        if (binding && binding->override)
         {
-            return Edge(getSelf(), nullptr, override);
+            return Edge(getSelf(), nullptr, binding->override);
         }
     }
 
@@ -107,36 +106,35 @@ Edge Input::getUpstreamEdge(MaterialPtr material, size_t index)
             if (material)
             {
                 // Apply BindInput elements to the Input.
-                for (ShaderRefPtr shaderRef : material->getShaderRefs())
+                for (ShaderRefPtr shaderRef : material->childrenOfType<ShaderRef>())
                 {
                     if (shaderRef->getReferencedShaderDef() == getParent())
                     {
-                        for (BindInputPtr bindInput : shaderRef->getBindInputs())
+                        BindInputPtr bindInput = shaderRef->getBindInput(getName());
+                        if (!bindInput)
+                        {
+                            continue;
+                        }
+                        OutputPtr output = bindInput->getConnectedOutput();
+                        if (output)
+                        {
+                            return Edge(getSelf(), bindInput, output);
+                        }
+                        if (bindInput->hasValue())
                         {
-                            if (bindInput->getName() != getName())
-                            {
-                                continue;
-                            }
-                            OutputPtr output = bindInput->getConnectedOutput();
-                            if (output)
-                            {
-                                return Edge(getSelf(), bindInput, output);
-                            }
-                            if (bindInput->hasValue())
-                            {
-                                return Edge(getSelf(), nullptr, bindInput);
-                            }
+                            return Edge(getSelf(), nullptr, bindInput);
                         }
                     }
                 }
             }
         }
 
-        // Apply Override elements to the Input.
-        OverridePtr override = material->getOverride(getPublicName());
-        if (override)
+        // Apply Override elements to the Input, including those inherited
+        // by the material.
+        const OverrideBinding* binding = material->getOverrideBindings()->getBinding(getSelf()->asA<ValueElement>());
+        if (binding && binding->override)
         {
-            return Edge(getSelf(), nullptr, override);
+            return Edge(getSelf(), nullptr, binding->override);
         }
     }
 
@@ -193,9 +191,8 @@ ValuePtr InterfaceElement::getParameterValue(const string& name) const
     return param ? param->getValue() : ValuePtr();
 }
 
-void InterfaceElement::registerChildElement(ElementPtr child)
+void InterfaceElement::childElementAdded(ElementPtr child)
 {
-    TypedElement::registerChildElement(child);
     if (child->isA<Parameter>())
     {
         _parameterCount++;
@@ -206,9 +203,8 @@ void InterfaceElement::registerChildElement(ElementPtr child)
     }
 }
 
-void InterfaceElement::unregisterChildElement(ElementPtr child)
+void InterfaceElement::childElementRemoved(ElementPtr child)
 {
-    TypedElement::unregisterChildElement(child);
     if (child->isA<Parameter>())
     {
         _parameterCount--;
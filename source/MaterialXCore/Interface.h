@@ -32,11 +32,11 @@ using InterfaceElementPtr = shared_ptr<class InterfaceElement>;
 ///
 /// A Parameter holds a single uniform value, which may be modified within the
 /// scope of a Material.
-class Parameter : public ValueElement
+class Parameter : public ConcreteElement<Parameter, ValueElement>
 {
   public:
     Parameter(ElementPtr parent, const string& name) :
-        ValueElement(parent, CATEGORY, name)
+        ConcreteElement<Parameter, ValueElement>(parent, CATEGORY, name)
     {
     }
     virtual ~Parameter() { }
@@ -155,11 +155,11 @@ class PortElement : public ValueElement
 ///
 /// An Input holds either a uniform value or a connection to a spatially-varying
 /// Output, either of which may be modified within the scope of a Material.
-class Input : public PortElement
+class Input : public ConcreteElement<Input, PortElement>
 {
   public:
     Input(ElementPtr parent, const string& name) :
-        PortElement(parent, CATEGORY, name)
+        ConcreteElement<Input, PortElement>(parent, CATEGORY, name)
     {
     }
     virtual ~Input() { }
@@ -190,11 +190,11 @@ class Input : public PortElement
 
 /// @class Output
 /// A spatially-varying output element within a NodeGraph.
-class Output : public PortElement
+class Output : public ConcreteElement<Output, PortElement>
 {
   public:
     Output(ElementPtr parent, const string& name) :
-        PortElement(parent, CATEGORY, name)
+        ConcreteElement<Output, PortElement>(parent, CATEGORY, name)
     {
     }
     virtual ~Output() { }
@@ -353,8 +353,8 @@ class InterfaceElement : public TypedElement
     /// @}
 
   protected:
-    void registerChildElement(ElementPtr child) override;
-    void unregisterChildElement(ElementPtr child) override;
+    void childElementAdded(ElementPtr child) override;
+    void childElementRemoved(ElementPtr child) override;
 
   private:
     size_t _parameterCount;
@@ -28,11 +28,11 @@ using VisibilityPtr = shared_ptr<class Visibility>;
 
 /// @class Look
 /// A look element within a Document.
-class Look : public Element
+class Look : public ConcreteElement<Look, Element>
 {
   public:
     Look(ElementPtr parent, const string& name) :
-        Element(parent, CATEGORY, name)
+        ConcreteElement<Look, Element>(parent, CATEGORY, name)
     {
     }
     virtual ~Look() { }
@@ -217,11 +217,11 @@ class Look : public Element
 
 /// @class LookInherit
 /// A look inheritance element within a Look.
-class LookInherit : public Element
+class LookInherit : public ConcreteElement<LookInherit, Element>
 {
 public:
     LookInherit(ElementPtr parent, const string& name) :
-        Element(parent, CATEGORY, name)
+        ConcreteElement<LookInherit, Element>(parent, CATEGORY, name)
     {
     }
     virtual ~LookInherit() { }
@@ -232,11 +232,11 @@ public:
 
 /// @class MaterialAssign
 /// A material assignment element within a Look.
-class MaterialAssign : public GeomElement
+class MaterialAssign : public ConcreteElement<MaterialAssign, GeomElement>
 {
   public:
     MaterialAssign(ElementPtr parent, const string& name) :
-        GeomElement(parent, CATEGORY, name)
+        ConcreteElement<MaterialAssign, GeomElement>(parent, CATEGORY, name)
     {
     }
     virtual ~MaterialAssign() { }
@@ -301,11 +301,11 @@ class MaterialAssign : public GeomElement
 ///
 /// @todo Add a Look::geomIsVisible method that computes the visibility between
 ///     two geometries in the context of a specific Look.
-class Visibility : public GeomElement
+class Visibility : public ConcreteElement<Visibility, GeomElement>
 {
   public:
     Visibility(ElementPtr parent, const string& name) :
-        GeomElement(parent, CATEGORY, name)
+        ConcreteElement<Visibility, GeomElement>(parent, CATEGORY, name)
     {
     }
     virtual ~Visibility() { }
@@ -6,10 +6,81 @@
 #include <MaterialXCore/Material.h>
 
 #include <MaterialXCore/Document.h>
+#include <MaterialXCore/Traversal.h>
+
+#include <algorithm>
+#include <unordered_set>
 
 namespace MaterialX
 {
 
+namespace {
+
+template <class T> shared_ptr<T> findByName(const vector<shared_ptr<T>>& elems, const string& name)
+{
+    for (const shared_ptr<T>& elem : elems)
+    {
+        if (elem->getName() == name)
+        {
+            return elem;
+        }
+    }
+    return shared_ptr<T>();
+}
+
+// Append the elements of the source vector whose names are not already
+// present in the destination vector.
+template <class T> void mergeByName(vector<shared_ptr<T>>& dest, const vector<shared_ptr<T>>& source)
+{
+    for (const shared_ptr<T>& elem : source)
+    {
+        if (!findByName(dest, elem->getName()))
+        {
+            dest.push_back(elem);
+        }
+    }
+}
+
+// Return true if the given resolution refers to the current shader
+// references, bindings and overrides of the given material.  Elements that
+// were removed and replaced with identical copies leave the content hash of
+// the material unchanged, so they are detected by identity.
+bool refersToCurrentElements(const ResolvedMaterial& resolved, const Material& material)
+{
+    for (ShaderRefPtr shaderRef : material.getShaderRefs())
+    {
+        const ResolvedShaderRef* resolvedRef = resolved.getShaderRef(shaderRef->getName());
+        if (!resolvedRef || resolvedRef->shaderRef != shaderRef)
+        {
+            return false;
+        }
+        for (BindParamPtr bindParam : shaderRef->getBindParams())
+        {
+            if (resolvedRef->getBindParam(bindParam->getName()) != bindParam)
+            {
+                return false;
+            }
+        }
+        for (BindInputPtr bindInput : shaderRef->getBindInputs())
+        {
+            if (resolvedRef->getBindInput(bindInput->getName()) != bindInput)
+            {
+                return false;
+            }
+        }
+    }
+    for (OverridePtr override : material.getOverrides())
+    {
+        if (resolved.getOverride(override->getName()) != override)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
 const string BindInput::NODE_GRAPH_ATTRIBUTE = "nodegraph";
 const string BindInput::OUTPUT_ATTRIBUTE = "output";
 
@@ -47,9 +118,9 @@ vector<NodeDefPtr> Material::getReferencedShaderDefs() const
 vector<MaterialAssignPtr> Material::getReferencingMaterialAssigns() const
 {
     vector<MaterialAssignPtr> matAssigns;
-    for (LookPtr look : getDocument()->getLooks())
+    for (LookPtr look : getDocument()->childrenOfType<Look>())
     {
-        for (MaterialAssignPtr matAssign : look->getMaterialAssigns())
+        for (MaterialAssignPtr matAssign : look->childrenOfType<MaterialAssign>())
         {
             if (matAssign->getReferencedMaterial() == getSelf())
             {
@@ -82,6 +153,142 @@ MaterialPtr Material::getInheritsFrom() const
     return getRoot()->getChildOfType<Material>(inherits[0]->getName());
 }
 
+ResolvedMaterialPtr Material::getResolvedMaterial()
+{
+    vector<const Material*> path;
+    return resolveMaterial(path);
+}
+
+ResolvedMaterialPtr Material::resolveMaterial(vector<const Material*>& path)
+{
+    if (std::find(path.begin(), path.end(), this) != path.end())
+    {
+        throw ExceptionFoundCycle("Encountered a cycle in material inheritance: " + getName());
+    }
+
+    // Resolve the inherited materials first, so that an unchanged chain
+    // returns the memoized result.
+    vector<ResolvedMaterialPtr> bases;
+    path.push_back(this);
+    for (MaterialInheritPtr inherit : getMaterialInherits())
+    {
+        MaterialPtr base = getRoot()->getChildOfType<Material>(inherit->getName());
+        if (base)
+        {
+            bases.push_back(base->resolveMaterial(path));
+        }
+    }
+    path.pop_back();
+
+    uint64_t contentHash = getContentHash();
+    ResolvedMaterialPtr memo = std::atomic_load(&_resolvedMaterial);
+    if (memo && memo->_contentHash == contentHash && memo->_bases == bases &&
+        refersToCurrentElements(*memo, *this))
+    {
+        return memo;
+    }
+
+    MaterialPtr self = getSelf()->asA<Material>();
+    shared_ptr<ResolvedMaterial> resolved = std::make_shared<ResolvedMaterial>();
+    resolved->_material = self;
+    resolved->_inheritanceChain.push_back(self);
+    resolved->_contentHash = contentHash;
+    resolved->_bases = bases;
+    for (ShaderRefPtr shaderRef : getShaderRefs())
+    {
+        ResolvedShaderRef resolvedRef;
+        resolvedRef.shaderRef = shaderRef;
+        resolvedRef.bindParams = shaderRef->getBindParams();
+        resolvedRef.bindInputs = shaderRef->getBindInputs();
+        resolved->_shaderRefs.push_back(resolvedRef);
+    }
+    resolved->_overrides = getOverrides();
+
+    for (ResolvedMaterialPtr base : bases)
+    {
+        for (const std::weak_ptr<Material>& inherited : base->_inheritanceChain)
+        {
+            MaterialPtr material = inherited.lock();
+            if (material && !std::any_of(resolved->_inheritanceChain.begin(), resolved->_inheritanceChain.end(),
+                [&material](const std::weak_ptr<Material>& elem) { return elem.lock() == material; }))
+            {
+                resolved->_inheritanceChain.push_back(material);
+            }
+        }
+        for (const ResolvedShaderRef& baseRef : base->_shaderRefs)
+        {
+            auto it = std::find_if(resolved->_shaderRefs.begin(), resolved->_shaderRefs.end(),
+                [&baseRef](const ResolvedShaderRef& ref)
+                {
+                    return ref.shaderRef->getName() == baseRef.shaderRef->getName();
+                });
+            if (it == resolved->_shaderRefs.end())
+            {
+                resolved->_shaderRefs.push_back(baseRef);
+                continue;
+            }
+            mergeByName(it->bindParams, baseRef.bindParams);
+            mergeByName(it->bindInputs, baseRef.bindInputs);
+        }
+        mergeByName(resolved->_overrides, base->_overrides);
+    }
+
+    std::atomic_store(&_resolvedMaterial, ResolvedMaterialPtr(resolved));
+    return resolved;
+}
+
+OverrideBindingTablePtr Material::getOverrideBindings()
+{
+    uint64_t revision = getDocument()->getRevision();
+    OverrideBindingTablePtr memo = std::atomic_load(&_overrideBindings);
+    if (memo && memo->_revision == revision)
+    {
+        return memo;
+    }
+
+    shared_ptr<OverrideBindingTable> table = std::make_shared<OverrideBindingTable>();
+    table->_revision = revision;
+
+    // Resolve the effective overrides, then bind every public element of
+    // the document in a single pass.
+    ResolvedMaterialPtr resolved = getResolvedMaterial();
+    std::unordered_map<string, OverridePtr> overrides;
+    for (OverridePtr override : resolved->getOverrides())
+    {
+        overrides[override->getName()] = override;
+    }
+    std::unordered_set<string> boundNames;
+    for (ValueElementPtr receiver : getDocument()->getAllPublicElements())
+    {
+        OverrideBinding binding;
+        binding.receiver = receiver;
+        auto it = overrides.find(receiver->getPublicName());
+        if (it != overrides.end())
+        {
+            binding.override = it->second;
+            binding.effectiveValue = it->second->getValue();
+            table->_overrideMap.emplace(it->first, table->_bindings.size());
+            boundNames.insert(it->first);
+        }
+        else
+        {
+            binding.effectiveValue = receiver->getValue();
+        }
+        table->_receiverMap[receiver.get()] = table->_bindings.size();
+        table->_bindings.push_back(binding);
+    }
+    for (OverridePtr override : resolved->getOverrides())
+    {
+        if (!boundNames.count(override->getName()))
+        {
+            table->_unboundOverrides.push_back(override);
+        }
+    }
+
+    std::atomic_store(&_overrideBindings, OverrideBindingTablePtr(table));
+    return table;
+}
+
 bool Material::validate(string* message) const
 {
     bool res = true;
@@ -89,6 +296,41 @@ bool Material::validate(string* message) const
     return Element::validate(message) && res;
 }
 
+void Material::addMemoryUsage(MemoryUsage& usage) const
+{
+    Element::addMemoryUsage(usage);
+
+    // Memoized results are counted as cached data, while the resolutions of
+    // base materials are counted by the materials that hold them.
+    if (_resolvedMaterial)
+    {
+        const ResolvedMaterial& resolved = *_resolvedMaterial;
+        usage.cacheBytes += sizeof(ResolvedMaterial) +
+                            MemoryUsage::getVectorBytes(resolved._inheritanceChain) +
+                            MemoryUsage::getVectorBytes(resolved._shaderRefs) +
+                            MemoryUsage::getVectorBytes(resolved._overrides) +
+                            MemoryUsage::getVectorBytes(resolved._bases);
+        for (const ResolvedShaderRef& shaderRef : resolved._shaderRefs)
+        {
+            usage.cacheBytes += MemoryUsage::getVectorBytes(shaderRef.bindParams) +
+                                MemoryUsage::getVectorBytes(shaderRef.bindInputs);
+        }
+    }
+    if (_overrideBindings)
+    {
+        const OverrideBindingTable& table = *_overrideBindings;
+        usage.cacheBytes += sizeof(OverrideBindingTable) +
+                            MemoryUsage::getVectorBytes(table._bindings) +
+                            MemoryUsage::getHashMapBytes(table._receiverMap) +
+                            MemoryUsage::getHashMapBytes(table._overrideMap) +
+                            MemoryUsage::getVectorBytes(table._unboundOverrides);
+        for (const auto& pair : table._overrideMap)
+        {
+            usage.cacheBytes += MemoryUsage::getStringBytes(pair.first);
+        }
+    }
+}
+
 //
 // BindInput methods
 //
@@ -145,7 +387,84 @@ NodeDefPtr ShaderRef::getReferencedShaderDef()
 
 ConstElementPtr Override::getReceiver() const
 {
-    return getDocument()->getPublicElement(getName());
+    // Bind through the parent material, so that receivers agree with its
+    // override binding table, which is memoized within the material.
+    MaterialPtr material = std::const_pointer_cast<Element>(getParent())->asA<Material>();
+    if (!material)
+    {
+        return getDocument()->getPublicElement(getName());
+    }
+    vector<ValueElementPtr> receivers = material->getOverrideBindings()->getReceivers(getName());
+    return receivers.empty() ? ConstElementPtr() : receivers[0];
+}
+
+//
+// ResolvedShaderRef methods
+//
+
+BindParamPtr ResolvedShaderRef::getBindParam(const string& name) const
+{
+    return findByName(bindParams, name);
+}
+
+BindInputPtr ResolvedShaderRef::getBindInput(const string& name) const
+{
+    return findByName(bindInputs, name);
+}
+
+//
+// ResolvedMaterial methods
+//
+
+vector<MaterialPtr> ResolvedMaterial::getInheritanceChain() const
+{
+    vector<MaterialPtr> chain;
+    for (const std::weak_ptr<Material>& material : _inheritanceChain)
+    {
+        if (MaterialPtr locked = material.lock())
+        {
+            chain.push_back(locked);
+        }
+    }
+    return chain;
+}
+
+const ResolvedShaderRef* ResolvedMaterial::getShaderRef(const string& name) const
+{
+    for (const ResolvedShaderRef& ref : _shaderRefs)
+    {
+        if (ref.shaderRef->getName() == name)
+        {
+            return &ref;
+        }
+    }
+    return nullptr;
+}
+
+OverridePtr ResolvedMaterial::getOverride(const string& name) const
+{
+    return findByName(_overrides, name);
+}
+
+//
+// OverrideBindingTable methods
+//
+
+const OverrideBinding* OverrideBindingTable::getBinding(ConstValueElementPtr receiver) const
+{
+    auto it = _receiverMap.find(receiver.get());
+    return (it != _receiverMap.end()) ? &_bindings[it->second] : nullptr;
+}
+
+vector<ValueElementPtr> OverrideBindingTable::getReceivers(const string& overrideName) const
+{
+    vector<ValueElementPtr> receivers;
+    auto range = _overrideMap.equal_range(overrideName);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        receivers.push_back(_bindings[it->second].receiver);
+    }
+    return receivers;
 }
 
 } // namespace MaterialX
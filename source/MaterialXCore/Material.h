@@ -14,6 +14,8 @@
 #include <MaterialXCore/Node.h>
 #include <MaterialXCore/Value.h>
 
+#include <unordered_map>
+
 namespace MaterialX
 {
 
@@ -32,16 +34,21 @@ using BindInputPtr = shared_ptr<class BindInput>;
 /// A shared pointer to an Override
 using OverridePtr = shared_ptr<class Override>;
 
+/// A shared pointer to a const ResolvedMaterial
+using ResolvedMaterialPtr = shared_ptr<const class ResolvedMaterial>;
+/// A shared pointer to a const OverrideBindingTable
+using OverrideBindingTablePtr = shared_ptr<const class OverrideBindingTable>;
+
 /// @class Material
 /// A material element within a Document.
 /// 
 /// A Material instantiates one or more shader nodes with a specific set of
 /// data bindings.
-class Material : public Element
+class Material : public ConcreteElement<Material, Element>
 {
   public:
     Material(ElementPtr parent, const string& name) :
-        Element(parent, CATEGORY, name)
+        ConcreteElement<Material, Element>(parent, CATEGORY, name)
     {
     }
     virtual ~Material() { }
@@ -174,6 +181,29 @@ class Material : public Element
     /// Return the material, if any, that this material inherits from.
     MaterialPtr getInheritsFrom() const;
 
+    /// Return the effective shader references, bindings and overrides of
+    /// this material, merged across its full inheritance chain.
+    ///
+    /// The elements of this material take precedence over those of the
+    /// materials it inherits from, and inherited materials are visited in
+    /// the order of their MaterialInherit elements.  Shader references with
+    /// matching names are merged, with bindings matched by name.
+    ///
+    /// The result is memoized within each material of the chain, and is
+    /// reused until the content hash of the material or of any material it
+    /// inherits from changes, or until an element of the material is
+    /// replaced with an identical copy.
+    /// @throws ExceptionFoundCycle if the inheritance chain contains a cycle.
+    ResolvedMaterialPtr getResolvedMaterial();
+
+    /// Return the table binding the effective overrides of this material to
+    /// the public elements of its document.
+    ///
+    /// The table is memoized within the material, and is reused until the
+    /// revision of the document changes.
+    /// @throws ExceptionFoundCycle if the inheritance chain contains a cycle.
+    OverrideBindingTablePtr getOverrideBindings();
+
     /// @}
     /// @name Validation
     /// @{
@@ -183,6 +213,21 @@ class Material : public Element
     bool validate(string* message = nullptr) const override;
 
     /// @}
+    /// @name Memory Usage
+    /// @{
+
+    /// Add an estimate of the memory owned by this material, including its
+    /// memoized resolution and override bindings, to the given usage.
+    void addMemoryUsage(MemoryUsage& usage) const override;
+
+    /// @}
+
+  private:
+    ResolvedMaterialPtr resolveMaterial(vector<const Material*>& path);
+
+  private:
+    ResolvedMaterialPtr _resolvedMaterial;
+    OverrideBindingTablePtr _overrideBindings;
 
   public:
     static const string CATEGORY;
@@ -193,11 +238,11 @@ class Material : public Element
 ///
 /// A BindParam binds uniform data to a Parameter of a shader NodeDef within
 /// the scope of a Material.
-class BindParam : public ValueElement
+class BindParam : public ConcreteElement<BindParam, ValueElement>
 {
   public:
     BindParam(ElementPtr parent, const string& name) :
-        ValueElement(parent, CATEGORY, name)
+        ConcreteElement<BindParam, ValueElement>(parent, CATEGORY, name)
     {
     }
     virtual ~BindParam() { }
@@ -211,11 +256,11 @@ class BindParam : public ValueElement
 ///
 /// A BindInput binds spatially-varying data to an Input of a shader NodeDef
 /// within the scope of a material.
-class BindInput : public ValueElement
+class BindInput : public ConcreteElement<BindInput, ValueElement>
 {
   public:
     BindInput(ElementPtr parent, const string& name) :
-        ValueElement(parent, CATEGORY, name)
+        ConcreteElement<BindInput, ValueElement>(parent, CATEGORY, name)
     {
     }
     virtual ~BindInput() { }
@@ -274,11 +319,11 @@ class BindInput : public ValueElement
 /// A shader reference element within a Material.
 ///
 /// A ShaderRef instantiates a shader NodeDef within the context of a Material.
-class ShaderRef : public Element
+class ShaderRef : public ConcreteElement<ShaderRef, Element>
 {
   public:
     ShaderRef(ElementPtr parent, const string& name) :
-        Element(parent, CATEGORY, name)
+        ConcreteElement<ShaderRef, Element>(parent, CATEGORY, name)
     {
     }
     virtual ~ShaderRef() { }
@@ -431,11 +476,11 @@ class ShaderRef : public Element
 ///
 /// An Override modifies the uniform value of a public Parameter or Input
 /// within the scope of a Material.
-class Override : public ValueElement
+class Override : public ConcreteElement<Override, ValueElement>
 {
   public:
     Override(ElementPtr parent, const string& name) :
-        ValueElement(parent, CATEGORY, name)
+        ConcreteElement<Override, ValueElement>(parent, CATEGORY, name)
     {
     }
     virtual ~Override() { }
@@ -443,7 +488,10 @@ class Override : public ValueElement
     /// @name Connections
     /// @{
 
-    /// Return the element, if any, that is modified by this override.
+    /// Return the element, if any, that is modified by this override.  If
+    /// several public elements share its name, then the first receiver in
+    /// the override binding table of its material is returned.
+    /// @sa Material::getOverrideBindings
     ConstElementPtr getReceiver() const;
 
     /// @}
@@ -454,11 +502,11 @@ class Override : public ValueElement
 
 /// @class MaterialInherit
 /// A material inheritance element within a Material.
-class MaterialInherit : public Element
+class MaterialInherit : public ConcreteElement<MaterialInherit, Element>
 {
   public:
     MaterialInherit(ElementPtr parent, const string& name) :
-        Element(parent, CATEGORY, name)
+        ConcreteElement<MaterialInherit, Element>(parent, CATEGORY, name)
     {
     }
     virtual ~MaterialInherit() { }
@@ -467,6 +515,157 @@ class MaterialInherit : public Element
     static const string CATEGORY;
 };
 
+/// @class ResolvedShaderRef
+/// The effective bindings of a shader reference within a ResolvedMaterial.
+class ResolvedShaderRef
+{
+  public:
+    ResolvedShaderRef() { }
+    ~ResolvedShaderRef() { }
+
+    /// Return the effective BindParam, if any, with the given name.
+    BindParamPtr getBindParam(const string& name) const;
+
+    /// Return the effective BindInput, if any, with the given name.
+    BindInputPtr getBindInput(const string& name) const;
+
+  public:
+    /// The most-derived shader reference with this name.
+    ShaderRefPtr shaderRef;
+
+    /// The effective bind params, with those of derived materials first.
+    vector<BindParamPtr> bindParams;
+
+    /// The effective bind inputs, with those of derived materials first.
+    vector<BindInputPtr> bindInputs;
+};
+
+/// @class ResolvedMaterial
+/// The effective content of a material across its inheritance chain.
+///
+/// A ResolvedMaterial refers to its materials through weak pointers, so that
+/// the memoized results held by materials do not keep them alive.
+/// @sa Material::getResolvedMaterial
+class ResolvedMaterial
+{
+  public:
+    ResolvedMaterial() :
+        _contentHash(0)
+    {
+    }
+    ~ResolvedMaterial() { }
+
+    /// Return the resolved material.
+    MaterialPtr getMaterial() const
+    {
+        return _material.lock();
+    }
+
+    /// Return the resolved material followed by each material that it
+    /// inherits from, directly or indirectly, in order of precedence.
+    vector<MaterialPtr> getInheritanceChain() const;
+
+    /// Return the effective shader references, with those of derived
+    /// materials first.
+    const vector<ResolvedShaderRef>& getShaderRefs() const
+    {
+        return _shaderRefs;
+    }
+
+    /// Return the effective shader reference, if any, with the given name.
+    const ResolvedShaderRef* getShaderRef(const string& name) const;
+
+    /// Return the effective overrides, with those of derived materials first.
+    const vector<OverridePtr>& getOverrides() const
+    {
+        return _overrides;
+    }
+
+    /// Return the effective Override, if any, with the given name.
+    OverridePtr getOverride(const string& name) const;
+
+  private:
+    std::weak_ptr<Material> _material;
+    vector<std::weak_ptr<Material>> _inheritanceChain;
+    vector<ResolvedShaderRef> _shaderRefs;
+    vector<OverridePtr> _overrides;
+    uint64_t _contentHash;
+    vector<ResolvedMaterialPtr> _bases;
+
+    friend class Material;
+};
+
+/// @class OverrideBinding
+/// The binding of a public element to the override, if any, that applies to
+/// it within an OverrideBindingTable.
+class OverrideBinding
+{
+  public:
+    OverrideBinding() { }
+    ~OverrideBinding() { }
+
+  public:
+    /// The element with a public name.
+    ValueElementPtr receiver;
+
+    /// The effective override with a matching name, or an empty pointer if
+    /// the material does not override this element.
+    OverridePtr override;
+
+    /// The value of the override if present, and of the receiver otherwise.
+    ValuePtr effectiveValue;
+};
+
+/// @class OverrideBindingTable
+/// A precomputed mapping between the effective overrides of a material and
+/// the public elements of its document, valid for a single document
+/// revision.
+/// @sa Material::getOverrideBindings
+class OverrideBindingTable
+{
+  public:
+    OverrideBindingTable() :
+        _revision(0)
+    {
+    }
+    ~OverrideBindingTable() { }
+
+    /// Return the document revision at which this table was computed.
+    uint64_t getRevision() const
+    {
+        return _revision;
+    }
+
+    /// Return a binding for every public element of the document, giving
+    /// the effective value of each element under the material.
+    const vector<OverrideBinding>& getBindings() const
+    {
+        return _bindings;
+    }
+
+    /// Return the binding, if any, for the given public element.
+    const OverrideBinding* getBinding(ConstValueElementPtr receiver) const;
+
+    /// Return all public elements that receive the override with the given
+    /// name.
+    vector<ValueElementPtr> getReceivers(const string& overrideName) const;
+
+    /// Return the effective overrides that have no receiving element.
+    const vector<OverridePtr>& getUnboundOverrides() const
+    {
+        return _unboundOverrides;
+    }
+
+  private:
+    uint64_t _revision;
+    vector<OverrideBinding> _bindings;
+    std::unordered_map<const Element*, size_t> _receiverMap;
+    std::unordered_multimap<string, size_t> _overrideMap;
+    vector<OverridePtr> _unboundOverrides;
+
+    friend class Material;
+};
+
 template<class T> OverridePtr Material::setOverrideValue(const string& name,
                                                          const T& value,
                                                          const string& type)
@@ -0,0 +1,148 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXCore/MaterialCache.h>
+
+#include <MaterialXCore/Document.h>
+
+#include <algorithm>
+
+namespace MaterialX
+{
+
+namespace {
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t hashString(uint64_t hash, const string& str)
+{
+    // Include the length, so that adjacent strings cannot alias.
+    uint64_t size = str.size();
+    hash = hashBytes(hash, &size, sizeof(size));
+    return hashBytes(hash, str.data(), str.size());
+}
+
+uint64_t hashInteger(uint64_t hash, uint64_t value)
+{
+    return hashBytes(hash, &value, sizeof(value));
+}
+
+template <class T> bool compareNames(const shared_ptr<T>& lhs, const shared_ptr<T>& rhs)
+{
+    return lhs->getName() < rhs->getName();
+}
+
+// Add a bound element to the signature, hashing its name and type and
+// appending its value to the parameter block.
+void addParameter(MaterialSignature& signature, ValueElementPtr elem, const string& prefix)
+{
+    signature.topologyKey = hashString(signature.topologyKey, elem->getCategory());
+    signature.topologyKey = hashString(signature.topologyKey, elem->getName());
+    signature.topologyKey = hashString(signature.topologyKey, elem->getType());
+    signature.parameterNames.push_back(prefix + elem->getName());
+    signature.parameterValues.push_back(elem->getValue());
+}
+
+} // anonymous namespace
+
+//
+// MaterialSignature methods
+//
+
+bool MaterialSignature::hasMatchingLayout(const MaterialSignature& rhs) const
+{
+    if (parameterValues.size() != rhs.parameterValues.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < parameterValues.size(); i++)
+    {
+        const ValuePtr& lhsValue = parameterValues[i];
+        const ValuePtr& rhsValue = rhs.parameterValues[i];
+        const string& lhsType = lhsValue ? lhsValue->getTypeString() : EMPTY_STRING;
+        const string& rhsType = rhsValue ? rhsValue->getTypeString() : EMPTY_STRING;
+        if (lhsType != rhsType)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//
+// Global functions
+//
+
+MaterialSignature getMaterialSignature(MaterialPtr material)
+{
+    MaterialSignature signature;
+    signature.topologyKey = FNV_OFFSET_BASIS;
+
+    ResolvedMaterialPtr resolved = material->getResolvedMaterial();
+    signature.topologyKey = hashInteger(signature.topologyKey, resolved->getShaderRefs().size());
+    for (const ResolvedShaderRef& resolvedRef : resolved->getShaderRefs())
+    {
+        ShaderRefPtr shaderRef = resolvedRef.shaderRef;
+        NodeDefPtr shaderDef = shaderRef->getReferencedShaderDef();
+        if (shaderDef)
+        {
+            signature.topologyKey = hashString(signature.topologyKey, shaderDef->getName());
+            signature.topologyKey = hashInteger(signature.topologyKey, shaderDef->getContentHash());
+        }
+        else
+        {
+            signature.topologyKey = hashString(signature.topologyKey, shaderRef->getNode());
+        }
+
+        const string prefix = shaderRef->getName() + NAME_PATH_SEPARATOR;
+        vector<BindParamPtr> bindParams = resolvedRef.bindParams;
+        std::sort(bindParams.begin(), bindParams.end(), compareNames<BindParam>);
+        signature.topologyKey = hashInteger(signature.topologyKey, bindParams.size());
+        for (BindParamPtr bindParam : bindParams)
+        {
+            addParameter(signature, bindParam, prefix);
+        }
+
+        vector<BindInputPtr> bindInputs = resolvedRef.bindInputs;
+        std::sort(bindInputs.begin(), bindInputs.end(), compareNames<BindInput>);
+        signature.topologyKey = hashInteger(signature.topologyKey, bindInputs.size());
+        for (BindInputPtr bindInput : bindInputs)
+        {
+            OutputPtr output = bindInput->getConnectedOutput();
+            if (!output)
+            {
+                addParameter(signature, bindInput, prefix);
+                continue;
+            }
+            signature.topologyKey = hashString(signature.topologyKey, bindInput->getName());
+            signature.topologyKey = hashString(signature.topologyKey, bindInput->getType());
+            signature.topologyKey = hashString(signature.topologyKey, output->getName());
+            signature.topologyKey = hashInteger(signature.topologyKey, output->getParent()->getContentHash(false));
+        }
+    }
+
+    vector<OverridePtr> overrides = resolved->getOverrides();
+    std::sort(overrides.begin(), overrides.end(), compareNames<Override>);
+    signature.topologyKey = hashInteger(signature.topologyKey, overrides.size());
+    for (OverridePtr override : overrides)
+    {
+        addParameter(signature, override, EMPTY_STRING);
+    }
+
+    return signature;
+}
+
+} // namespace MaterialX
@@ -0,0 +1,220 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_MATERIALCACHE_H
+#define MATERIALX_MATERIALCACHE_H
+
+/// @file
+/// Caching of compiled materials by network topology
+
+#include <MaterialXCore/Library.h>
+
+#include <MaterialXCore/Material.h>
+
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace MaterialX
+{
+
+/// @class MaterialSignature
+/// The separation of a material into the topology of its shading network and
+/// a flat block of the values bound within it.
+///
+/// Two materials with equal topology keys instantiate the same shader
+/// nodedefs and connect them to the same node graphs, so an artifact
+/// compiled from one of them may be reused for the other, supplying the
+/// parameter values of each material at runtime.  The parameter blocks of
+/// such materials have the same length, and corresponding entries have the
+/// same types.
+/// @sa getMaterialSignature
+class MaterialSignature
+{
+  public:
+    MaterialSignature() :
+        topologyKey(0)
+    {
+    }
+    ~MaterialSignature() { }
+
+    /// Return the number of entries in the parameter block.
+    size_t getParameterCount() const
+    {
+        return parameterValues.size();
+    }
+
+    /// Return true if the parameter block of the given signature has the
+    /// same length as this one, and corresponding entries have the same
+    /// types.  This holds for any two signatures with equal topology keys,
+    /// and provides a cheap check against collisions of keys.
+    bool hasMatchingLayout(const MaterialSignature& rhs) const;
+
+  public:
+    /// A hash of the shader nodedefs, bound node graphs, and bound element
+    /// names and types of the material.
+    uint64_t topologyKey;
+
+    /// The name path of each bound element, relative to the material.
+    vector<string> parameterNames;
+
+    /// The value of each bound element.
+    vector<ValuePtr> parameterValues;
+};
+
+/// Return the signature of the given material, including the content that
+/// it inherits from other materials.
+///
+/// The topology key combines the name and content hash of the nodedef
+/// referenced by each shader reference, the name and type of each bind
+/// param, bind input and override, and the content hash of each node graph
+/// to which a bind input is connected.  Node graph hashes leave out the
+/// names of the graphs, so that duplicated graphs share a topology.
+///
+/// The values of bind params, of unconnected bind inputs and of overrides
+/// are excluded from the key, and are instead appended to the parameter
+/// block.  Bindings are visited in name order within each shader reference,
+/// followed by overrides in name order, so the order in which elements were
+/// added does not affect the signature.
+///
+/// Since content hashes are cached, the cost of a signature is proportional
+/// to the number of bindings in the material once the hashes of the
+/// referenced nodedefs and node graphs have been computed.
+MaterialSignature getMaterialSignature(MaterialPtr material);
+
+/// @class MaterialCache
+/// A thread-safe cache of artifacts compiled from materials, such as shader
+/// programs, keyed by the topology key of each material's signature.
+///
+/// Materials that differ only in their bound values share a single
+/// artifact, which is compiled on the first request for its topology.
+///
+/// Artifacts are matched by 64-bit topology key rather than by a full
+/// comparison of shading networks, so two distinct topologies whose keys
+/// collide, while vanishingly unlikely, would share an artifact.  As a
+/// cheap guard, a cached artifact is only returned for a signature whose
+/// parameter layout matches that of the signature it was compiled from,
+/// and is otherwise compiled anew without being cached.
+/// @sa getMaterialSignature
+template <class T> class MaterialCache
+{
+  public:
+    using ArtifactPtr = shared_ptr<T>;
+    using CompileFunction = std::function<ArtifactPtr(MaterialPtr, const MaterialSignature&)>;
+
+  public:
+    MaterialCache() :
+        _hitCount(0),
+        _missCount(0)
+    {
+    }
+    ~MaterialCache() { }
+
+    /// Return the artifact for the topology of the given material, calling
+    /// the given function to compile it if no artifact has been cached.
+    /// @param material The material whose artifact is requested.
+    /// @param compile A function compiling an artifact from a material and
+    ///    its signature.  The function is called without holding the lock
+    ///    of the cache, and if two threads compile the same topology
+    ///    concurrently, the first artifact to be stored is returned to both.
+    /// @param signature If provided, the signature of the material is
+    ///    stored here, giving access to its parameter block.
+    ArtifactPtr getArtifact(MaterialPtr material, const CompileFunction& compile,
+                            MaterialSignature* signature = nullptr)
+    {
+        MaterialSignature localSignature;
+        if (!signature)
+        {
+            signature = &localSignature;
+        }
+        *signature = getMaterialSignature(material);
+
+        bool collision = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _artifacts.find(signature->topologyKey);
+            if (it != _artifacts.end())
+            {
+                if (it->second.signature.hasMatchingLayout(*signature))
+                {
+                    _hitCount++;
+                    return it->second.artifact;
+                }
+                collision = true;
+            }
+            _missCount++;
+        }
+
+        ArtifactPtr artifact = compile(material, *signature);
+        if (collision)
+        {
+            return artifact;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        Entry entry;
+        entry.artifact = artifact;
+        entry.signature = *signature;
+        auto it = _artifacts.emplace(signature->topologyKey, entry).first;
+        return it->second.signature.hasMatchingLayout(*signature) ? it->second.artifact : artifact;
+    }
+
+    /// Return the artifact cached for the given topology key, or an empty
+    /// shared pointer if no such artifact exists.
+    ArtifactPtr getArtifact(uint64_t topologyKey) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _artifacts.find(topologyKey);
+        return (it != _artifacts.end()) ? it->second.artifact : ArtifactPtr();
+    }
+
+    /// Return the number of cached artifacts.
+    size_t getArtifactCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _artifacts.size();
+    }
+
+    /// Return the number of requests that were served from the cache.
+    size_t getHitCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _hitCount;
+    }
+
+    /// Return the number of requests that required compilation.
+    size_t getMissCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _missCount;
+    }
+
+    /// Remove all cached artifacts, and reset the request counts.
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _artifacts.clear();
+        _hitCount = 0;
+        _missCount = 0;
+    }
+
+  private:
+    // A cached artifact, along with the signature from which it was compiled.
+    class Entry
+    {
+      public:
+        ArtifactPtr artifact;
+        MaterialSignature signature;
+    };
+
+  private:
+    mutable std::mutex _mutex;
+    std::unordered_map<uint64_t, Entry> _artifacts;
+    size_t _hitCount;
+    size_t _missCount;
+};
+
+} // namespace MaterialX
+
+#endif
@@ -6,6 +6,7 @@
 #include <MaterialXCore/Node.h>
 
 #include <MaterialXCore/Document.h>
+#include <MaterialXCore/Instrumentation.h>
 #include <MaterialXCore/Material.h>
 
 #include <deque>
@@ -70,51 +71,29 @@ string Node::getConnectedNodeName(const string& inputName) const
 
 NodeDefPtr Node::getReferencedNodeDef() const
 {
-    for (NodeDefPtr nodeDef : getDocument()->getMatchingNodeDefs(getCategory()))
-    {
-        if (nodeDef->getType() == getType())
-        {
-            for (InputPtr input : getInputs())
-            {
-                InputPtr matchingInput = nodeDef->getInput(input->getName());
-                if (matchingInput && matchingInput->getType() != input->getType())
-                {
-                    continue;
-                }
-            }
-            return nodeDef;
-        }
-    }
-    return NodeDefPtr();
+    return getDocument()->getNodeDefForNode(*this);
 }
 
-ElementPtr Node::getImplementation(const string& target) const
+ElementPtr Node::getImplementation(const string& target, const string& language) const
 {
-    NodeDefPtr nodeDef = getReferencedNodeDef();
-    if (nodeDef)
-    {
-        vector<ElementPtr> implementations = getDocument()->getMatchingImplementations(nodeDef->getName());
-        for (ElementPtr implementation : implementations)
-        {
-            if (implementation->getTarget() == target)
-            {
-                return implementation;
-            }
-        }
-    }
-
-    return ElementPtr();
+    return getDocument()->getImplementationForNode(*this, target, language);
 }
 
 Edge Node::getUpstreamEdge(MaterialPtr material, size_t index)
 {
     if (index < getUpstreamEdgeCount())
     {
-        InputPtr input = getInputs()[index];
-        ElementPtr upstreamNode = input->getConnectedNode();
-        if (upstreamNode)
+        for (InputPtr input : childrenOfType<Input>())
         {
-            return Edge(getSelf(), input, upstreamNode);
+            if (index-- == 0)
+            {
+                ElementPtr upstreamNode = input->getConnectedNode();
+                if (upstreamNode)
+                {
+                    return Edge(getSelf(), input, upstreamNode);
+                }
+                break;
+            }
         }
     }
 
@@ -147,33 +126,51 @@ bool Node::validate(string* message) const
 
 void NodeGraph::flattenSubgraphs(const string& target)
 {
+    ScopedTimer timer("NodeGraph::flattenSubgraphs");
+
+    // Resolve the implementations of the initial nodes in a single batch.
+    // Flattening edits only connections, so these remain valid as the queue
+    // is processed.
     vector<NodePtr> initialNodes = getNodes();
-    std::deque<NodePtr> nodeQueue(initialNodes.begin(), initialNodes.end());
+    vector<ElementPtr> initialImplements = getDocument()->getImplementationsForNodes(initialNodes, target);
+    std::deque<std::pair<NodePtr, NodeGraphPtr>> nodeQueue;
+    for (size_t i = 0; i < initialNodes.size(); i++)
+    {
+        if (initialImplements[i] && initialImplements[i]->isA<NodeGraph>())
+        {
+            nodeQueue.emplace_back(initialNodes[i], initialImplements[i]->asA<NodeGraph>());
+        }
+    }
 
+    // Replaced nodes are marked by element id, which remains stable as
+    // new subnodes are inserted into the graph.
+    vector<bool> replacedNodes(getDocument()->getElementIdBound(), false);
     while (!nodeQueue.empty())
     {
-        NodePtr refNode = nodeQueue.front();
+        NodePtr refNode = nodeQueue.front().first;
+        NodeGraphPtr origSubGraph = nodeQueue.front().second;
         nodeQueue.pop_front();
 
-        ElementPtr implement = refNode->getImplementation(target);
-        if (!implement || !implement->isA<NodeGraph>())
-        {
-            continue;
-        }
-
-        NodeGraphPtr origSubGraph = implement->asA<NodeGraph>();
-        std::unordered_map<NodePtr, NodePtr> subNodeMap;
+        // The new instance of each original subnode, indexed by the position
+        // of the original within its graph.
+        const vector<ElementPtr>& origChildren = origSubGraph->getChildren();
+        vector<NodePtr> newSubNodes(origChildren.size());
 
         // Create a new instance of each original subnode.
-        for (NodePtr origSubNode : origSubGraph->getNodes())
+        for (size_t i = 0; i < origChildren.size(); i++)
         {
-            string newName = createValidChildName(implement->getName() + "_" + origSubNode->getName());
+            NodePtr origSubNode = origChildren[i]->asA<Node>();
+            if (!origSubNode)
+            {
+                continue;
+            }
+            string newName = createValidChildName(origSubGraph->getName() + "_" + origSubNode->getName());
             NodePtr newSubNode = addNode(origSubNode->getCategory(), newName);
             newSubNode->copyContentFrom(origSubNode);
             setChildIndex(newSubNode->getName(), getChildIndex(refNode->getName()));
 
             // Transfer interface properties from the reference node to the new subnode.
-            for (ValueElementPtr newValue : newSubNode->getChildrenOfType<ValueElement>())
+            for (ValueElementPtr newValue : newSubNode->childrenOfType<ValueElement>())
             {
                 if (!newValue->hasInterfaceName())
                 {
@@ -201,30 +198,35 @@ void NodeGraph::flattenSubgraphs(const string& target)
             }
 
             // Store the mapping between subgraphs.
-            subNodeMap[origSubNode] = newSubNode;
+            newSubNodes[i] = newSubNode;
 
             // Check if the new subnode has a graph implementation.
             // If so this subgraph will need to be flattened as well.
             ElementPtr subNodeImplement = newSubNode->getImplementation(target);
             if (subNodeImplement && subNodeImplement->isA<NodeGraph>())
             {
-                nodeQueue.push_back(newSubNode);
+                nodeQueue.emplace_back(newSubNode, subNodeImplement->asA<NodeGraph>());
             }
         }
 
         // Transfer internal connections between subgraphs.
-        for (auto subNodePair : subNodeMap)
+        for (size_t i = 0; i < origChildren.size(); i++)
         {
-            NodePtr origSubNode = subNodePair.first;
-            NodePtr newSubNode = subNodePair.second;
-            for (PortElementPtr origPort : origSubNode->getDownstreamPorts())
+            NodePtr newSubNode = newSubNodes[i];
+            if (!newSubNode)
+            {
+                continue;
+            }
+            for (PortElementPtr origPort : origChildren[i]->asA<Node>()->getDownstreamPorts())
             {
                 if (origPort->isA<Input>())
                 {
-                    auto it = subNodeMap.find(origPort->getParent()->asA<Node>());
-                    if (it != subNodeMap.end())
+                    ElementPtr origPortNode = origPort->getParent();
+                    int index = origPortNode->getParent() == origSubGraph ?
+                                origSubGraph->getChildIndex(origPortNode->getName()) : -1;
+                    if (index >= 0 && newSubNodes[index])
                     {
-                        it->second->setConnectedNode(origPort->getName(), newSubNode);
+                        newSubNodes[index]->setConnectedNode(origPort->getName(), newSubNode);
                     }
                 }
                 else if (origPort->isA<Output>())
@@ -237,77 +239,100 @@ void NodeGraph::flattenSubgraphs(const string& target)
             }
         }
 
-        // The original referencing node has been replaced, so remove it from
-        // the graph.
-        removeNode(refNode->getName());
+        // The original referencing node has been replaced, so mark it for
+        // removal from the graph.
+        if (refNode->getId() >= replacedNodes.size())
+        {
+            replacedNodes.resize(getDocument()->getElementIdBound(), false);
+        }
+        replacedNodes[refNode->getId()] = true;
     }
+
+    // Remove all replaced nodes in a single pass.
+    removeChildren([&replacedNodes](ElementPtr child)
+    {
+        return child->getId() < replacedNodes.size() && replacedNodes[child->getId()];
+    });
 }
 
 vector<ElementPtr> NodeGraph::topologicalSort() const
 {
     // Calculate a topological order of the children, using Kahn's algorithm
-    // to avoid recursion.
+    // to avoid recursion.  Children are identified by their indices, so that
+    // edges and in-degrees are stored in flat arrays.
     //
     // Running time: O(numNodes + numEdges).
 
     const vector<ElementPtr>& children = getChildren();
 
-    // Calculate in-degrees for all nodes, and enqueue those with degree 0.
-    std::unordered_map<ElementPtr, size_t> inDegree(children.size());
-    std::deque<ElementPtr> childQueue;
-    for (ElementPtr child : children)
+    // Record the downstream edges of each child, from each output to its
+    // connected node, and from each node to the nodes connected to its
+    // inputs.
+    vector<size_t> edgeOffsets(children.size() + 1, 0);
+    vector<size_t> edgeTargets;
+    auto addEdge = [this, &children, &edgeTargets](PortElementPtr port)
     {
-        NodePtr node = child->asA<Node>();
-        inDegree[child] = node ? node->getDownstreamPorts().size() : 0;
-        if (inDegree[child] == 0)
+        int index = port->hasNodeName() ? getChildIndex(port->getNodeName()) : -1;
+        if (index >= 0 && children[index]->isA<Node>())
+        {
+            edgeTargets.push_back((size_t) index);
+        }
+    };
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        edgeOffsets[i] = edgeTargets.size();
+        if (children[i]->isA<Output>())
+        {
+            addEdge(children[i]->asA<Output>());
+        }
+        else
         {
-            childQueue.push_back(child);
+            for (InputPtr input : children[i]->childrenOfType<Input>())
+            {
+                addEdge(input);
+            }
+        }
+    }
+    edgeOffsets[children.size()] = edgeTargets.size();
+
+    // Calculate in-degrees for all children, and enqueue those with degree 0.
+    vector<size_t> inDegree(children.size(), 0);
+    for (size_t target : edgeTargets)
+    {
+        inDegree[target]++;
+    }
+    std::deque<size_t> childQueue;
+    for (size_t i = 0; i < children.size(); i++)
+    {
+        if (inDegree[i] == 0)
+        {
+            childQueue.push_back(i);
         }
     }
 
-    size_t visitCount = 0;
     vector<ElementPtr> result;
+    result.reserve(children.size());
 
     while (!childQueue.empty())
     {
         // Pop the queue and add to topological order.
-        ElementPtr child = childQueue.front();
+        size_t child = childQueue.front();
         childQueue.pop_front();
-        result.push_back(child);
+        result.push_back(children[child]);
 
         // Find connected nodes and decrease their in-degree, 
         // adding node to the queue if in-degrees becomes 0.
-        if (child->isA<Output>())
+        for (size_t i = edgeOffsets[child]; i < edgeOffsets[child + 1]; i++)
         {
-            const ElementPtr connected = child->asA<Output>()->getConnectedNode();
-            if (connected)
+            if (--inDegree[edgeTargets[i]] == 0)
             {
-                if (--inDegree[connected] == 0)
-                {
-                    childQueue.push_back(connected);
-                }
+                childQueue.push_back(edgeTargets[i]);
             }
         }
-        else
-        {
-            for (auto input : child->getChildrenOfType<Input>())
-            {
-                const ElementPtr connected = input->getConnectedNode();
-                if (connected)
-                {
-                    if (--inDegree[connected] == 0)
-                    {
-                        childQueue.push_back(connected);
-                    }
-                }
-            }
-        }
-
-        visitCount++;
     }
 
     // Check if there was a cycle.
-    if (visitCount != children.size())
+    if (result.size() != children.size())
     {
         throw ExceptionFoundCycle("Encountered a cycle in graph: " + getName());
     }
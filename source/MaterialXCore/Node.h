@@ -31,11 +31,11 @@ using ConstNodeGraphPtr = shared_ptr<const class NodeGraph>;
 ///
 /// A Node represents an instance of a NodeDef within a graph, and its Parameter
 /// and Input elements apply specific values and connections to that instance.
-class Node : public InterfaceElement
+class Node : public ConcreteElement<Node, InterfaceElement>
 {
   public:
     Node(ElementPtr parent, const string& name) :
-        InterfaceElement(parent, CATEGORY, name)
+        ConcreteElement<Node, InterfaceElement>(parent, CATEGORY, name)
     {
     }
     virtual ~Node() { }
@@ -68,11 +68,16 @@ class Node : public InterfaceElement
     NodeDefPtr getReferencedNodeDef() const;
 
     /// Return an implementation for this Node, if any, matching the given
-    /// target string.  Note that a node implementation may be either an
-    /// Implementation element or a NodeGraph element.
+    /// target and language strings.  Note that a node implementation may be
+    /// either an Implementation element or a NodeGraph element.
     /// @param target The specified target string, which defaults to the
-    ///    empty string.
-    ElementPtr getImplementation(const string& target = EMPTY_STRING) const;
+    ///    empty string.  Implementations specific to this target are
+    ///    preferred, falling back to implementations with no target.
+    /// @param language The specified language string, which defaults to the
+    ///    empty string, accepting implementations in any language.
+    /// @sa Document::getImplementationForNode
+    ElementPtr getImplementation(const string& target = EMPTY_STRING,
+                                 const string& language = EMPTY_STRING) const;
 
     /// @}
     /// @name Traversal
@@ -108,11 +113,11 @@ class Node : public InterfaceElement
 
 /// @class NodeGraph
 /// A node graph element within a Document.
-class NodeGraph : public Element
+class NodeGraph : public ConcreteElement<NodeGraph, Element>
 {
   public:
     NodeGraph(ElementPtr parent, const string& name) :
-        Element(parent, CATEGORY, name)
+        ConcreteElement<NodeGraph, Element>(parent, CATEGORY, name)
     {
     }
     virtual ~NodeGraph() { }
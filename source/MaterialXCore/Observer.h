@@ -32,6 +32,23 @@ public:
     /// Called when an element is removed from the element tree.
     virtual void onRemoveElement(ElementPtr /*parent*/, ElementPtr /*elem*/) { }
 
+    /// Called when a set of child elements is removed from the element tree
+    /// in a single operation.  By default, onRemoveElement is called for
+    /// each removed element.
+    virtual void onRemoveElements(ElementPtr parent, const vector<ElementPtr>& elems)
+    {
+        for (ElementPtr elem : elems)
+        {
+            onRemoveElement(parent, elem);
+        }
+    }
+
+    /// Called when an element is given a new name.
+    virtual void onRenameElement(ElementPtr /*elem*/, const string& /*name*/) { }
+
+    /// Called when an element is moved to a new parent element.
+    virtual void onMoveElement(ElementPtr /*elem*/, ElementPtr /*parent*/) { }
+
     /// Called when an attribute of an element is set to a new value.
     virtual void onSetAttribute(ElementPtr /*elem*/, const string& /*attrib*/, const string& /*value*/) { }
 
@@ -56,11 +73,11 @@ public:
 
 /// A MaterialX document with support for registering observers
 /// that receive callbacks when the document is modified.
-class ObservedDocument : public Document
+class ObservedDocument : public ConcreteElement<ObservedDocument, Document>
 {
   public:
     ObservedDocument(ElementPtr parent, const string& name) : 
-        Document(parent, name),
+        ConcreteElement<ObservedDocument, Document>(parent, name),
         _updateScope(0)
     {
     }
@@ -146,6 +163,33 @@ class ObservedDocument : public Document
         }
     }
 
+    void onRemoveElements(ElementPtr parent, const vector<ElementPtr>& elems) override
+    {
+        Document::onRemoveElements(parent, elems);
+        for (auto &item : _observerMap)
+        {
+            item.second->onRemoveElements(parent, elems);
+        }
+    }
+
+    void onRenameElement(ElementPtr elem, const string& name) override
+    {
+        Document::onRenameElement(elem, name);
+        for (auto &item : _observerMap)
+        {
+            item.second->onRenameElement(elem, name);
+        }
+    }
+
+    void onMoveElement(ElementPtr elem, ElementPtr parent) override
+    {
+        Document::onMoveElement(elem, parent);
+        for (auto &item : _observerMap)
+        {
+            item.second->onMoveElement(elem, parent);
+        }
+    }
+
     void onSetAttribute(ElementPtr elem, const string& attrib, const string& value) override
     {
         Document::onSetAttribute(elem, attrib, value);
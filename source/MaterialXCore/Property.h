@@ -27,11 +27,11 @@ using PropertySetAssignPtr = shared_ptr<class PropertySetAssign>;
 
 /// @class Property
 /// A property element within a PropertySet.
-class Property : public ValueElement
+class Property : public ConcreteElement<Property, ValueElement>
 {
   public:
     Property(ElementPtr parent, const string& name) :
-        ValueElement(parent, CATEGORY, name)
+        ConcreteElement<Property, ValueElement>(parent, CATEGORY, name)
     {
     }
     virtual ~Property() { }
@@ -42,11 +42,11 @@ class Property : public ValueElement
 
 /// @class PropertyAssign
 /// A property assignment element within a Look.
-class PropertyAssign : public ValueElement
+class PropertyAssign : public ConcreteElement<PropertyAssign, ValueElement>
 {
   public:
     PropertyAssign(ElementPtr parent, const string& name) :
-        ValueElement(parent, CATEGORY, name)
+        ConcreteElement<PropertyAssign, ValueElement>(parent, CATEGORY, name)
     {
     }
     virtual ~PropertyAssign() { }
@@ -92,11 +92,11 @@ class PropertyAssign : public ValueElement
 
 /// @class PropertySet
 /// A property set element within a Document.
-class PropertySet : public Element
+class PropertySet : public ConcreteElement<PropertySet, Element>
 {
   public:
     PropertySet(ElementPtr parent, const string& name) :
-        Element(parent, CATEGORY, name)
+        ConcreteElement<PropertySet, Element>(parent, CATEGORY, name)
     {
     }
     virtual ~PropertySet() { }
@@ -138,11 +138,11 @@ class PropertySet : public Element
 
 /// @class PropertySetAssign
 /// A property set assignment element within a Look.
-class PropertySetAssign : public GeomElement
+class PropertySetAssign : public ConcreteElement<PropertySetAssign, GeomElement>
 {
   public:
     PropertySetAssign(ElementPtr parent, const string& name) :
-        GeomElement(parent, CATEGORY, name)
+        ConcreteElement<PropertySetAssign, GeomElement>(parent, CATEGORY, name)
     {
     }
     virtual ~PropertySetAssign() { }
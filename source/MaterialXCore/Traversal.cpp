@@ -61,6 +61,14 @@ TreeIterator& TreeIterator::operator++()
     {
         if (_stack.empty())
         {
+            if (!_pendingRoots.empty())
+            {
+                // Traverse to the next root.
+                _elem = _pendingRoots.front();
+                _pendingRoots.erase(_pendingRoots.begin());
+                return *this;
+            }
+
             // Traversal is complete.
             _elem = ElementPtr();
             return *this;
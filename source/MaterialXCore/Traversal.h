@@ -94,6 +94,16 @@ class TreeIterator
         _holdCount(0)
     {
     }
+
+    /// Construct an iterator that traverses the tree of each of the given
+    /// root elements in turn.
+    TreeIterator(const vector<ElementPtr>& roots):
+        _elem(roots.empty() ? ElementPtr() : roots[0]),
+        _pendingRoots(roots.size() > 1 ? roots.begin() + 1 : roots.end(), roots.end()),
+        _prune(false),
+        _holdCount(0)
+    {
+    }
     ~TreeIterator() { }
 
   private:
@@ -104,6 +114,7 @@ class TreeIterator
     {
         return _elem == rhs._elem &&
                _stack == rhs._stack &&
+               _pendingRoots == rhs._pendingRoots &&
                _prune == rhs._prune;
     }
     bool operator!=(const TreeIterator& rhs) const
@@ -180,6 +191,7 @@ class TreeIterator
   private:
     ElementPtr _elem;
     vector<StackFrame> _stack;
+    vector<ElementPtr> _pendingRoots;
     bool _prune;
     size_t _holdCount;
 };
@@ -107,6 +107,36 @@ string replaceSubstrings(string str, const StringMap& stringMap)
     return str;
 }
 
+string escapeJsonString(const string& str)
+{
+    string result;
+    result.reserve(str.size());
+    for (char c : str)
+    {
+        switch (c)
+        {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if ((unsigned char) c < 0x20)
+                {
+                    const char* digits = "0123456789abcdef";
+                    result += "\\u00";
+                    result += digits[(c >> 4) & 0xf];
+                    result += digits[c & 0xf];
+                }
+                else
+                {
+                    result += c;
+                }
+        }
+    }
+    return result;
+}
+
 string prettyPrint(ElementPtr elem)
 {
     string text;
@@ -125,7 +155,7 @@ string printGraphDot(NodeGraphPtr graph)
     dot << "digraph {\n";
 
     // Print the nodes
-    for (auto node : graph->getChildrenOfType<Node>())
+    for (NodePtr node : graph->childrenOfType<Node>())
     {
         dot << "    \"" << node->getName() << "\" ";
         const string& category = node->getCategory();
@@ -141,7 +171,7 @@ string printGraphDot(NodeGraphPtr graph)
  
     // Print the connections
     std::set<Edge> processedEdges;
-    for (auto output : graph->getChildrenOfType<Output>())
+    for (OutputPtr output : graph->childrenOfType<Output>())
     {
         for (Edge edge : output->traverseGraph())
         {
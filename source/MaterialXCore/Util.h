@@ -47,6 +47,11 @@ vector<string> splitString(const string& str, const string& sep);
 /// Apply the given substring substitutions to the input string.
 string replaceSubstrings(string str, const StringMap& stringMap);
 
+/// Escape the given string for use within a quoted JSON string, escaping
+/// quotes and backslashes, and writing control characters as escape
+/// sequences.
+string escapeJsonString(const string& str);
+
 /// Pretty print the given element tree, calling asString recursively on each
 /// element in depth-first order.
 string prettyPrint(ElementPtr elem);
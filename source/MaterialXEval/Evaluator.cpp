@@ -0,0 +1,1268 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXEval/Evaluator.h>
+
+#include <MaterialXEval/Noise.h>
+
+#include <MaterialXCore/Document.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace MaterialX
+{
+
+namespace {
+
+// The channels of the sample streams, as addressed by load instructions.
+const unsigned int STREAM_TEXCOORD = 0;
+const unsigned int STREAM_POSITION = 2;
+const unsigned int STREAM_NORMAL = 5;
+const unsigned int STREAM_CHANNEL_COUNT = 8;
+
+// Virtual registers with this flag set refer to constants during
+// compilation, and are mapped to the lowest physical registers once
+// compilation is complete.
+const unsigned int CONSTANT_FLAG = 0x80000000U;
+
+const float DEGREES_TO_RADIANS = 0.017453292519943295f;
+
+const string ALPHA_CHANNEL_TYPES[] = { "color2", "color4" };
+
+// Categories of geometric and application nodes that are evaluated as the
+// default values of their nodedefs.
+const std::unordered_set<string> DEFAULT_VALUE_CATEGORIES =
+{
+    "tangent", "bitangent", "geomcolor", "time", "frame"
+};
+
+const std::unordered_map<string, EvalInstruction::Opcode> BINARY_OPCODES =
+{
+    { "add", EvalInstruction::OpAdd },
+    { "subtract", EvalInstruction::OpSubtract },
+    { "multiply", EvalInstruction::OpMultiply },
+    { "divide", EvalInstruction::OpDivide },
+    { "modulo", EvalInstruction::OpModulo },
+    { "exponent", EvalInstruction::OpPower },
+    { "min", EvalInstruction::OpMin },
+    { "max", EvalInstruction::OpMax }
+};
+
+const std::unordered_map<string, EvalInstruction::Opcode> UNARY_OPCODES =
+{
+    { "absval", EvalInstruction::OpAbsolute },
+    { "floor", EvalInstruction::OpFloor }
+};
+
+using Channels = vector<unsigned int>;
+
+template<class T> vector<float> getVectorChannels(const T& vec)
+{
+    vector<float> values;
+    for (size_t i = 0; i < vec.data.size(); i++)
+    {
+        values.push_back(vec[i]);
+    }
+    return values;
+}
+
+// Return the float channels of the given value, or an empty vector if the
+// value is missing or is not of a numeric type.
+vector<float> getValueChannels(ValuePtr value)
+{
+    if (!value)
+        return vector<float>();
+    if (value->isA<float>())
+        return vector<float>(1, value->asA<float>());
+    if (value->isA<int>())
+        return vector<float>(1, (float) value->asA<int>());
+    if (value->isA<bool>())
+        return vector<float>(1, value->asA<bool>() ? 1.0f : 0.0f);
+    if (value->isA<Color2>())
+        return getVectorChannels(value->asA<Color2>());
+    if (value->isA<Color3>())
+        return getVectorChannels(value->asA<Color3>());
+    if (value->isA<Color4>())
+        return getVectorChannels(value->asA<Color4>());
+    if (value->isA<Vector2>())
+        return getVectorChannels(value->asA<Vector2>());
+    if (value->isA<Vector3>())
+        return getVectorChannels(value->asA<Vector3>());
+    if (value->isA<Vector4>())
+        return getVectorChannels(value->asA<Vector4>());
+    return vector<float>();
+}
+
+// Return the index of the given swizzle channel, or -1 for the constant
+// channels "0" and "1".
+int getSwizzleIndex(char channel)
+{
+    switch (channel)
+    {
+        case 'r': case 'x': return 0;
+        case 'g': case 'y': return 1;
+        case 'b': case 'z': return 2;
+        case 'a': case 'w': return 3;
+        default: return -1;
+    }
+}
+
+// A builder for the instructions of a program, which assigns a virtual
+// register to each channel of each compiled node.
+class ProgramBuilder
+{
+  public:
+    ProgramBuilder(const NodeDefResolver& resolveNodeDef = nullptr) :
+        _resolveNodeDef(resolveNodeDef),
+        _tempCount(0)
+    {
+        std::fill(_streamRegisters, _streamRegisters + STREAM_CHANNEL_COUNT, 0U);
+    }
+
+    unsigned int constant(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        auto it = _constantMap.find(bits);
+        if (it != _constantMap.end())
+        {
+            return it->second;
+        }
+        unsigned int reg = CONSTANT_FLAG | (unsigned int) constantValues.size();
+        constantValues.push_back(value);
+        _constantMap[bits] = reg;
+        return reg;
+    }
+
+    Channels constants(const vector<float>& values)
+    {
+        Channels channels;
+        for (float value : values)
+        {
+            channels.push_back(constant(value));
+        }
+        return channels;
+    }
+
+    unsigned int emit(EvalInstruction::Opcode opcode,
+                      unsigned int arg0 = 0,
+                      unsigned int arg1 = 0,
+                      unsigned int arg2 = 0,
+                      unsigned int arg3 = 0,
+                      unsigned int immediate = 0)
+    {
+        unsigned int dest = _tempCount++;
+        instructions.push_back(EvalInstruction(opcode, dest, arg0, arg1, arg2, arg3, immediate));
+        return dest;
+    }
+
+    unsigned int load(unsigned int streamChannel)
+    {
+        if (!_streamRegisters[streamChannel])
+        {
+            // Stream registers are offset by one, so that zero marks a
+            // stream channel that has not yet been loaded.
+            _streamRegisters[streamChannel] = emit(EvalInstruction::OpLoad, 0, 0, 0, 0, streamChannel) + 1;
+        }
+        return _streamRegisters[streamChannel] - 1;
+    }
+
+    Channels loadStream(unsigned int firstChannel, size_t channelCount)
+    {
+        Channels channels;
+        for (size_t i = 0; i < channelCount; i++)
+        {
+            channels.push_back(load(firstChannel + (unsigned int) i));
+        }
+        return channels;
+    }
+
+    void compileNode(ConstNodePtr node);
+
+    Channels getNodeChannels(ConstNodePtr node) const
+    {
+        return _nodeChannels.at(node->getName());
+    }
+
+    Channels swizzle(const Channels& channels, const string& pattern, size_t width);
+    Channels broadcast(const Channels& channels, size_t width);
+
+  private:
+    Channels getPort(ConstNodePtr node, NodeDefPtr nodeDef, const string& name);
+    Channels getDefaultGeomProp(const string& geomProp, size_t width);
+    vector<float> getConstantValues(ConstNodePtr node, NodeDefPtr nodeDef, const string& name, size_t width);
+
+    unsigned int dot(const Channels& a, const Channels& b, size_t count);
+
+  public:
+    vector<EvalInstruction> instructions;
+    vector<float> constantValues;
+
+  private:
+    NodeDefResolver _resolveNodeDef;
+    unsigned int _tempCount;
+    unsigned int _streamRegisters[STREAM_CHANNEL_COUNT];
+    std::unordered_map<uint32_t, unsigned int> _constantMap;
+    std::unordered_map<string, Channels> _nodeChannels;
+};
+
+Channels ProgramBuilder::broadcast(const Channels& channels, size_t width)
+{
+    if (channels.size() == width)
+    {
+        return channels;
+    }
+    Channels result(width);
+    for (size_t i = 0; i < width; i++)
+    {
+        if (channels.size() == 1)
+            result[i] = channels[0];
+        else if (i < channels.size())
+            result[i] = channels[i];
+        else
+            result[i] = constant(0.0f);
+    }
+    return result;
+}
+
+Channels ProgramBuilder::swizzle(const Channels& channels, const string& pattern, size_t width)
+{
+    Channels result;
+    for (char c : pattern)
+    {
+        if (c == '0' || c == '1')
+        {
+            result.push_back(constant(c == '1' ? 1.0f : 0.0f));
+            continue;
+        }
+        int index = getSwizzleIndex(c);
+        if (index < 0)
+        {
+            throw Exception("Invalid swizzle channel: " + string(1, c));
+        }
+        result.push_back(channels.size() == 1 ? channels[0] :
+                         (size_t) index < channels.size() ? channels[index] : constant(0.0f));
+    }
+    return broadcast(result, width);
+}
+
+Channels ProgramBuilder::getDefaultGeomProp(const string& geomProp, size_t width)
+{
+    if (geomProp == "texcoord")
+        return broadcast(loadStream(STREAM_TEXCOORD, 2), width);
+    if (geomProp == "position")
+        return broadcast(loadStream(STREAM_POSITION, 3), width);
+    if (geomProp == "normal")
+        return broadcast(loadStream(STREAM_NORMAL, 3), width);
+    return broadcast(Channels(1, constant(0.0f)), width);
+}
+
+// Return the channels of the named input or parameter of a node, at the
+// natural width of its type.
+Channels ProgramBuilder::getPort(ConstNodePtr node, NodeDefPtr nodeDef, const string& name)
+{
+    ValueElementPtr declaration = nodeDef->getChildOfType<ValueElement>(name);
+    ValueElementPtr port = node->getChildOfType<ValueElement>(name);
+    const string& type = port ? port->getType() : declaration ? declaration->getType() : DEFAULT_TYPE_STRING;
+    size_t width = std::max(getEvalChannelCount(type), (size_t) 1);
+
+    InputPtr input = port ? port->asA<Input>() : InputPtr();
+    if (input && input->hasNodeName())
+    {
+        NodePtr upstream = input->getConnectedNode();
+        if (!upstream || !_nodeChannels.count(upstream->getName()))
+        {
+            throw Exception("Invalid port connection: " + input->getNamePath());
+        }
+        const Channels& channels = _nodeChannels[upstream->getName()];
+        return input->hasChannels() ? swizzle(channels, input->getChannels(), width) : broadcast(channels, width);
+    }
+
+    vector<float> values = port ? getValueChannels(port->getValue()) : vector<float>();
+    if (values.empty() && declaration)
+    {
+        values = getValueChannels(declaration->getValue());
+        if (values.empty() && declaration->hasAttribute("defaultgeomprop"))
+        {
+            return getDefaultGeomProp(declaration->getAttribute("defaultgeomprop"), width);
+        }
+    }
+    if (values.empty())
+    {
+        values.push_back(0.0f);
+    }
+    return broadcast(constants(values), width);
+}
+
+// Return the values of the named parameter of a node for use at compile
+// time, broadcast to the given width.
+vector<float> ProgramBuilder::getConstantValues(ConstNodePtr node, NodeDefPtr nodeDef, const string& name, size_t width)
+{
+    vector<float> values = getValueChannels(node->getParameterValue(name));
+    if (values.empty())
+    {
+        values = getValueChannels(nodeDef->getParameterValue(name));
+    }
+    if (values.empty())
+    {
+        values.push_back(0.0f);
+    }
+    values.resize(width, values.size() == 1 ? values[0] : 0.0f);
+    return values;
+}
+
+unsigned int ProgramBuilder::dot(const Channels& a, const Channels& b, size_t count)
+{
+    unsigned int sum = emit(EvalInstruction::OpMultiply, a[0], b[0]);
+    for (size_t i = 1; i < count; i++)
+    {
+        sum = emit(EvalInstruction::OpMultiplyAdd, a[i], b[i], sum);
+    }
+    return sum;
+}
+
+void ProgramBuilder::compileNode(ConstNodePtr node)
+{
+    using Op = EvalInstruction;
+
+    const string& category = node->getCategory();
+    size_t width = getEvalChannelCount(node->getType());
+    if (!width)
+    {
+        throw Exception("Node type cannot be evaluated: " + node->getNamePath() + " (" + node->getType() + ")");
+    }
+    NodeDefPtr nodeDef = _resolveNodeDef ? _resolveNodeDef(node) : node->getReferencedNodeDef();
+    if (!nodeDef)
+    {
+        throw Exception("No matching nodedef for node: " + node->getNamePath());
+    }
+
+    auto port = [&](const string& name) { return getPort(node, nodeDef, name); };
+    auto input = [&](const string& name) { return broadcast(getPort(node, nodeDef, name), width); };
+    auto scalar = [&](const string& name) { return getPort(node, nodeDef, name)[0]; };
+    unsigned int zero = constant(0.0f);
+    unsigned int one = constant(1.0f);
+    unsigned int two = constant(2.0f);
+
+    Channels result(width);
+    if (BINARY_OPCODES.count(category))
+    {
+        Op::Opcode opcode = BINARY_OPCODES.at(category);
+        Channels in1 = input("in1");
+        Channels in2 = input("in2");
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(opcode, in1[i], in2[i]);
+    }
+    else if (UNARY_OPCODES.count(category))
+    {
+        Op::Opcode opcode = UNARY_OPCODES.at(category);
+        Channels in = input("in");
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(opcode, in[i]);
+    }
+    else if (category == "constant")
+    {
+        result = input("value");
+    }
+    else if (category == "dot")
+    {
+        result = input("in");
+    }
+    else if (category == "clamp" || category == "smoothstep")
+    {
+        Op::Opcode opcode = category == "clamp" ? Op::OpClamp : Op::OpSmoothStep;
+        Channels in = input("in");
+        Channels low = input("low");
+        Channels high = input("high");
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(opcode, in[i], low[i], high[i]);
+    }
+    else if (category == "invert")
+    {
+        Channels in = input("in");
+        Channels amount = input("amount");
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(Op::OpSubtract, amount[i], in[i]);
+    }
+    else if (category == "contrast")
+    {
+        Channels in = input("in");
+        Channels amount = input("amount");
+        Channels pivot = input("pivot");
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(Op::OpMultiplyAdd, emit(Op::OpSubtract, in[i], pivot[i]), amount[i], pivot[i]);
+    }
+    else if (category == "remap")
+    {
+        Channels in = input("in");
+        Channels inLow = input("inlow");
+        Channels inHigh = input("inhigh");
+        Channels outLow = input("outlow");
+        Channels outHigh = input("outhigh");
+        vector<float> gamma = getConstantValues(node, nodeDef, "gamma", width);
+        bool doClamp = getConstantValues(node, nodeDef, "doclamp", 1)[0] != 0.0f;
+        for (size_t i = 0; i < width; i++)
+        {
+            unsigned int t = emit(Op::OpDivide, emit(Op::OpSubtract, in[i], inLow[i]),
+                                                emit(Op::OpSubtract, inHigh[i], inLow[i]));
+            if (doClamp)
+                t = emit(Op::OpClamp, t, zero, one);
+            if (gamma[i] != 1.0f)
+                t = emit(Op::OpPower, t, constant(1.0f / gamma[i]));
+            result[i] = emit(Op::OpMultiplyAdd, t, emit(Op::OpSubtract, outHigh[i], outLow[i]), outLow[i]);
+        }
+    }
+    else if (category == "mix")
+    {
+        Channels fg = input("fg");
+        Channels bg = input("bg");
+        Channels mask = input("mask");
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(Op::OpMix, fg[i], bg[i], mask[i]);
+    }
+    else if (category == "inside" || category == "outside")
+    {
+        Channels in = input("in");
+        unsigned int mask = scalar("mask");
+        if (category == "outside")
+            mask = emit(Op::OpSubtract, one, mask);
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(Op::OpMultiply, in[i], mask);
+    }
+    else if (category == "screen" || category == "overlay" || category == "burn" || category == "dodge")
+    {
+        Channels fg = input("fg");
+        Channels bg = input("bg");
+        for (size_t i = 0; i < width; i++)
+        {
+            if (category == "burn")
+            {
+                result[i] = emit(Op::OpSubtract, one, emit(Op::OpDivide, emit(Op::OpSubtract, one, bg[i]), fg[i]));
+                continue;
+            }
+            if (category == "dodge")
+            {
+                result[i] = emit(Op::OpDivide, bg[i], emit(Op::OpSubtract, one, fg[i]));
+                continue;
+            }
+            unsigned int inverse = emit(Op::OpMultiply, emit(Op::OpSubtract, one, fg[i]), emit(Op::OpSubtract, one, bg[i]));
+            if (category == "screen")
+            {
+                result[i] = emit(Op::OpSubtract, one, inverse);
+                continue;
+            }
+            unsigned int dark = emit(Op::OpMultiply, emit(Op::OpMultiply, fg[i], bg[i]), two);
+            unsigned int light = emit(Op::OpSubtract, one, emit(Op::OpMultiply, inverse, two));
+            result[i] = emit(Op::OpSelectLess, bg[i], constant(0.5f), dark, light);
+        }
+    }
+    else if (category == "premult" || category == "unpremult" || category == "over" || category == "disjointover" ||
+             category == "in" || category == "out" || category == "mask" || category == "matte")
+    {
+        if (std::find(std::begin(ALPHA_CHANNEL_TYPES), std::end(ALPHA_CHANNEL_TYPES), node->getType()) == std::end(ALPHA_CHANNEL_TYPES))
+        {
+            throw Exception("Compositing node requires an alpha channel: " + node->getNamePath());
+        }
+        size_t alpha = width - 1;
+        if (category == "premult" || category == "unpremult")
+        {
+            Channels in = input("in");
+            for (size_t i = 0; i < alpha; i++)
+            {
+                result[i] = category == "premult" ?
+                            emit(Op::OpMultiply, in[i], in[alpha]) :
+                            emit(Op::OpSelectLess, zero, in[alpha], emit(Op::OpDivide, in[i], in[alpha]), in[i]);
+            }
+            result[alpha] = in[alpha];
+        }
+        else
+        {
+            Channels fg = input("fg");
+            Channels bg = input("bg");
+            unsigned int fgAlpha = fg[alpha];
+            unsigned int bgAlpha = bg[alpha];
+            unsigned int fgInverse = emit(Op::OpSubtract, one, fgAlpha);
+            unsigned int alphaSum = category == "disjointover" ? emit(Op::OpAdd, fgAlpha, bgAlpha) : zero;
+            for (size_t i = 0; i < width; i++)
+            {
+                if (category == "over")
+                    result[i] = emit(Op::OpMultiplyAdd, bg[i], fgInverse, fg[i]);
+                else if (category == "in")
+                    result[i] = emit(Op::OpMultiply, fg[i], bgAlpha);
+                else if (category == "out")
+                    result[i] = emit(Op::OpMultiply, fg[i], emit(Op::OpSubtract, one, bgAlpha));
+                else if (category == "mask")
+                    result[i] = emit(Op::OpMultiply, bg[i], fgAlpha);
+                else if (category == "matte")
+                    result[i] = i == alpha ? emit(Op::OpMultiplyAdd, bgAlpha, fgInverse, fgAlpha) :
+                                             emit(Op::OpMix, fg[i], bg[i], fgAlpha);
+                else
+                {
+                    unsigned int scaled = emit(Op::OpDivide, emit(Op::OpMultiply, bg[i], fgInverse), bgAlpha);
+                    result[i] = emit(Op::OpSelectLess, one, alphaSum,
+                                     emit(Op::OpAdd, fg[i], scaled),
+                                     emit(Op::OpAdd, fg[i], bg[i]));
+                }
+            }
+        }
+    }
+    else if (category == "compare")
+    {
+        unsigned int intest = scalar("intest");
+        unsigned int cutoff = scalar("cutoff");
+        Channels in1 = input("in1");
+        Channels in2 = input("in2");
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(Op::OpSelectLess, cutoff, intest, in2[i], in1[i]);
+    }
+    else if (category == "switch")
+    {
+        float which = getConstantValues(node, nodeDef, "which", 1)[0];
+        int index = std::min(std::max((int) std::floor(which), 0), 4);
+        result = input("in" + std::to_string(index + 1));
+    }
+    else if (category == "luminance" || category == "saturate")
+    {
+        Channels in = input("in");
+        Channels coeffs = broadcast(port("lumacoeffs"), 3);
+        unsigned int luminance = dot(in, coeffs, 3);
+        Channels amount = category == "saturate" ? broadcast(port("amount"), 1) : Channels();
+        for (size_t i = 0; i < width; i++)
+        {
+            if (i >= 3)
+                result[i] = in[i];
+            else if (category == "luminance")
+                result[i] = luminance;
+            else
+                result[i] = emit(Op::OpMix, in[i], luminance, amount[0]);
+        }
+    }
+    else if (category == "magnitude" || category == "normalize")
+    {
+        Channels in = port("in");
+        unsigned int length = emit(Op::OpSquareRoot, dot(in, in, in.size()));
+        if (category == "magnitude")
+            result[0] = length;
+        else
+            for (size_t i = 0; i < width; i++)
+                result[i] = emit(Op::OpDivide, in[i], length);
+    }
+    else if (category == "dotproduct")
+    {
+        Channels in1 = port("in1");
+        Channels in2 = broadcast(port("in2"), in1.size());
+        result[0] = dot(in1, in2, in1.size());
+    }
+    else if (category == "crossproduct")
+    {
+        Channels a = input("in1");
+        Channels b = input("in2");
+        for (size_t i = 0; i < 3; i++)
+        {
+            size_t j = (i + 1) % 3;
+            size_t k = (i + 2) % 3;
+            result[i] = emit(Op::OpSubtract, emit(Op::OpMultiply, a[j], b[k]), emit(Op::OpMultiply, a[k], b[j]));
+        }
+    }
+    else if (category == "rotate2d")
+    {
+        Channels in = input("in");
+        Channels center = input("center");
+        float angle = getConstantValues(node, nodeDef, "amount", 1)[0] * DEGREES_TO_RADIANS;
+        unsigned int cosine = constant(std::cos(angle));
+        unsigned int sine = constant(std::sin(angle));
+        unsigned int x = emit(Op::OpSubtract, in[0], center[0]);
+        unsigned int y = emit(Op::OpSubtract, in[1], center[1]);
+        result[0] = emit(Op::OpMultiplyAdd, x, cosine, emit(Op::OpMultiplyAdd, y, constant(-std::sin(angle)), center[0]));
+        result[1] = emit(Op::OpMultiplyAdd, x, sine, emit(Op::OpMultiplyAdd, y, cosine, center[1]));
+    }
+    else if (category == "scale")
+    {
+        Channels in = input("in");
+        Channels amount = input("amount");
+        Channels center = input("center");
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(Op::OpMultiplyAdd, emit(Op::OpSubtract, in[i], center[i]), amount[i], center[i]);
+    }
+    else if (category == "pack")
+    {
+        result.clear();
+        for (InputPtr declared : nodeDef->childrenOfType<Input>())
+        {
+            for (unsigned int channel : port(declared->getName()))
+            {
+                result.push_back(channel);
+            }
+        }
+        result = broadcast(result, width);
+        result.resize(width);
+    }
+    else if (category == "swizzle")
+    {
+        result = swizzle(port("in"), node->getParameterValueString("channels"), width);
+    }
+    else if (category == "texcoord")
+    {
+        result = getDefaultGeomProp("texcoord", width);
+    }
+    else if (category == "position" || category == "normal")
+    {
+        result = getDefaultGeomProp(category, width);
+    }
+    else if (DEFAULT_VALUE_CATEGORIES.count(category))
+    {
+        vector<float> values = getValueChannels(Value::createValueFromStrings(nodeDef->getAttribute("default"), nodeDef->getType()));
+        result = broadcast(constants(values.empty() ? vector<float>(1, 0.0f) : values), width);
+    }
+    else if (category == "ramplr" || category == "ramptb")
+    {
+        bool horizontal = category == "ramplr";
+        Channels texcoord = broadcast(port("texcoord"), 2);
+        unsigned int t = emit(Op::OpClamp, texcoord[horizontal ? 0 : 1], zero, one);
+        Channels low = input(horizontal ? "valuel" : "valueb");
+        Channels high = input(horizontal ? "valuer" : "valuet");
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(Op::OpMix, high[i], low[i], t);
+    }
+    else if (category == "ramp4")
+    {
+        Channels texcoord = broadcast(port("texcoord"), 2);
+        unsigned int s = emit(Op::OpClamp, texcoord[0], zero, one);
+        unsigned int t = emit(Op::OpClamp, texcoord[1], zero, one);
+        Channels topLeft = input("valuetl");
+        Channels topRight = input("valuetr");
+        Channels bottomLeft = input("valuebl");
+        Channels bottomRight = input("valuebr");
+        for (size_t i = 0; i < width; i++)
+        {
+            unsigned int top = emit(Op::OpMix, topRight[i], topLeft[i], s);
+            unsigned int bottom = emit(Op::OpMix, bottomRight[i], bottomLeft[i], s);
+            result[i] = emit(Op::OpMix, top, bottom, t);
+        }
+    }
+    else if (category == "splitlr")
+    {
+        Channels texcoord = broadcast(port("texcoord"), 2);
+        unsigned int center = scalar("center");
+        Channels left = input("valuel");
+        Channels right = input("valuer");
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(Op::OpSelectLess, texcoord[0], center, left[i], right[i]);
+    }
+    else if (category == "splittb")
+    {
+        Channels texcoord = broadcast(port("texcoord"), 2);
+        unsigned int center = scalar("center");
+        Channels top = input("valuet");
+        Channels bottom = input("valueb");
+        for (size_t i = 0; i < width; i++)
+            result[i] = emit(Op::OpSelectLess, center, texcoord[1], top[i], bottom[i]);
+    }
+    else if (category == "noise2d" || category == "noise3d")
+    {
+        bool is2d = category == "noise2d";
+        Channels coords = is2d ? broadcast(port("texcoord"), 2) : broadcast(port("position"), 3);
+        Channels amplitude = input("amplitude");
+        Channels pivot = input("pivot");
+        for (unsigned int i = 0; i < width; i++)
+        {
+            unsigned int noise = is2d ? emit(Op::OpNoise2d, coords[0], coords[1], 0, 0, i) :
+                                        emit(Op::OpNoise3d, coords[0], coords[1], coords[2], 0, i);
+            result[i] = emit(Op::OpMultiplyAdd, noise, amplitude[i], pivot[i]);
+        }
+    }
+    else if (category == "fractal3d")
+    {
+        Channels position = broadcast(port("position"), 3);
+        Channels amplitude = input("amplitude");
+        int octaves = (int) getConstantValues(node, nodeDef, "octaves", 1)[0];
+        vector<float> lacunarity = getConstantValues(node, nodeDef, "lacunarity", width);
+        vector<float> diminish = getConstantValues(node, nodeDef, "diminish", width);
+        for (unsigned int i = 0; i < width; i++)
+        {
+            unsigned int sum = zero;
+            float frequency = 1.0f;
+            float weight = 1.0f;
+            for (int octave = 0; octave < octaves; octave++)
+            {
+                Channels p = position;
+                if (frequency != 1.0f)
+                {
+                    for (unsigned int& coord : p)
+                        coord = emit(Op::OpMultiply, coord, constant(frequency));
+                }
+                unsigned int noise = emit(Op::OpNoise3d, p[0], p[1], p[2], 0, i);
+                sum = emit(Op::OpMultiplyAdd, noise, constant(weight), sum);
+                frequency *= lacunarity[i];
+                weight *= diminish[i];
+            }
+            result[i] = emit(Op::OpMultiply, sum, amplitude[i]);
+        }
+    }
+    else if (category == "cellnoise2d" || category == "cellnoise3d")
+    {
+        bool is2d = category == "cellnoise2d";
+        Channels coords = is2d ? broadcast(port("texcoord"), 2) : broadcast(port("position"), 3);
+        for (unsigned int i = 0; i < width; i++)
+        {
+            result[i] = is2d ? emit(Op::OpCellNoise2d, coords[0], coords[1], 0, 0, i) :
+                               emit(Op::OpCellNoise3d, coords[0], coords[1], coords[2], 0, i);
+        }
+    }
+    else
+    {
+        throw Exception("Node category cannot be evaluated: " + node->getNamePath() + " (" + category + ")");
+    }
+
+    _nodeChannels[node->getName()] = result;
+}
+
+// Compile the given node and all nodes upstream of it, visiting them in
+// topological order through an iterative depth-first search.
+void compileUpstream(ProgramBuilder& builder, NodePtr root)
+{
+    class Frame
+    {
+      public:
+        NodePtr node;
+        vector<InputPtr> inputs;
+        size_t nextInput;
+    };
+
+    // Nodes map to false while their upstream nodes are being visited, and
+    // to true once they have been compiled.
+    std::unordered_map<string, bool> visited;
+    vector<Frame> stack;
+    stack.push_back(Frame{ root, root->getInputs(), 0 });
+    visited[root->getName()] = false;
+    while (!stack.empty())
+    {
+        Frame& frame = stack.back();
+        if (frame.nextInput == frame.inputs.size())
+        {
+            builder.compileNode(frame.node);
+            visited[frame.node->getName()] = true;
+            stack.pop_back();
+            continue;
+        }
+        NodePtr upstream = frame.inputs[frame.nextInput++]->getConnectedNode();
+        if (!upstream)
+        {
+            continue;
+        }
+        auto it = visited.find(upstream->getName());
+        if (it == visited.end())
+        {
+            visited[upstream->getName()] = false;
+            stack.push_back(Frame{ upstream, upstream->getInputs(), 0 });
+        }
+        else if (!it->second)
+        {
+            throw ExceptionFoundCycle("Encountered cycle at node: " + upstream->getNamePath());
+        }
+    }
+}
+
+float smoothStep(float x, float low, float high)
+{
+    if (x <= low)
+        return 0.0f;
+    if (x >= high)
+        return 1.0f;
+    float t = (x - low) / (high - low);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+} // anonymous namespace
+
+//
+// SampleBatch methods
+//
+
+size_t SampleBatch::getSampleCount() const
+{
+    return std::max(texcoord.getSampleCount(), std::max(position.getSampleCount(), normal.getSampleCount()));
+}
+
+void SampleBatch::setGrid(size_t width, size_t height)
+{
+    size_t count = width * height;
+    texcoord.resize(count, 2);
+    position.resize(count, 3);
+    normal.resize(count, 3);
+    for (size_t y = 0; y < height; y++)
+    {
+        float v = 1.0f - ((float) y + 0.5f) / (float) height;
+        for (size_t x = 0; x < width; x++)
+        {
+            float u = ((float) x + 0.5f) / (float) width;
+            size_t sample = y * width + x;
+            texcoord.setValue(sample, 0, u);
+            texcoord.setValue(sample, 1, v);
+            position.setValue(sample, 0, u);
+            position.setValue(sample, 1, v);
+            normal.setValue(sample, 2, 1.0f);
+        }
+    }
+}
+
+//
+// EvalInstruction methods
+//
+
+size_t EvalInstruction::getArgumentCount(Opcode opcode)
+{
+    switch (opcode)
+    {
+        case OpLoad:
+            return 0;
+        case OpAbsolute:
+        case OpFloor:
+        case OpSquareRoot:
+            return 1;
+        case OpAdd:
+        case OpSubtract:
+        case OpMultiply:
+        case OpDivide:
+        case OpModulo:
+        case OpPower:
+        case OpMin:
+        case OpMax:
+        case OpNoise2d:
+        case OpCellNoise2d:
+            return 2;
+        case OpMultiplyAdd:
+        case OpMix:
+        case OpClamp:
+        case OpSmoothStep:
+        case OpNoise3d:
+        case OpCellNoise3d:
+            return 3;
+        case OpSelectLess:
+            return 4;
+    }
+    return 0;
+}
+
+const string& EvalInstruction::getOpcodeName(Opcode opcode)
+{
+    static const string NAMES[] =
+    {
+        "load", "add", "subtract", "multiply", "divide", "modulo", "power", "min", "max",
+        "multiplyadd", "mix", "clamp", "smoothstep", "selectless", "absolute", "floor",
+        "sqrt", "noise2d", "noise3d", "cellnoise2d", "cellnoise3d"
+    };
+    return NAMES[opcode];
+}
+
+string EvalInstruction::asString() const
+{
+    std::ostringstream stream;
+    stream << "r" << dest << " = " << getOpcodeName(opcode);
+    for (size_t i = 0; i < getArgumentCount(opcode); i++)
+    {
+        stream << (i ? ", r" : " r") << args[i];
+    }
+    if (opcode == OpLoad || getArgumentCount(opcode) == 0 ||
+        opcode == OpNoise2d || opcode == OpNoise3d || opcode == OpCellNoise2d || opcode == OpCellNoise3d)
+    {
+        stream << (getArgumentCount(opcode) ? ", #" : " #") << immediate;
+    }
+    return stream.str();
+}
+
+//
+// EvalProgram methods
+//
+
+EvalProgramPtr EvalProgram::compile(OutputPtr output)
+{
+    NodeGraphPtr graph = output->getParent()->asA<NodeGraph>();
+    if (!graph)
+    {
+        throw Exception("Output is not contained in a node graph: " + output->getNamePath());
+    }
+    size_t width = getEvalChannelCount(output->getType());
+    if (!width)
+    {
+        throw Exception("Output type cannot be evaluated: " + output->getNamePath() + " (" + output->getType() + ")");
+    }
+
+    ProgramBuilder builder;
+    Channels outputChannels;
+    NodePtr connected = output->getConnectedNode();
+    if (connected)
+    {
+        compileUpstream(builder, connected);
+        outputChannels = builder.getNodeChannels(connected);
+        if (output->hasChannels())
+        {
+            outputChannels = builder.swizzle(outputChannels, output->getChannels(), width);
+        }
+    }
+    else if (output->hasNodeName())
+    {
+        throw Exception("Invalid port connection: " + output->getNamePath());
+    }
+    else
+    {
+        vector<float> values = getValueChannels(output->getValue());
+        outputChannels = builder.constants(values.empty() ? vector<float>(1, 0.0f) : values);
+    }
+
+    EvalProgramPtr program = std::make_shared<EvalProgram>();
+    program->_type = output->getType();
+    program->assignRegisters(builder.instructions, builder.constantValues, builder.broadcast(outputChannels, width));
+    return program;
+}
+
+EvalProgramPtr EvalProgram::compile(NodePtr node)
+{
+    return compile(node, nullptr);
+}
+
+EvalProgramPtr EvalProgram::compile(NodePtr node, const NodeDefResolver& resolveNodeDef)
+{
+    NodeGraphPtr graph = node->getParent()->asA<NodeGraph>();
+    if (!graph)
+    {
+        throw Exception("Node is not contained in a node graph: " + node->getNamePath());
+    }
+
+    ProgramBuilder builder(resolveNodeDef);
+    compileUpstream(builder, node);
+
+    EvalProgramPtr program = std::make_shared<EvalProgram>();
+    program->_type = node->getType();
+    program->assignRegisters(builder.instructions, builder.constantValues, builder.getNodeChannels(node));
+    return program;
+}
+
+void EvalProgram::assignRegisters(const vector<EvalInstruction>& instructions,
+                                  const vector<float>& constants,
+                                  const vector<unsigned int>& outputChannels)
+{
+    // Remove instructions whose results are never used.
+    std::unordered_set<unsigned int> liveRegisters(outputChannels.begin(), outputChannels.end());
+    vector<EvalInstruction> liveInstructions;
+    for (auto it = instructions.rbegin(); it != instructions.rend(); ++it)
+    {
+        if (liveRegisters.count(it->dest))
+        {
+            for (size_t i = 0; i < EvalInstruction::getArgumentCount(it->opcode); i++)
+            {
+                liveRegisters.insert(it->args[i]);
+            }
+            liveInstructions.push_back(*it);
+        }
+    }
+    std::reverse(liveInstructions.begin(), liveInstructions.end());
+
+    // Find the last instruction reading each temporary register.
+    const size_t OUTPUT_USE = std::numeric_limits<size_t>::max();
+    std::unordered_map<unsigned int, size_t> lastUse;
+    for (size_t i = 0; i < liveInstructions.size(); i++)
+    {
+        const EvalInstruction& instruction = liveInstructions[i];
+        for (size_t j = 0; j < EvalInstruction::getArgumentCount(instruction.opcode); j++)
+        {
+            lastUse[instruction.args[j]] = i;
+        }
+    }
+    for (unsigned int reg : outputChannels)
+    {
+        lastUse[reg] = OUTPUT_USE;
+    }
+
+    // Assign physical registers, placing the constants that are still in use
+    // first and reusing temporary registers once their values are no longer
+    // needed.
+    std::unordered_map<unsigned int, unsigned int> physical;
+    for (size_t i = 0; i < constants.size(); i++)
+    {
+        if (lastUse.count(CONSTANT_FLAG | (unsigned int) i))
+        {
+            physical[CONSTANT_FLAG | (unsigned int) i] = (unsigned int) _constants.size();
+            _constants.push_back(constants[i]);
+        }
+    }
+    unsigned int constantCount = (unsigned int) _constants.size();
+    unsigned int tempCount = 0;
+    vector<unsigned int> freeRegisters;
+    auto mapRegister = [&](unsigned int reg)
+    {
+        return physical.at(reg);
+    };
+    for (size_t i = 0; i < liveInstructions.size(); i++)
+    {
+        EvalInstruction instruction = liveInstructions[i];
+        size_t argCount = EvalInstruction::getArgumentCount(instruction.opcode);
+        for (size_t j = 0; j < argCount; j++)
+        {
+            unsigned int reg = instruction.args[j];
+            instruction.args[j] = mapRegister(reg);
+            if (!(reg & CONSTANT_FLAG) && lastUse[reg] == i &&
+                std::find(instruction.args, instruction.args + j, instruction.args[j]) == instruction.args + j)
+            {
+                freeRegisters.push_back(instruction.args[j]);
+            }
+        }
+        unsigned int dest;
+        if (!freeRegisters.empty())
+        {
+            dest = freeRegisters.back();
+            freeRegisters.pop_back();
+        }
+        else
+        {
+            dest = constantCount + tempCount++;
+        }
+        physical[instruction.dest] = dest;
+        instruction.dest = dest;
+        _instructions.push_back(instruction);
+    }
+    _registerCount = constantCount + tempCount;
+    for (unsigned int reg : outputChannels)
+    {
+        _outputRegisters.push_back(mapRegister(reg));
+    }
+}
+
+bool EvalProgram::isVarying() const
+{
+    for (const EvalInstruction& instruction : _instructions)
+    {
+        if (instruction.opcode == EvalInstruction::OpLoad)
+            return true;
+    }
+    return false;
+}
+
+void EvalProgram::evaluate(const SampleBatch& samples, SampleBuffer& result, const EvalOptions& options) const
+{
+    size_t sampleCount = samples.getSampleCount();
+    for (const EvalInstruction& instruction : _instructions)
+    {
+        if (instruction.opcode != EvalInstruction::OpLoad)
+            continue;
+        const SampleBuffer& stream = instruction.immediate >= STREAM_NORMAL ? samples.normal :
+                                     instruction.immediate >= STREAM_POSITION ? samples.position :
+                                     samples.texcoord;
+        if (stream.getSampleCount() < sampleCount)
+        {
+            throw Exception("Sample stream required by program has too few samples");
+        }
+    }
+
+    result.resize(sampleCount, getChannelCount());
+    size_t tileSize = std::max(options.tileSize, (size_t) 1);
+    size_t tileCount = (sampleCount + tileSize - 1) / tileSize;
+    size_t threadCount = options.threadCount ? options.threadCount : (size_t) std::thread::hardware_concurrency();
+    threadCount = std::max(std::min(threadCount, tileCount), (size_t) 1);
+
+    // Tiles are claimed dynamically, so that threads finishing early take on
+    // the remaining work.
+    std::atomic<size_t> nextTile(0);
+    auto worker = [&]()
+    {
+        vector<float> registers(_registerCount * tileSize);
+        for (size_t i = 0; i < _constants.size(); i++)
+        {
+            std::fill_n(registers.begin() + i * tileSize, tileSize, _constants[i]);
+        }
+        for (size_t tile = nextTile++; tile < tileCount; tile = nextTile++)
+        {
+            size_t begin = tile * tileSize;
+            size_t end = std::min(begin + tileSize, sampleCount);
+            evaluateTile(registers.data(), tileSize, samples, begin, end, result);
+        }
+    };
+
+    vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; i++)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void EvalProgram::evaluateTile(float* registers, size_t tileSize,
+                               const SampleBatch& samples, size_t begin, size_t end,
+                               SampleBuffer& result) const
+{
+    const size_t n = end - begin;
+    for (const EvalInstruction& instruction : _instructions)
+    {
+        float* d = registers + instruction.dest * tileSize;
+        const float* a = registers + instruction.args[0] * tileSize;
+        const float* b = registers + instruction.args[1] * tileSize;
+        const float* c = registers + instruction.args[2] * tileSize;
+        const float* e = registers + instruction.args[3] * tileSize;
+        const uint32_t seed = instruction.immediate;
+
+        switch (instruction.opcode)
+        {
+            case EvalInstruction::OpLoad:
+            {
+                unsigned int channel = instruction.immediate;
+                const float* source = channel >= STREAM_NORMAL ? samples.normal.getChannel(channel - STREAM_NORMAL) :
+                                      channel >= STREAM_POSITION ? samples.position.getChannel(channel - STREAM_POSITION) :
+                                      samples.texcoord.getChannel(channel - STREAM_TEXCOORD);
+                std::copy(source + begin, source + end, d);
+                break;
+            }
+            case EvalInstruction::OpAdd:
+                for (size_t i = 0; i < n; i++) d[i] = a[i] + b[i];
+                break;
+            case EvalInstruction::OpSubtract:
+                for (size_t i = 0; i < n; i++) d[i] = a[i] - b[i];
+                break;
+            case EvalInstruction::OpMultiply:
+                for (size_t i = 0; i < n; i++) d[i] = a[i] * b[i];
+                break;
+            case EvalInstruction::OpDivide:
+                for (size_t i = 0; i < n; i++) d[i] = a[i] / b[i];
+                break;
+            case EvalInstruction::OpModulo:
+                for (size_t i = 0; i < n; i++) d[i] = a[i] - b[i] * std::floor(a[i] / b[i]);
+                break;
+            case EvalInstruction::OpPower:
+                for (size_t i = 0; i < n; i++) d[i] = std::pow(a[i], b[i]);
+                break;
+            case EvalInstruction::OpMin:
+                for (size_t i = 0; i < n; i++) d[i] = a[i] < b[i] ? a[i] : b[i];
+                break;
+            case EvalInstruction::OpMax:
+                for (size_t i = 0; i < n; i++) d[i] = a[i] > b[i] ? a[i] : b[i];
+                break;
+            case EvalInstruction::OpMultiplyAdd:
+                for (size_t i = 0; i < n; i++) d[i] = a[i] * b[i] + c[i];
+                break;
+            case EvalInstruction::OpMix:
+                for (size_t i = 0; i < n; i++) d[i] = b[i] + (a[i] - b[i]) * c[i];
+                break;
+            case EvalInstruction::OpClamp:
+                for (size_t i = 0; i < n; i++)
+                {
+                    float x = a[i] > b[i] ? a[i] : b[i];
+                    d[i] = x < c[i] ? x : c[i];
+                }
+                break;
+            case EvalInstruction::OpSmoothStep:
+                for (size_t i = 0; i < n; i++) d[i] = smoothStep(a[i], b[i], c[i]);
+                break;
+            case EvalInstruction::OpSelectLess:
+                for (size_t i = 0; i < n; i++) d[i] = a[i] < b[i] ? c[i] : e[i];
+                break;
+            case EvalInstruction::OpAbsolute:
+                for (size_t i = 0; i < n; i++) d[i] = std::abs(a[i]);
+                break;
+            case EvalInstruction::OpFloor:
+                for (size_t i = 0; i < n; i++) d[i] = std::floor(a[i]);
+                break;
+            case EvalInstruction::OpSquareRoot:
+                for (size_t i = 0; i < n; i++) d[i] = std::sqrt(a[i]);
+                break;
+            case EvalInstruction::OpNoise2d:
+                for (size_t i = 0; i < n; i++) d[i] = noise2d(a[i], b[i], seed);
+                break;
+            case EvalInstruction::OpNoise3d:
+                for (size_t i = 0; i < n; i++) d[i] = noise3d(a[i], b[i], c[i], seed);
+                break;
+            case EvalInstruction::OpCellNoise2d:
+                for (size_t i = 0; i < n; i++) d[i] = cellNoise2d(a[i], b[i], seed);
+                break;
+            case EvalInstruction::OpCellNoise3d:
+                for (size_t i = 0; i < n; i++) d[i] = cellNoise3d(a[i], b[i], c[i], seed);
+                break;
+        }
+    }
+
+    for (size_t i = 0; i < _outputRegisters.size(); i++)
+    {
+        const float* source = registers + _outputRegisters[i] * tileSize;
+        std::copy(source, source + n, result.getChannel(i) + begin);
+    }
+}
+
+vector<float> EvalProgram::evaluateSample(const vector<float>& texcoord,
+                                          const vector<float>& position,
+                                          const vector<float>& normal) const
+{
+    SampleBatch samples;
+    samples.texcoord.resize(1, 2);
+    samples.position.resize(1, 3);
+    samples.normal.resize(1, 3);
+    for (size_t i = 0; i < texcoord.size() && i < 2; i++)
+        samples.texcoord.setValue(0, i, texcoord[i]);
+    for (size_t i = 0; i < position.size() && i < 3; i++)
+        samples.position.setValue(0, i, position[i]);
+    for (size_t i = 0; i < normal.size() && i < 3; i++)
+        samples.normal.setValue(0, i, normal[i]);
+
+    EvalOptions options;
+    options.threadCount = 1;
+    options.tileSize = 1;
+    SampleBuffer result;
+    evaluate(samples, result, options);
+
+    vector<float> values;
+    for (size_t i = 0; i < result.getChannelCount(); i++)
+    {
+        values.push_back(result.getValue(0, i));
+    }
+    return values;
+}
+
+string EvalProgram::asString() const
+{
+    std::ostringstream stream;
+    for (size_t i = 0; i < _constants.size(); i++)
+    {
+        stream << "r" << i << " = " << _constants[i] << std::endl;
+    }
+    for (const EvalInstruction& instruction : _instructions)
+    {
+        stream << instruction.asString() << std::endl;
+    }
+    stream << "output";
+    for (size_t i = 0; i < _outputRegisters.size(); i++)
+    {
+        stream << (i ? ", r" : " r") << _outputRegisters[i];
+    }
+    stream << std::endl;
+    return stream.str();
+}
+
+//
+// Global functions
+//
+
+size_t getEvalChannelCount(const string& type)
+{
+    static const std::unordered_map<string, size_t> CHANNEL_COUNTS =
+    {
+        { "float", 1 }, { "integer", 1 }, { "boolean", 1 },
+        { "color2", 2 }, { "vector2", 2 },
+        { "color3", 3 }, { "vector3", 3 },
+        { "color4", 4 }, { "vector4", 4 }
+    };
+    auto it = CHANNEL_COUNTS.find(type);
+    return it != CHANNEL_COUNTS.end() ? it->second : 0;
+}
+
+} // namespace MaterialX
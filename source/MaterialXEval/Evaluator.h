@@ -0,0 +1,385 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_EVALUATOR_H
+#define MATERIALX_EVALUATOR_H
+
+/// @file
+/// CPU evaluation of standard library node graphs over batches of samples
+
+#include <MaterialXCore/Node.h>
+
+namespace MaterialX
+{
+
+/// A shared pointer to an EvalProgram
+using EvalProgramPtr = shared_ptr<class EvalProgram>;
+/// A shared pointer to a const EvalProgram
+using ConstEvalProgramPtr = shared_ptr<const class EvalProgram>;
+
+/// A function that returns the nodedef of the given node
+using NodeDefResolver = std::function<NodeDefPtr(ConstNodePtr)>;
+
+/// @class SampleBuffer
+/// A structure-of-arrays buffer of float channels, in which the values of
+/// each channel are stored contiguously for all samples.
+class SampleBuffer
+{
+  public:
+    SampleBuffer(size_t sampleCount = 0, size_t channelCount = 0) :
+        _sampleCount(sampleCount),
+        _channelCount(channelCount),
+        _data(sampleCount * channelCount, 0.0f)
+    {
+    }
+    ~SampleBuffer() { }
+
+    /// Resize the buffer to the given sample and channel counts.  Existing
+    /// values are not preserved.
+    void resize(size_t sampleCount, size_t channelCount)
+    {
+        _sampleCount = sampleCount;
+        _channelCount = channelCount;
+        _data.assign(sampleCount * channelCount, 0.0f);
+    }
+
+    /// Return the number of samples in the buffer.
+    size_t getSampleCount() const
+    {
+        return _sampleCount;
+    }
+
+    /// Return the number of channels in the buffer.
+    size_t getChannelCount() const
+    {
+        return _channelCount;
+    }
+
+    /// Return a pointer to the contiguous values of the given channel.
+    float* getChannel(size_t channel)
+    {
+        return _data.data() + channel * _sampleCount;
+    }
+
+    /// Return a const pointer to the contiguous values of the given channel.
+    const float* getChannel(size_t channel) const
+    {
+        return _data.data() + channel * _sampleCount;
+    }
+
+    /// Return the value of the given channel for the given sample.
+    float getValue(size_t sample, size_t channel) const
+    {
+        return _data[channel * _sampleCount + sample];
+    }
+
+    /// Set the value of the given channel for the given sample.
+    void setValue(size_t sample, size_t channel, float value)
+    {
+        _data[channel * _sampleCount + sample] = value;
+    }
+
+  private:
+    size_t _sampleCount;
+    size_t _channelCount;
+    vector<float> _data;
+};
+
+/// @class SampleBatch
+/// The geometric streams over which an EvalProgram is evaluated.  Each
+/// stream that is required by a program must hold the same number of
+/// samples.
+class SampleBatch
+{
+  public:
+    SampleBatch() :
+        texcoord(0, 2),
+        position(0, 3),
+        normal(0, 3)
+    {
+    }
+    ~SampleBatch() { }
+
+    /// Return the number of samples in the batch, which is the largest
+    /// sample count of its streams.
+    size_t getSampleCount() const;
+
+    /// Fill the texture coordinates of the batch with the pixel centers of
+    /// a regular grid of the given resolution over the unit square, and
+    /// set positions to the matching points on the z = 0 plane, facing
+    /// the positive z axis.  This is suitable for baking a graph to an
+    /// image.
+    void setGrid(size_t width, size_t height);
+
+  public:
+    /// Texture coordinates, as two channels.
+    SampleBuffer texcoord;
+
+    /// Object-space positions, as three channels.
+    SampleBuffer position;
+
+    /// Object-space normals, as three channels.
+    SampleBuffer normal;
+};
+
+/// @class EvalOptions
+/// A set of options controlling the evaluation of an EvalProgram.
+class EvalOptions
+{
+  public:
+    EvalOptions() :
+        threadCount(0),
+        tileSize(256)
+    {
+    }
+    ~EvalOptions() { }
+
+  public:
+    /// The number of worker threads across which tiles are distributed.
+    /// If zero, then the hardware concurrency of the system is used.
+    size_t threadCount;
+
+    /// The number of samples evaluated together by each instruction.
+    /// Each worker thread holds one register file of this width, so the
+    /// tile size trades instruction dispatch overhead against cache use.
+    size_t tileSize;
+};
+
+/// @class EvalInstruction
+/// A single instruction of an EvalProgram, applying a scalar operation to
+/// each sample of a tile.
+class EvalInstruction
+{
+  public:
+    enum Opcode
+    {
+        /// dest = stream channel [immediate]
+        OpLoad = 0,
+        /// dest = arg0 + arg1
+        OpAdd,
+        /// dest = arg0 - arg1
+        OpSubtract,
+        /// dest = arg0 * arg1
+        OpMultiply,
+        /// dest = arg0 / arg1
+        OpDivide,
+        /// dest = arg0 - arg1 * floor(arg0 / arg1)
+        OpModulo,
+        /// dest = pow(arg0, arg1)
+        OpPower,
+        /// dest = min(arg0, arg1)
+        OpMin,
+        /// dest = max(arg0, arg1)
+        OpMax,
+        /// dest = arg0 * arg1 + arg2
+        OpMultiplyAdd,
+        /// dest = arg1 + (arg0 - arg1) * arg2
+        OpMix,
+        /// dest = min(max(arg0, arg1), arg2)
+        OpClamp,
+        /// dest = hermite step of arg0 between arg1 and arg2
+        OpSmoothStep,
+        /// dest = arg0 < arg1 ? arg2 : arg3
+        OpSelectLess,
+        /// dest = abs(arg0)
+        OpAbsolute,
+        /// dest = floor(arg0)
+        OpFloor,
+        /// dest = sqrt(arg0)
+        OpSquareRoot,
+        /// dest = noise2d(arg0, arg1, seed [immediate])
+        OpNoise2d,
+        /// dest = noise3d(arg0, arg1, arg2, seed [immediate])
+        OpNoise3d,
+        /// dest = cellNoise2d(arg0, arg1, seed [immediate])
+        OpCellNoise2d,
+        /// dest = cellNoise3d(arg0, arg1, arg2, seed [immediate])
+        OpCellNoise3d
+    };
+
+  public:
+    EvalInstruction(Opcode op = OpAdd,
+                    unsigned int dst = 0,
+                    unsigned int arg0 = 0,
+                    unsigned int arg1 = 0,
+                    unsigned int arg2 = 0,
+                    unsigned int arg3 = 0,
+                    unsigned int imm = 0) :
+        opcode(op),
+        dest(dst),
+        args{ arg0, arg1, arg2, arg3 },
+        immediate(imm)
+    {
+    }
+    ~EvalInstruction() { }
+
+    /// Return the number of register arguments read by the given opcode.
+    static size_t getArgumentCount(Opcode opcode);
+
+    /// Return the name of the given opcode.
+    static const string& getOpcodeName(Opcode opcode);
+
+    /// Return a single-line description of this instruction.
+    string asString() const;
+
+  public:
+    /// The operation applied by the instruction.
+    Opcode opcode;
+
+    /// The register to which results are written.
+    unsigned int dest;
+
+    /// The registers from which arguments are read.
+    unsigned int args[4];
+
+    /// An integer operand, used as a stream channel index for loads and as
+    /// a seed for noise operations.
+    unsigned int immediate;
+};
+
+/// @class EvalProgram
+/// A node graph output compiled to a flat sequence of scalar instructions,
+/// which may be evaluated efficiently over large batches of samples.
+///
+/// Each channel of each node is assigned its own register, so vector and
+/// color operations are expanded to independent operations per channel,
+/// and each register holds the values of one channel for a full tile of
+/// samples.  Instructions are therefore simple loops over contiguous
+/// arrays, which compilers vectorize to SIMD instructions.  Constant values
+/// occupy the lowest registers of the program and are initialized once per
+/// worker thread, while the remaining registers are reused as soon as their
+/// values are no longer needed.
+///
+/// Programs are immutable once compiled, and may be evaluated concurrently
+/// from multiple threads.
+/// @sa SampleBatch
+class EvalProgram
+{
+  public:
+    EvalProgram() :
+        _registerCount(0)
+    {
+    }
+    ~EvalProgram() { }
+
+    /// Compile the given output of a node graph, including all nodes
+    /// upstream of it, to a new program.
+    ///
+    /// The math, adjustment, compositing, channel, conditional and procedural
+    /// nodes of the standard library are supported.  Geometric texcoord,
+    /// position and normal nodes read the streams of the evaluated batch,
+    /// while other geometric and application nodes return the default values
+    /// of their nodedefs.  Parameters are treated as constants, and node
+    /// inputs without connections or values fall back to the values and
+    /// default geometric properties of their nodedefs.
+    /// @throws Exception if the graph contains a node without a matching
+    ///    nodedef, a node category that cannot be evaluated, or a value
+    ///    type that is not a float, vector or color.
+    static EvalProgramPtr compile(OutputPtr output);
+
+    /// Compile the output of the given node within a node graph, including
+    /// all nodes upstream of it, to a new program.
+    /// @throws Exception under the same conditions as compiling an output.
+    static EvalProgramPtr compile(NodePtr node);
+
+    /// Compile the output of the given node within a node graph, resolving
+    /// the nodedefs of the node and of the nodes upstream of it through the
+    /// given function rather than through document queries.  This allows
+    /// callers that edit a graph between compilations to reuse nodedefs
+    /// they have already resolved.
+    /// @throws Exception under the same conditions as compiling an output,
+    ///    or if the function returns no nodedef for a node.
+    static EvalProgramPtr compile(NodePtr node, const NodeDefResolver& resolveNodeDef);
+
+    /// Return true if the program reads any stream of the sample batch, and
+    /// false if it evaluates to the same values for every sample.
+    bool isVarying() const;
+
+    /// Evaluate the program over the given batch of samples, writing the
+    /// channels of the output to the given buffer, which is resized as
+    /// needed.  Tiles of samples are distributed across worker threads.
+    /// @throws Exception if a stream required by the program has fewer
+    ///    samples than the batch.
+    void evaluate(const SampleBatch& samples,
+                  SampleBuffer& result,
+                  const EvalOptions& options = EvalOptions()) const;
+
+    /// Evaluate the program for a single sample, returning the values of
+    /// its output channels.  This is intended for testing and debugging,
+    /// rather than for bulk evaluation.
+    vector<float> evaluateSample(const vector<float>& texcoord,
+                                 const vector<float>& position = vector<float>(),
+                                 const vector<float>& normal = vector<float>()) const;
+
+    /// @name Accessors
+    /// @{
+
+    /// Return the output type of the program.
+    const string& getType() const
+    {
+        return _type;
+    }
+
+    /// Return the number of output channels of the program.
+    size_t getChannelCount() const
+    {
+        return _outputRegisters.size();
+    }
+
+    /// Return the instructions of the program.
+    const vector<EvalInstruction>& getInstructions() const
+    {
+        return _instructions;
+    }
+
+    /// Return the values of the constant registers of the program, which
+    /// occupy the lowest register indices.
+    const vector<float>& getConstants() const
+    {
+        return _constants;
+    }
+
+    /// Return the total number of registers, including constants, required
+    /// to evaluate the program.
+    size_t getRegisterCount() const
+    {
+        return _registerCount;
+    }
+
+    /// Return the registers holding the output channels of the program.
+    const vector<unsigned int>& getOutputRegisters() const
+    {
+        return _outputRegisters;
+    }
+
+    /// Return a multi-line listing of the constants and instructions of the
+    /// program.
+    string asString() const;
+
+    /// @}
+
+  private:
+    void assignRegisters(const vector<EvalInstruction>& instructions,
+                         const vector<float>& constants,
+                         const vector<unsigned int>& outputChannels);
+    void evaluateTile(float* registers, size_t tileSize,
+                      const SampleBatch& samples, size_t begin, size_t end,
+                      SampleBuffer& result) const;
+
+  private:
+    string _type;
+    vector<EvalInstruction> _instructions;
+    vector<float> _constants;
+    size_t _registerCount;
+    vector<unsigned int> _outputRegisters;
+};
+
+/// Return the number of float channels in values of the given type, or zero
+/// if the type cannot be evaluated by an EvalProgram.
+size_t getEvalChannelCount(const string& type);
+
+} // namespace MaterialX
+
+#endif
@@ -0,0 +1,145 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXEval/Noise.h>
+
+#include <cmath>
+
+namespace MaterialX
+{
+
+namespace {
+
+// Scale factors mapping the theoretical range of each gradient noise onto
+// [-1, 1].
+const float NOISE2D_SCALE = 1.41421356f;
+const float NOISE3D_SCALE = 0.81649658f;
+
+const float HASH_TO_UNIT_FLOAT = 1.0f / 16777216.0f;
+
+uint32_t hashInt(uint32_t x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+uint32_t hashLattice(int x, int y, uint32_t seed)
+{
+    return hashInt((uint32_t) x + hashInt((uint32_t) y + hashInt(seed)));
+}
+
+uint32_t hashLattice(int x, int y, int z, uint32_t seed)
+{
+    return hashInt((uint32_t) x + hashInt((uint32_t) y + hashInt((uint32_t) z + hashInt(seed))));
+}
+
+float fade(float t)
+{
+    return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+float lerp(float a, float b, float t)
+{
+    return a + (b - a) * t;
+}
+
+// Return the dot product of the given offset with one of eight unit
+// gradients selected by the hash.
+float gradient(uint32_t hash, float x, float y)
+{
+    const float DIAGONAL = 0.70710678f;
+    switch (hash & 7)
+    {
+        case 0: return x;
+        case 1: return -x;
+        case 2: return y;
+        case 3: return -y;
+        case 4: return (x + y) * DIAGONAL;
+        case 5: return (x - y) * DIAGONAL;
+        case 6: return (y - x) * DIAGONAL;
+        default: return (-x - y) * DIAGONAL;
+    }
+}
+
+// Return the dot product of the given offset with one of the twelve cube
+// edge gradients of improved Perlin noise, selected by the hash.
+float gradient(uint32_t hash, float x, float y, float z)
+{
+    uint32_t h = hash & 15;
+    float u = h < 8 ? x : y;
+    float v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+    return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+}
+
+} // anonymous namespace
+
+//
+// Global functions
+//
+
+float noise2d(float x, float y, uint32_t seed)
+{
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+    int ix = (int) fx;
+    int iy = (int) fy;
+    float rx = x - fx;
+    float ry = y - fy;
+
+    float n00 = gradient(hashLattice(ix, iy, seed), rx, ry);
+    float n10 = gradient(hashLattice(ix + 1, iy, seed), rx - 1.0f, ry);
+    float n01 = gradient(hashLattice(ix, iy + 1, seed), rx, ry - 1.0f);
+    float n11 = gradient(hashLattice(ix + 1, iy + 1, seed), rx - 1.0f, ry - 1.0f);
+
+    float u = fade(rx);
+    float v = fade(ry);
+    return lerp(lerp(n00, n10, u), lerp(n01, n11, u), v) * NOISE2D_SCALE;
+}
+
+float noise3d(float x, float y, float z, uint32_t seed)
+{
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+    float fz = std::floor(z);
+    int ix = (int) fx;
+    int iy = (int) fy;
+    int iz = (int) fz;
+    float rx = x - fx;
+    float ry = y - fy;
+    float rz = z - fz;
+
+    float n000 = gradient(hashLattice(ix, iy, iz, seed), rx, ry, rz);
+    float n100 = gradient(hashLattice(ix + 1, iy, iz, seed), rx - 1.0f, ry, rz);
+    float n010 = gradient(hashLattice(ix, iy + 1, iz, seed), rx, ry - 1.0f, rz);
+    float n110 = gradient(hashLattice(ix + 1, iy + 1, iz, seed), rx - 1.0f, ry - 1.0f, rz);
+    float n001 = gradient(hashLattice(ix, iy, iz + 1, seed), rx, ry, rz - 1.0f);
+    float n101 = gradient(hashLattice(ix + 1, iy, iz + 1, seed), rx - 1.0f, ry, rz - 1.0f);
+    float n011 = gradient(hashLattice(ix, iy + 1, iz + 1, seed), rx, ry - 1.0f, rz - 1.0f);
+    float n111 = gradient(hashLattice(ix + 1, iy + 1, iz + 1, seed), rx - 1.0f, ry - 1.0f, rz - 1.0f);
+
+    float u = fade(rx);
+    float v = fade(ry);
+    float w = fade(rz);
+    return lerp(lerp(lerp(n000, n100, u), lerp(n010, n110, u), v),
+                lerp(lerp(n001, n101, u), lerp(n011, n111, u), v), w) * NOISE3D_SCALE;
+}
+
+float cellNoise2d(float x, float y, uint32_t seed)
+{
+    uint32_t hash = hashLattice((int) std::floor(x), (int) std::floor(y), seed);
+    return (float) (hash >> 8) * HASH_TO_UNIT_FLOAT;
+}
+
+float cellNoise3d(float x, float y, float z, uint32_t seed)
+{
+    uint32_t hash = hashLattice((int) std::floor(x), (int) std::floor(y), (int) std::floor(z), seed);
+    return (float) (hash >> 8) * HASH_TO_UNIT_FLOAT;
+}
+
+} // namespace MaterialX
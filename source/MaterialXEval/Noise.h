@@ -0,0 +1,37 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_NOISE_H
+#define MATERIALX_NOISE_H
+
+/// @file
+/// Procedural noise functions for CPU evaluation
+
+#include <MaterialXCore/Library.h>
+
+#include <cstdint>
+
+namespace MaterialX
+{
+
+/// Return two-dimensional gradient noise at the given coordinates, in the
+/// range [-1, 1].  Distinct seeds produce uncorrelated noise fields.
+float noise2d(float x, float y, uint32_t seed = 0);
+
+/// Return three-dimensional gradient noise at the given coordinates, in the
+/// range [-1, 1].  Distinct seeds produce uncorrelated noise fields.
+float noise3d(float x, float y, float z, uint32_t seed = 0);
+
+/// Return a value in the range [0, 1) that is constant within each unit
+/// cell of the two-dimensional integer lattice.
+float cellNoise2d(float x, float y, uint32_t seed = 0);
+
+/// Return a value in the range [0, 1) that is constant within each unit
+/// cell of the three-dimensional integer lattice.
+float cellNoise3d(float x, float y, float z, uint32_t seed = 0);
+
+} // namespace MaterialX
+
+#endif
@@ -0,0 +1,474 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXEval/Optimizer.h>
+
+#include <MaterialXEval/Evaluator.h>
+
+#include <MaterialXCore/Document.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace MaterialX
+{
+
+namespace {
+
+const string CONSTANT_CATEGORY = "constant";
+const string NODE_CATEGORY_ATTRIBUTE = "nodecategory";
+const string DEFAULT_GEOM_PROP_ATTRIBUTE = "defaultgeomprop";
+
+// Node categories of the standard library whose values depend on the
+// renderer, and which are therefore never folded.
+const std::unordered_set<string> VARYING_NODE_CATEGORIES = { "geometric", "application", "texture" };
+
+bool isConstantNode(NodePtr node)
+{
+    return node && node->getCategory() == CONSTANT_CATEGORY;
+}
+
+bool hasInterfaceBinding(NodePtr node)
+{
+    for (ElementPtr child : node->getChildren())
+    {
+        ValueElementPtr port = child->asA<ValueElement>();
+        if (port && port->hasInterfaceName())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool hasConstantInputs(NodePtr node)
+{
+    for (InputPtr input : node->childrenOfType<Input>())
+    {
+        if (input->hasNodeName() && !isConstantNode(input->getConnectedNode()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Format a float with the default precision of value strings where that
+// is exact, and with full precision otherwise.
+string formatFloat(float value)
+{
+    std::ostringstream stream;
+    stream << value;
+    if (std::strtof(stream.str().c_str(), nullptr) != value)
+    {
+        stream.str(EMPTY_STRING);
+        stream << std::setprecision(9) << value;
+    }
+    return stream.str();
+}
+
+string formatValue(const vector<float>& values, const string& type)
+{
+    if (type == "integer")
+    {
+        return std::to_string((int) std::round(values[0]));
+    }
+    if (type == "boolean")
+    {
+        return values[0] != 0.0f ? VALUE_STRING_TRUE : VALUE_STRING_FALSE;
+    }
+    string result;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        result += (i ? ", " : "") + formatFloat(values[i]);
+    }
+    return result;
+}
+
+// Return the value string of the named port of a node, if the port is
+// constant, or an empty string otherwise.  Values of connected constant
+// nodes are returned unless the connection has a channel swizzle.
+string getConstantPortValue(NodePtr node, NodeDefPtr nodeDef, const string& name)
+{
+    ValueElementPtr port = node->getChildOfType<ValueElement>(name);
+    if (port && port->hasInterfaceName())
+    {
+        return EMPTY_STRING;
+    }
+    InputPtr input = port ? port->asA<Input>() : InputPtr();
+    if (input && input->hasNodeName())
+    {
+        NodePtr upstream = input->getConnectedNode();
+        if (!isConstantNode(upstream) || input->hasChannels())
+        {
+            return EMPTY_STRING;
+        }
+        return upstream->getParameterValueString("value");
+    }
+    if (port && port->hasValueString())
+    {
+        return port->getValueString();
+    }
+    ValueElementPtr declaration = nodeDef->getChildOfType<ValueElement>(name);
+    if (declaration && declaration->hasValueString())
+    {
+        return declaration->getValueString();
+    }
+    return EMPTY_STRING;
+}
+
+// Replace the contents of a node with a constant parameter, retaining its
+// name and type.
+void convertToConstant(NodePtr node, const string& value)
+{
+    node->removeChildren([](ElementPtr) { return true; });
+    node->setCategory(CONSTANT_CATEGORY);
+    node->addParameter("value", node->getType())->setValueString(value);
+}
+
+// Return the name of the input selected by a switch or compare node, or an
+// empty string if the selection is not constant.
+string getSelectedInput(NodePtr node, NodeDefPtr nodeDef)
+{
+    if (node->getCategory() == "switch")
+    {
+        ValuePtr which = Value::createValueFromStrings(getConstantPortValue(node, nodeDef, "which"), "float");
+        float index = which ? which->asA<float>() : 0.0f;
+        return "in" + std::to_string(std::min(std::max((int) std::floor(index), 0), 4) + 1);
+    }
+    ValuePtr intest = Value::createValueFromStrings(getConstantPortValue(node, nodeDef, "intest"), "float");
+    ValuePtr cutoff = Value::createValueFromStrings(getConstantPortValue(node, nodeDef, "cutoff"), "float");
+    if (!intest)
+    {
+        return EMPTY_STRING;
+    }
+    return intest->asA<float>() <= (cutoff ? cutoff->asA<float>() : 0.0f) ? "in1" : "in2";
+}
+
+// Map each node name to the ports of the given graph that reference it.
+std::unordered_map<string, vector<PortElementPtr>> getDownstreamPortMap(NodeGraphPtr nodeGraph, const vector<NodePtr>& nodes)
+{
+    std::unordered_map<string, vector<PortElementPtr>> downstreamPorts;
+    for (NodePtr node : nodes)
+    {
+        for (InputPtr input : node->childrenOfType<Input>())
+        {
+            if (input->hasNodeName())
+            {
+                downstreamPorts[input->getNodeName()].push_back(input);
+            }
+        }
+    }
+    for (OutputPtr output : nodeGraph->childrenOfType<Output>())
+    {
+        if (output->hasNodeName())
+        {
+            downstreamPorts[output->getNodeName()].push_back(output);
+        }
+    }
+    return downstreamPorts;
+}
+
+// Bypass a switch or compare node with a constant selection, returning true
+// if the node was modified.  The given downstream ports of the node are
+// reconnected to its selected input.
+bool collapseConditional(NodePtr node, NodeDefPtr nodeDef, bool canFold, const vector<PortElementPtr>& downstreamPorts)
+{
+    string selected = getSelectedInput(node, nodeDef);
+    if (selected.empty())
+    {
+        return false;
+    }
+
+    InputPtr input = node->getInput(selected);
+    if (input && input->hasNodeName())
+    {
+        NodePtr upstream = input->getConnectedNode();
+        if (!upstream || input->hasChannels() || input->hasInterfaceName())
+        {
+            return false;
+        }
+        for (PortElementPtr port : downstreamPorts)
+        {
+            port->setNodeName(upstream->getName());
+        }
+        return true;
+    }
+
+    string value = getConstantPortValue(node, nodeDef, selected);
+    ValueElementPtr declaration = nodeDef->getChildOfType<ValueElement>(selected);
+    if (!canFold || (input && input->hasInterfaceName()) ||
+        (value.empty() && declaration && declaration->hasAttribute(DEFAULT_GEOM_PROP_ATTRIBUTE)))
+    {
+        return false;
+    }
+    if (value.empty())
+    {
+        value = formatValue(vector<float>(std::max(getEvalChannelCount(node->getType()), (size_t) 1), 0.0f), node->getType());
+    }
+    convertToConstant(node, value);
+    return true;
+}
+
+// Replace a node with its evaluated value if it is constant, returning true
+// if the node was modified.  Nodedefs are resolved through the given
+// function, since queries against the document would rebuild its caches
+// after each edit.
+bool foldNode(NodePtr node, NodeDefPtr nodeDef, const NodeDefResolver& resolveNodeDef)
+{
+    if (!hasConstantInputs(node) || hasInterfaceBinding(node) ||
+        VARYING_NODE_CATEGORIES.count(nodeDef->getAttribute(NODE_CATEGORY_ATTRIBUTE)))
+    {
+        return false;
+    }
+
+    EvalProgramPtr program;
+    try
+    {
+        program = EvalProgram::compile(node, resolveNodeDef);
+    }
+    catch (Exception&)
+    {
+        return false;
+    }
+    if (program->isVarying())
+    {
+        return false;
+    }
+    convertToConstant(node, formatValue(program->evaluateSample(vector<float>()), node->getType()));
+    return true;
+}
+
+uint64_t combineHash(uint64_t hash, uint64_t value)
+{
+    return (hash ^ value) * 1099511628211ull;
+}
+
+// Return a hash of the category, attributes and ports of a node, which is
+// independent of its name and of the order of its ports.
+uint64_t getNodeHash(NodePtr node)
+{
+    std::hash<string> hashString;
+    uint64_t hash = combineHash(14695981039346656037ull, hashString(node->getCategory()));
+    for (const string& attr : node->getAttributeNames())
+    {
+        hash = combineHash(hash, hashString(attr));
+        hash = combineHash(hash, hashString(node->getAttribute(attr)));
+    }
+    vector<std::pair<string, uint64_t>> ports;
+    for (ElementPtr child : node->getChildren())
+    {
+        ports.emplace_back(child->getName(), child->getContentHash());
+    }
+    std::sort(ports.begin(), ports.end());
+    for (const auto& port : ports)
+    {
+        hash = combineHash(hash, port.second);
+    }
+    return hash;
+}
+
+bool isEquivalentNode(NodePtr node, NodePtr other)
+{
+    if (node->getCategory() != other->getCategory() ||
+        node->getAttributeNames().size() != other->getAttributeNames().size() ||
+        node->getChildren().size() != other->getChildren().size())
+    {
+        return false;
+    }
+    for (const string& attr : node->getAttributeNames())
+    {
+        if (!other->hasAttribute(attr) || other->getAttribute(attr) != node->getAttribute(attr))
+        {
+            return false;
+        }
+    }
+    for (ElementPtr child : node->getChildren())
+    {
+        ElementPtr otherChild = other->getChild(child->getName());
+        if (!otherChild || *otherChild != *child)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Merge nodes that are equivalent to a node earlier in the given
+// topological order, returning the number of merged nodes.
+size_t eliminateCommonSubexpressions(NodeGraphPtr nodeGraph, const vector<NodePtr>& nodes)
+{
+    std::unordered_map<string, vector<PortElementPtr>> downstreamPorts = getDownstreamPortMap(nodeGraph, nodes);
+
+    size_t mergedCount = 0;
+    std::unordered_map<uint64_t, vector<NodePtr>> uniqueNodes;
+    for (NodePtr node : nodes)
+    {
+        vector<NodePtr>& candidates = uniqueNodes[getNodeHash(node)];
+        NodePtr match;
+        for (NodePtr candidate : candidates)
+        {
+            if (isEquivalentNode(node, candidate))
+            {
+                match = candidate;
+                break;
+            }
+        }
+        if (!match)
+        {
+            candidates.push_back(node);
+            continue;
+        }
+
+        // Reconnect the downstream ports of the duplicate node, so that the
+        // nodes that reference it hash identically in turn.
+        vector<PortElementPtr>& ports = downstreamPorts[node->getName()];
+        vector<PortElementPtr>& matchPorts = downstreamPorts[match->getName()];
+        for (PortElementPtr port : ports)
+        {
+            port->setNodeName(match->getName());
+            matchPorts.push_back(port);
+        }
+        downstreamPorts.erase(node->getName());
+        nodeGraph->removeNode(node->getName());
+        mergedCount++;
+    }
+    return mergedCount;
+}
+
+} // anonymous namespace
+
+//
+// Global functions
+//
+
+OptimizerStats optimizeNodeGraph(NodeGraphPtr nodeGraph, const OptimizerOptions& options)
+{
+    OptimizerStats stats;
+    stats.nodeCount = nodeGraph->getNodes().size();
+
+    // Collect the nodedefs of the constant nodes that may be created.
+    std::unordered_map<string, NodeDefPtr> constantNodeDefs;
+    for (NodeDefPtr nodeDef : nodeGraph->getDocument()->getMatchingNodeDefs(CONSTANT_CATEGORY))
+    {
+        constantNodeDefs.insert({ nodeDef->getType(), nodeDef });
+    }
+
+    // Order nodes from upstream to downstream.
+    vector<NodePtr> nodes;
+    if (options.foldConstants || options.collapseConditionals || options.eliminateCommonSubexpressions)
+    {
+        vector<ElementPtr> order = nodeGraph->topologicalSort();
+        for (auto it = order.rbegin(); it != order.rend(); ++it)
+        {
+            NodePtr node = (*it)->asA<Node>();
+            if (node)
+            {
+                nodes.push_back(node);
+            }
+        }
+    }
+
+    // Fold constants and collapse conditionals.
+    if (options.foldConstants || options.collapseConditionals)
+    {
+        // Resolve nodedefs and downstream ports before the graph is modified,
+        // since each edit invalidates the caches of the document.  Folding
+        // does not change the signatures of downstream nodes, and the nodes
+        // that reference a node are visited after it in topological order,
+        // so neither needs to be queried again as the graph is edited.
+        vector<NodeDefPtr> nodeDefs = nodeGraph->getDocument()->getNodeDefsForNodes(nodes);
+        std::unordered_map<string, NodeDefPtr> nodeDefMap;
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            nodeDefMap[nodes[i]->getName()] = nodeDefs[i];
+        }
+        NodeDefResolver resolveNodeDef = [&nodeDefMap](ConstNodePtr node)
+        {
+            auto it = nodeDefMap.find(node->getName());
+            return it != nodeDefMap.end() ? it->second : node->getReferencedNodeDef();
+        };
+        std::unordered_map<string, vector<PortElementPtr>> downstreamPorts = getDownstreamPortMap(nodeGraph, nodes);
+
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            NodePtr node = nodes[i];
+            NodeDefPtr nodeDef = nodeDefs[i];
+            if (isConstantNode(node) || !nodeDef)
+            {
+                continue;
+            }
+            auto constantNodeDef = constantNodeDefs.find(node->getType());
+            bool canFold = options.foldConstants && constantNodeDef != constantNodeDefs.end();
+            const string& category = node->getCategory();
+            if (options.collapseConditionals && (category == "switch" || category == "compare") &&
+                collapseConditional(node, nodeDef, canFold, downstreamPorts[node->getName()]))
+            {
+                stats.collapsedConditionals++;
+            }
+            else if (canFold && foldNode(node, nodeDef, resolveNodeDef))
+            {
+                stats.foldedNodes++;
+            }
+            else
+            {
+                continue;
+            }
+            if (isConstantNode(node))
+            {
+                nodeDefMap[node->getName()] = constantNodeDef->second;
+            }
+        }
+    }
+
+    // Merge equivalent nodes.  Bypassing conditionals preserves the
+    // topological order, so the order computed above remains valid.
+    if (options.eliminateCommonSubexpressions)
+    {
+        stats.mergedNodes = eliminateCommonSubexpressions(nodeGraph, nodes);
+    }
+
+    // Remove nodes that are not upstream of any output.
+    vector<OutputPtr> outputs = nodeGraph->getOutputs();
+    if (options.removeDeadNodes && !outputs.empty())
+    {
+        std::unordered_set<string> liveNodes;
+        vector<NodePtr> stack;
+        for (OutputPtr output : outputs)
+        {
+            NodePtr node = output->getConnectedNode();
+            if (node && liveNodes.insert(node->getName()).second)
+            {
+                stack.push_back(node);
+            }
+        }
+        while (!stack.empty())
+        {
+            NodePtr node = stack.back();
+            stack.pop_back();
+            for (InputPtr input : node->childrenOfType<Input>())
+            {
+                NodePtr upstream = input->getConnectedNode();
+                if (upstream && liveNodes.insert(upstream->getName()).second)
+                {
+                    stack.push_back(upstream);
+                }
+            }
+        }
+        stats.removedNodes += nodeGraph->removeChildren([&liveNodes](ElementPtr child)
+        {
+            return child->isA<Node>() && !liveNodes.count(child->getName());
+        });
+    }
+
+    return stats;
+}
+
+} // namespace MaterialX
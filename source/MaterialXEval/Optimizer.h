@@ -0,0 +1,106 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_OPTIMIZER_H
+#define MATERIALX_OPTIMIZER_H
+
+/// @file
+/// Simplification passes over node graphs
+
+#include <MaterialXCore/Node.h>
+
+namespace MaterialX
+{
+
+/// @class OptimizerOptions
+/// A set of options selecting the passes applied by optimizeNodeGraph.
+class OptimizerOptions
+{
+  public:
+    OptimizerOptions() :
+        foldConstants(true),
+        collapseConditionals(true),
+        eliminateCommonSubexpressions(true),
+        removeDeadNodes(true)
+    {
+    }
+    ~OptimizerOptions() { }
+
+  public:
+    /// If true, then nodes whose inputs are all constant are replaced with
+    /// constant nodes holding their evaluated values.
+    bool foldConstants;
+
+    /// If true, then switch nodes, and compare nodes with constant test
+    /// inputs, are replaced by the inputs that they select.
+    bool collapseConditionals;
+
+    /// If true, then nodes with the same category, attributes and ports as
+    /// an upstream-equivalent node are merged into that node.
+    bool eliminateCommonSubexpressions;
+
+    /// If true, then nodes that are not upstream of any output of the graph
+    /// are removed.  Graphs without outputs are left unchanged.
+    bool removeDeadNodes;
+};
+
+/// @class OptimizerStats
+/// Statistics describing the changes made by optimizeNodeGraph.
+class OptimizerStats
+{
+  public:
+    OptimizerStats() :
+        nodeCount(0),
+        foldedNodes(0),
+        collapsedConditionals(0),
+        mergedNodes(0),
+        removedNodes(0)
+    {
+    }
+    ~OptimizerStats() { }
+
+  public:
+    /// The number of nodes in the graph before optimization.
+    size_t nodeCount;
+
+    /// The number of nodes replaced with constant nodes.
+    size_t foldedNodes;
+
+    /// The number of switch and compare nodes that were bypassed or
+    /// replaced with constant nodes.
+    size_t collapsedConditionals;
+
+    /// The number of duplicate nodes merged into equivalent nodes.
+    size_t mergedNodes;
+
+    /// The number of unused nodes removed from the graph, not including
+    /// merged nodes.
+    size_t removedNodes;
+};
+
+/// Simplify the given node graph in place, without changing the values of
+/// its outputs.
+///
+/// Nodes are visited in topological order, so that folding a node may allow
+/// the nodes downstream of it to be folded in turn.  A node is folded when
+/// all of its connected inputs are constant nodes, none of its ports are
+/// bound to the graph interface, and it evaluates to the same value for
+/// every sample, using the semantics of EvalProgram.  Geometric,
+/// application and texture nodes are never folded.  Folded nodes retain
+/// their names, so downstream connections are unaffected.
+///
+/// Common subexpressions are then eliminated in the same order, hashing each
+/// node by its category, attributes and ports, where connected ports refer
+/// to upstream nodes that have already been merged.  Duplicate nodes are
+/// removed, and their downstream ports are reconnected to the first
+/// equivalent node.
+/// @param nodeGraph The node graph to optimize.
+/// @param options The passes to apply.
+/// @return Statistics describing the changes made.
+OptimizerStats optimizeNodeGraph(NodeGraphPtr nodeGraph, const OptimizerOptions& options = OptimizerOptions());
+
+} // namespace MaterialX
+
+#endif
@@ -9,12 +9,19 @@
 
 #include <MaterialXFormat/PugiXML/pugixml.hpp>
 
+#include <MaterialXCore/Instrumentation.h>
 #include <MaterialXCore/Types.h>
 #include <MaterialXCore/Util.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <string.h>
+#include <thread>
 
 using namespace pugi;
 
@@ -27,6 +34,9 @@ const string NAME_ATTRIBUTE = "name";
 const string SOURCE_URI_ATTRIBUTE = "__sourceUri";
 const string XINCLUDE_TAG = "xi:include";
 
+// A function called with the name of each file read into a document.
+using FileReadCallback = std::function<void(const string&)>;
+
 void elementFromXml(const xml_node& xmlNode, ElementPtr elem)
 {
     // Store attributes in element.
@@ -61,21 +71,22 @@ void elementFromXml(const xml_node& xmlNode, ElementPtr elem)
     }
 }
 
-void elementToXml(ConstElementPtr elem, xml_node& xmlNode, bool writeXIncludes, const ElementPredicate& predicate)
+void elementToXml(ConstElementPtr elem, xml_node& xmlNode, bool writeXIncludes, const ElementPredicate& predicate);
+
+void xincludeToXml(xml_node& xmlNode, const string& sourceUri, StringSet& writtenSourceFiles)
 {
-    // Store attributes in XML.
-    if (!elem->getName().empty())
+    if (!writtenSourceFiles.count(sourceUri))
     {
-        xmlNode.append_attribute(NAME_ATTRIBUTE.c_str()) = elem->getName().c_str();
-    }
-    for (const string& attrName : elem->getAttributeNames())
-    {
-        xml_attribute xmlAttr = xmlNode.append_attribute(attrName.c_str());
-        xmlAttr.set_value(elem->getAttribute(attrName).c_str());
+        xml_node includeNode = xmlNode.append_child(XINCLUDE_TAG.c_str());
+        xml_attribute includeAttr = includeNode.append_attribute("href");
+        includeAttr.set_value(sourceUri.c_str());
+        writtenSourceFiles.insert(sourceUri);
     }
+}
 
-    // Create child nodes and recurse.
-    StringSet writtenSourceFiles;
+void childrenToXml(ConstElementPtr elem, xml_node& xmlNode, bool writeXIncludes, const ElementPredicate& predicate,
+                   StringSet& writtenSourceFiles)
+{
     for (ElementPtr child : elem->getChildren())
     {
         if (writeXIncludes && child->hasSourceUri())
@@ -83,13 +94,7 @@ void elementToXml(ConstElementPtr elem, xml_node& xmlNode, bool writeXIncludes,
             string sourceUri = child->getSourceUri();
             if (sourceUri != elem->getDocument()->getSourceUri())
             {
-                if (!writtenSourceFiles.count(sourceUri))
-                {
-                    xml_node includeNode = xmlNode.append_child(XINCLUDE_TAG.c_str());
-                    xml_attribute includeAttr = includeNode.append_attribute("href");
-                    includeAttr.set_value(sourceUri.c_str());
-                    writtenSourceFiles.insert(sourceUri);
-                }
+                xincludeToXml(xmlNode, sourceUri, writtenSourceFiles);
                 continue;
             }
         }
@@ -102,14 +107,67 @@ void elementToXml(ConstElementPtr elem, xml_node& xmlNode, bool writeXIncludes,
     }
 }
 
-void xmlDocumentFromFile(xml_document& xmlDoc, string filename, const string& searchPath)
+// Write the libraries referenced by the given document, either as XIncludes
+// of their source URIs or, for libraries without source URIs or when
+// XIncludes are disabled, as explicit data.
+void librariesToXml(ConstDocumentPtr doc, xml_node& xmlNode, bool writeXIncludes, const ElementPredicate& predicate,
+                    StringSet& writtenSourceFiles, std::set<ConstDocumentPtr>& writtenLibraries)
+{
+    for (ConstDocumentPtr library : doc->getReferencedLibraries())
+    {
+        if (!writtenLibraries.insert(library).second)
+        {
+            continue;
+        }
+        if (writeXIncludes && library->hasSourceUri())
+        {
+            xincludeToXml(xmlNode, library->getSourceUri(), writtenSourceFiles);
+            continue;
+        }
+        librariesToXml(library, xmlNode, writeXIncludes, predicate, writtenSourceFiles, writtenLibraries);
+        childrenToXml(library, xmlNode, writeXIncludes, predicate, writtenSourceFiles);
+    }
+}
+
+void elementToXml(ConstElementPtr elem, xml_node& xmlNode, bool writeXIncludes, const ElementPredicate& predicate)
+{
+    // Store attributes in XML.
+    if (!elem->getName().empty())
+    {
+        xmlNode.append_attribute(NAME_ATTRIBUTE.c_str()) = elem->getName().c_str();
+    }
+    for (const string& attrName : elem->getAttributeNames())
+    {
+        xml_attribute xmlAttr = xmlNode.append_attribute(attrName.c_str());
+        xmlAttr.set_value(elem->getAttribute(attrName).c_str());
+    }
+
+    // Write referenced libraries ahead of the content of a document.
+    StringSet writtenSourceFiles;
+    ConstDocumentPtr doc = elem->asA<Document>();
+    if (doc)
+    {
+        std::set<ConstDocumentPtr> writtenLibraries;
+        librariesToXml(doc, xmlNode, writeXIncludes, predicate, writtenSourceFiles, writtenLibraries);
+    }
+
+    // Create child nodes and recurse.
+    childrenToXml(elem, xmlNode, writeXIncludes, predicate, writtenSourceFiles);
+}
+
+void xmlDocumentFromFile(xml_document& xmlDoc, string filename, const string& searchPath,
+                         const char* timerName = "xml/parse")
 {
     if (!searchPath.empty())
     {
         filename = FileSearchPath(searchPath).find(filename);
     }
 
-    xml_parse_result result = xmlDoc.load_file(filename.c_str());
+    xml_parse_result result;
+    {
+        ScopedTimer timer(timerName);
+        result = xmlDoc.load_file(filename.c_str());
+    }
     if (!result)
     {
         if (result.status == xml_parse_status::status_file_not_found ||
@@ -125,7 +183,21 @@ void xmlDocumentFromFile(xml_document& xmlDoc, string filename, const string& se
     }
 }
 
-void processXIncludes(xml_node& xmlNode, const string& searchPath, bool readXIncludes)
+size_t countXIncludes(const xml_node& xmlNode)
+{
+    size_t count = 0;
+    for (const xml_node& xmlChild : xmlNode.children())
+    {
+        if (xmlChild.name() == XINCLUDE_TAG)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+void processXIncludes(xml_node& xmlNode, const string& searchPath, bool readXIncludes,
+                      const FileReadCallback& onFileRead)
 {
     xml_node xmlChild = xmlNode.first_child();
     while (xmlChild)
@@ -137,8 +209,14 @@ void processXIncludes(xml_node& xmlNode, const string& searchPath, bool readXInc
                 xml_attribute fileAttr = xmlChild.attribute("href");
                 string filename = fileAttr.value();
 
+                // Included files are timed separately, since their parse
+                // time is already part of the enclosing xml/xinclude timer.
                 xml_document xmlDoc;
-                xmlDocumentFromFile(xmlDoc, filename, searchPath);
+                xmlDocumentFromFile(xmlDoc, filename, searchPath, "xml/xinclude/parse");
+                if (onFileRead)
+                {
+                    onFileRead(filename);
+                }
 
                 xml_node xmlRoot = xmlDoc.child("materialx");
                 for (const xml_node& sourceChild : xmlRoot.children())
@@ -164,7 +242,8 @@ void processXIncludes(xml_node& xmlNode, const string& searchPath, bool readXInc
 void documentFromXml(DocumentPtr doc,
                      const xml_document& xmlDoc,
                      const string& searchPath = EMPTY_STRING,
-                     bool readXIncludes = false)
+                     bool readXIncludes = false,
+                     const FileReadCallback& onFileRead = FileReadCallback())
 {
     ScopedUpdate update(doc);
     doc->onRead();
@@ -172,13 +251,92 @@ void documentFromXml(DocumentPtr doc,
     xml_node xmlRoot = xmlDoc.child(Document::CATEGORY.c_str());
     if (xmlRoot)
     {
-        processXIncludes(xmlRoot, searchPath, readXIncludes);
-        elementFromXml(xmlRoot, doc);
+        {
+            ScopedTimer timer("xml/xinclude");
+            processXIncludes(xmlRoot, searchPath, readXIncludes, onFileRead);
+        }
+        {
+            ScopedTimer timer("xml/elements");
+            elementFromXml(xmlRoot, doc);
+        }
     }
 
     doc->upgradeVersion();
 }
 
+// A pool of threads running queued loads, which is started on first use
+// and joined at exit.  Loads still queued at exit are abandoned.
+class LoadThreadPool
+{
+  public:
+    LoadThreadPool() :
+        _stopping(false)
+    {
+    }
+    ~LoadThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _condition.notify_all();
+        for (std::thread& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    static LoadThreadPool& get()
+    {
+        static LoadThreadPool pool;
+        return pool;
+    }
+
+    void submit(const std::function<void()>& job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_threads.empty())
+            {
+                size_t threadCount = std::max((size_t) std::thread::hardware_concurrency(), (size_t) 1);
+                for (size_t i = 0; i < threadCount; i++)
+                {
+                    _threads.emplace_back(&LoadThreadPool::run, this);
+                }
+            }
+            _jobs.push_back(job);
+        }
+        _condition.notify_one();
+    }
+
+  private:
+    void run()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this]() { return _stopping || !_jobs.empty(); });
+                if (_stopping)
+                {
+                    return;
+                }
+                job = _jobs.front();
+                _jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+  private:
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::function<void()>> _jobs;
+    vector<std::thread> _threads;
+    bool _stopping;
+};
+
 } // anonymous namespace
 
 //
@@ -187,8 +345,13 @@ void documentFromXml(DocumentPtr doc,
 
 void readFromXmlBuffer(DocumentPtr doc, const char* buffer)
 {
+    ScopedTimer timer("readFromXmlBuffer");
     xml_document xmlDoc;
-    xml_parse_result result = xmlDoc.load_string(buffer);
+    xml_parse_result result;
+    {
+        ScopedTimer parseTimer("xml/parse");
+        result = xmlDoc.load_string(buffer);
+    }
     if (!result)
     {
         throw ExceptionParseError("Parse error in readFromXmlBuffer");
@@ -199,8 +362,13 @@ void readFromXmlBuffer(DocumentPtr doc, const char* buffer)
 
 void readFromXmlStream(DocumentPtr doc, std::istream& stream)
 {
+    ScopedTimer timer("readFromXmlStream");
     xml_document xmlDoc;
-    xml_parse_result result = xmlDoc.load(stream);
+    xml_parse_result result;
+    {
+        ScopedTimer parseTimer("xml/parse");
+        result = xmlDoc.load(stream);
+    }
     if (!result)
     {
         throw ExceptionParseError("Parse error in readFromXmlStream");
@@ -211,6 +379,7 @@ void readFromXmlStream(DocumentPtr doc, std::istream& stream)
 
 void readFromXmlFile(DocumentPtr doc, const string& filename, const string& searchPath, bool readXIncludes)
 {
+    ScopedTimer timer("readFromXmlFile");
     xml_document xmlDoc;
     xmlDocumentFromFile(xmlDoc, filename, searchPath);
 
@@ -224,6 +393,89 @@ void readFromXmlString(DocumentPtr doc, const string& str)
     readFromXmlStream(doc, stream);
 }
 
+//
+// Asynchronous reading
+//
+
+XmlLoadTaskPtr readFromXmlFileAsync(const string& filename, const XmlLoadOptions& options)
+{
+    XmlLoadTaskPtr task = std::make_shared<XmlLoadTask>(filename);
+    LoadThreadPool::get().submit([task, options]()
+    {
+        auto checkCancelled = [&task]()
+        {
+            if (task->isCancelled())
+            {
+                throw ExceptionLoadCancelled("Cancelled load of file: " + task->getFilename());
+            }
+        };
+
+        try
+        {
+            ScopedTimer timer("readFromXmlFileAsync");
+            checkCancelled();
+            xml_document xmlDoc;
+            xmlDocumentFromFile(xmlDoc, task->getFilename(), options.searchPath);
+
+            // Report the requested file along with each included file.
+            size_t fileCount = 1;
+            if (options.readXIncludes)
+            {
+                fileCount += countXIncludes(xmlDoc.child(Document::CATEGORY.c_str()));
+            }
+            size_t filesRead = 0;
+            FileReadCallback onFileRead = [&](const string& readFilename)
+            {
+                checkCancelled();
+                filesRead++;
+                if (options.progress)
+                {
+                    options.progress(readFilename, filesRead, fileCount);
+                }
+            };
+            onFileRead(task->getFilename());
+
+            DocumentPtr doc = createDocument();
+            documentFromXml(doc, xmlDoc, options.searchPath, options.readXIncludes, onFileRead);
+            doc->setSourceUri(task->getFilename());
+
+            checkCancelled();
+            string message;
+            if (options.validate && !doc->validate(&message))
+            {
+                throw Exception("Validation failed for file: " + task->getFilename() + "\n" + message);
+            }
+
+            checkCancelled();
+            if (options.index)
+            {
+                // Lookups build the document cache as a side effect.
+                doc->getMatchingNodeDefs(EMPTY_STRING);
+            }
+
+            task->_promise.set_value(doc);
+        }
+        catch (...)
+        {
+            task->_promise.set_exception(std::current_exception());
+        }
+
+        // An exception escaping a pool thread would terminate the process,
+        // and the result of the load has already been delivered.
+        if (options.complete)
+        {
+            try
+            {
+                options.complete(task);
+            }
+            catch (...)
+            {
+            }
+        }
+    });
+    return task;
+}
+
 //
 // Writing
 //
@@ -13,9 +13,77 @@
 
 #include <MaterialXCore/Document.h>
 
+#include <atomic>
+#include <functional>
+#include <future>
+
 namespace MaterialX
 {
 
+class XmlLoadTask;
+
+/// A shared pointer to an XmlLoadTask
+using XmlLoadTaskPtr = shared_ptr<XmlLoadTask>;
+
+/// A function reporting the progress of an asynchronous load, called once
+/// for the requested file and once for each XInclude that is read.
+/// @param filename The file that has been read.
+/// @param filesRead The number of files read so far, including this one.
+/// @param fileCount The total number of files to be read.
+using XmlLoadProgressCallback = std::function<void(const string& filename, size_t filesRead, size_t fileCount)>;
+
+/// A function called when an asynchronous load has completed, successfully
+/// or not.  The result of the load is available through the given task.
+using XmlLoadCompleteCallback = std::function<void(XmlLoadTaskPtr task)>;
+
+/// @class XmlLoadOptions
+/// A set of options controlling the behavior of asynchronous loads.
+/// @sa readFromXmlFileAsync
+class XmlLoadOptions
+{
+  public:
+    XmlLoadOptions() :
+        readXIncludes(true),
+        validate(false),
+        index(false)
+    {
+    }
+    ~XmlLoadOptions() { }
+
+  public:
+    /// A semicolon-separated sequence of file paths, which will be applied
+    /// in order when searching for the given file and its includes.
+    string searchPath;
+
+    /// If true, XInclude references will be read from disk and included in
+    /// the document.  Defaults to true.
+    bool readXIncludes;
+
+    /// If true, the loaded document is validated, and the load fails if it
+    /// is invalid.  Defaults to false.
+    bool validate;
+
+    /// If true, the document cache is built before the load completes, so
+    /// that the first lookup on the loaded document does not pay for it.
+    /// Defaults to false.
+    bool index;
+
+    /// If provided, this function is called on the loading thread as each
+    /// file is read.
+    XmlLoadProgressCallback progress;
+
+    /// If provided, this function is called on the loading thread once the
+    /// result of the load is available.
+    ///
+    /// The result is made available before the function is called, so that
+    /// the function may access it, and a thread waiting on the task may
+    /// therefore resume before the function has run or returned.  Any state
+    /// referenced by the function must outlive its call, and callers that
+    /// depend on its effects should synchronize with the function itself.
+    /// Exceptions thrown by the function are caught and ignored.
+    XmlLoadCompleteCallback complete;
+};
+
 /// @name Reading
 /// @{
 
@@ -59,8 +127,9 @@ void readFromXmlString(DocumentPtr doc, const string& str);
 /// Write a document as XML to the given output stream.
 /// @param doc The document to be written.
 /// @param stream The output stream to which data is written
-/// @param writeXIncludes If true, elements with source file markings will be written
-///    as XIncludes rather than explicit data.  Defaults to true.
+/// @param writeXIncludes If true, elements with source file markings, and referenced
+///    libraries with source URIs, will be written as XIncludes rather than explicit
+///    data.  Defaults to true.
 /// @param predicate If provided, this function will be used to exclude specific elements
 ///    (those returning false) from the write operation.
 void writeToXmlStream(DocumentPtr doc, std::ostream& stream, bool writeXIncludes = true,
@@ -69,8 +138,9 @@ void writeToXmlStream(DocumentPtr doc, std::ostream& stream, bool writeXIncludes
 /// Write a document as XML to the given filename.
 /// @param doc The document to be written.
 /// @param filename The filename to which data is written
-/// @param writeXIncludes If true, elements with source file markings will be written
-///    as XIncludes rather than explicit data.  Defaults to true.
+/// @param writeXIncludes If true, elements with source file markings, and referenced
+///    libraries with source URIs, will be written as XIncludes rather than explicit
+///    data.  Defaults to true.
 /// @param predicate If provided, this function will be used to exclude specific elements
 ///    (those returning false) from the write operation.
 void writeToXmlFile(DocumentPtr doc, const string& filename, bool writeXIncludes = true,
@@ -78,8 +148,9 @@ void writeToXmlFile(DocumentPtr doc, const string& filename, bool writeXIncludes
 
 /// Write a document as XML to a new string, returned by value.
 /// @param doc The document to be written.
-/// @param writeXIncludes If true, elements with source file markings will be written
-///    as XIncludes rather than explicit data.  Defaults to true.
+/// @param writeXIncludes If true, elements with source file markings, and referenced
+///    libraries with source URIs, will be written as XIncludes rather than explicit
+///    data.  Defaults to true.
 /// @param predicate If provided, this function will be used to exclude specific elements
 ///    (those returning false) from the write operation.
 /// @return The output string, returned by value
@@ -138,6 +209,109 @@ class ExceptionFileMissing : public Exception
     }
 };
 
+/// @class @ExceptionLoadCancelled
+/// An exception that is thrown when an asynchronous load is cancelled.
+class ExceptionLoadCancelled : public Exception
+{
+  public:
+    ExceptionLoadCancelled(const string& msg) :
+        Exception(msg)
+    {
+    }
+
+    ExceptionLoadCancelled(const ExceptionLoadCancelled& e) :
+        Exception(e)
+    {
+    }
+
+    virtual ~ExceptionLoadCancelled() throw()
+    {
+    }
+};
+
+/// @class XmlLoadTask
+/// The state of an asynchronous document load, giving access to its result
+/// and allowing it to be cancelled.
+/// @sa readFromXmlFileAsync
+class XmlLoadTask
+{
+  public:
+    XmlLoadTask(const string& filename) :
+        _filename(filename),
+        _future(_promise.get_future().share()),
+        _cancelled(false)
+    {
+    }
+    ~XmlLoadTask() { }
+
+    /// Return the filename of the requested document.
+    const string& getFilename() const
+    {
+        return _filename;
+    }
+
+    /// Return a future holding the loaded document, or the exception that
+    /// caused the load to fail.
+    std::shared_future<DocumentPtr> getFuture() const
+    {
+        return _future;
+    }
+
+    /// Wait for the load to complete, and return the loaded document.
+    /// @throws Exception if the load failed or was cancelled.
+    DocumentPtr get() const
+    {
+        return _future.get();
+    }
+
+    /// Return true if the load has completed, successfully or not.
+    bool isReady() const
+    {
+        return _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    /// Request cancellation of the load.  A load that has not yet completed
+    /// stops at its next file or processing stage, and its future then holds
+    /// an ExceptionLoadCancelled.
+    void cancel()
+    {
+        _cancelled = true;
+    }
+
+    /// Return true if cancellation of the load has been requested.
+    bool isCancelled() const
+    {
+        return _cancelled;
+    }
+
+  private:
+    friend XmlLoadTaskPtr readFromXmlFileAsync(const string& filename, const XmlLoadOptions& options);
+
+    string _filename;
+    std::promise<DocumentPtr> _promise;
+    std::shared_future<DocumentPtr> _future;
+    std::atomic<bool> _cancelled;
+};
+
+/// @name Asynchronous Reading
+/// @{
+
+/// Read a document as XML from the given filename on a background thread.
+///
+/// The file is read, its XIncludes are resolved, and the document is
+/// upgraded to the current version, as in readFromXmlFile.  The document is
+/// then validated and its cache built, if requested.  Loads are run by an
+/// internal pool of threads, and the returned task gives access to the
+/// result as a future.  A loaded document is owned by the caller, and is not
+/// accessed by the pool once the load has completed.
+/// @param filename The filename from which data is read.
+/// @param options The options of the load.
+/// @return A task representing the load, which may be used to wait for its
+///    result or to cancel it.
+XmlLoadTaskPtr readFromXmlFileAsync(const string& filename, const XmlLoadOptions& options = XmlLoadOptions());
+
+/// @}
+
 } // namespace MaterialX
 
 #endif
@@ -0,0 +1,248 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXGenerator/Generator.h>
+
+#include <random>
+
+namespace MaterialX
+{
+
+namespace {
+
+const string SHADER_NODE_DEF_NAME = "ND_generated_surface";
+const string SHADER_NODE_STRING = "generated_surface";
+const string SHADER_TYPE_STRING = "surfaceshader";
+
+// A random number generator whose results are identical across platforms.
+// The standard distributions are implementation-defined, so values are
+// derived directly from the engine.
+class RandomGenerator
+{
+  public:
+    explicit RandomGenerator(unsigned int seed) :
+        _engine(seed)
+    {
+    }
+
+    // Return a random index in the range [0, count).
+    size_t getIndex(size_t count)
+    {
+        return (size_t) (_engine() % count);
+    }
+
+    // Return a random float in the range [0, 1).
+    float getFloat()
+    {
+        return (float) (_engine() >> 8) / 16777216.0f;
+    }
+
+  private:
+    std::mt19937 _engine;
+};
+
+// A library nodedef from which graph nodes are drawn, along with its inputs
+// that may be connected to upstream nodes.
+class NodeTemplate
+{
+  public:
+    NodeDefPtr nodeDef;
+    vector<InputPtr> linkableInputs;
+};
+
+string getGeomPath(size_t index)
+{
+    return "/scene/group" + std::to_string(index / 100 + 1) + "/mesh" + std::to_string(index + 1);
+}
+
+void generateNodeGraph(NodeGraphPtr graph,
+                       const vector<NodeTemplate>& sourceTemplates,
+                       const vector<NodeTemplate>& filterTemplates,
+                       const GeneratorOptions& options,
+                       RandomGenerator& random)
+{
+    size_t nodeCount = options.nodesPerGraph;
+    size_t depth = std::max<size_t>(std::min(options.graphDepth, nodeCount), 1);
+    vector<vector<NodePtr>> layers(depth);
+    vector<NodePtr> upstreamNodes;
+
+    for (size_t i = 0; i < nodeCount; i++)
+    {
+        size_t layer = i * depth / nodeCount;
+        if (layer > 0 && layers[layer].empty())
+        {
+            upstreamNodes.insert(upstreamNodes.end(), layers[layer - 1].begin(), layers[layer - 1].end());
+        }
+
+        const vector<NodeTemplate>& templates = layer ? filterTemplates : sourceTemplates;
+        const NodeTemplate& nodeTemplate = templates[random.getIndex(templates.size())];
+        NodeDefPtr nodeDef = nodeTemplate.nodeDef;
+        NodePtr node = graph->addNode(nodeDef->getNode(),
+                                      nodeDef->getNode() + std::to_string(i + 1),
+                                      nodeDef->getType());
+
+        // The first connection is drawn from the previous layer, giving the
+        // graph its requested depth, while further connections may be drawn
+        // from any earlier layer.
+        if (layer > 0)
+        {
+            const vector<NodePtr>& previousLayer = layers[layer - 1];
+            size_t fanIn = std::min(nodeTemplate.linkableInputs.size(), options.maxFanIn);
+            for (size_t j = 0; j < fanIn; j++)
+            {
+                InputPtr defInput = nodeTemplate.linkableInputs[j];
+                NodePtr upstream = j ? upstreamNodes[random.getIndex(upstreamNodes.size())] :
+                                       previousLayer[random.getIndex(previousLayer.size())];
+                node->addInput(defInput->getName(), defInput->getType())->setConnectedNode(upstream);
+            }
+        }
+
+        layers[layer].push_back(node);
+    }
+
+    const vector<NodePtr>& lastLayer = layers[depth - 1];
+    for (size_t i = 0; i < options.outputsPerGraph && !lastLayer.empty(); i++)
+    {
+        OutputPtr output = graph->addOutput("out" + std::to_string(i + 1), options.nodeType);
+        output->setConnectedNode(lastLayer[random.getIndex(lastLayer.size())]);
+    }
+}
+
+} // anonymous namespace
+
+//
+// Global functions
+//
+
+DocumentPtr generateDocument(ConstDocumentPtr library, const GeneratorOptions& options)
+{
+    RandomGenerator random(options.seed);
+    DocumentPtr doc = createDocument();
+    if (options.referenceLibrary)
+    {
+        doc->addReferencedLibrary(library);
+    }
+    else
+    {
+        doc->importLibrary(library);
+    }
+
+    // Gather the library nodedefs of the requested type, separating those
+    // that may only appear as sources from those that accept connections.
+    vector<NodeTemplate> sourceTemplates;
+    vector<NodeTemplate> filterTemplates;
+    for (NodeDefPtr nodeDef : library->getNodeDefs())
+    {
+        if (nodeDef->getType() != options.nodeType || !nodeDef->hasNode())
+        {
+            continue;
+        }
+        NodeTemplate nodeTemplate;
+        nodeTemplate.nodeDef = nodeDef;
+        for (InputPtr input : nodeDef->getInputs())
+        {
+            if (input->getType() == options.nodeType)
+            {
+                nodeTemplate.linkableInputs.push_back(input);
+            }
+        }
+        if (nodeTemplate.linkableInputs.empty())
+        {
+            sourceTemplates.push_back(nodeTemplate);
+        }
+        else
+        {
+            filterTemplates.push_back(nodeTemplate);
+        }
+    }
+    if (filterTemplates.empty() && options.nodeGraphCount && options.nodesPerGraph)
+    {
+        throw Exception("No nodedefs of type '" + options.nodeType + "' in library");
+    }
+    if (sourceTemplates.empty())
+    {
+        sourceTemplates = filterTemplates;
+    }
+
+    // Generate node graphs.
+    vector<OutputPtr> graphOutputs;
+    for (size_t i = 0; i < options.nodeGraphCount && options.nodesPerGraph; i++)
+    {
+        NodeGraphPtr graph = doc->addNodeGraph("nodegraph" + std::to_string(i + 1));
+        generateNodeGraph(graph, sourceTemplates, filterTemplates, options, random);
+        vector<OutputPtr> outputs = graph->getOutputs();
+        graphOutputs.insert(graphOutputs.end(), outputs.begin(), outputs.end());
+    }
+
+    // Generate materials, each of which instantiates a shader nodedef with
+    // one input per binding.
+    vector<MaterialPtr> materials;
+    if (options.materialCount)
+    {
+        NodeDefPtr shaderDef = doc->addNodeDef(SHADER_NODE_DEF_NAME, SHADER_TYPE_STRING, SHADER_NODE_STRING);
+        for (size_t i = 0; i < options.bindingsPerMaterial; i++)
+        {
+            shaderDef->addInput("input" + std::to_string(i + 1), options.nodeType);
+        }
+        shaderDef->addParameter("weight", "float");
+    }
+    for (size_t i = 0; i < options.materialCount; i++)
+    {
+        MaterialPtr material = doc->addMaterial("material" + std::to_string(i + 1));
+        ShaderRefPtr shaderRef = material->addShaderRef("shaderref1", SHADER_NODE_STRING);
+        for (size_t j = 0; j < options.bindingsPerMaterial && !graphOutputs.empty(); j++)
+        {
+            OutputPtr output = graphOutputs[random.getIndex(graphOutputs.size())];
+            BindInputPtr bindInput = shaderRef->addBindInput("input" + std::to_string(j + 1), options.nodeType);
+            bindInput->setNodeGraphString(output->getParent()->getName());
+            bindInput->setOutputString(output->getName());
+        }
+        shaderRef->addBindParam("weight", "float")->setValue(random.getFloat());
+        materials.push_back(material);
+    }
+
+    // Generate geominfos, cycling through a set of common attribute types.
+    for (size_t i = 0; i < options.geomInfoCount; i++)
+    {
+        GeomInfoPtr geomInfo = doc->addGeomInfo("geominfo" + std::to_string(i + 1), getGeomPath(i));
+        for (size_t j = 0; j < options.geomAttrsPerGeomInfo; j++)
+        {
+            string attrName = "attr" + std::to_string(j + 1);
+            switch (j % 4)
+            {
+                case 0:
+                    geomInfo->setGeomAttrValue(attrName, random.getFloat());
+                    break;
+                case 1:
+                    geomInfo->setGeomAttrValue(attrName, (int) random.getIndex(1000));
+                    break;
+                case 2:
+                    geomInfo->setGeomAttrValue(attrName, string("value") + std::to_string(random.getIndex(1000)));
+                    break;
+                default:
+                    geomInfo->setGeomAttrValue(attrName, Color3(random.getFloat(), random.getFloat(), random.getFloat()));
+                    break;
+            }
+        }
+    }
+
+    // Generate looks, with each material assignment targeting its own
+    // geometry path.
+    for (size_t i = 0; i < options.lookCount; i++)
+    {
+        LookPtr look = doc->addLook("look" + std::to_string(i + 1));
+        for (size_t j = 0; j < options.materialAssignsPerLook && !materials.empty(); j++)
+        {
+            MaterialPtr material = materials[random.getIndex(materials.size())];
+            MaterialAssignPtr assign = look->addMaterialAssign("materialassign" + std::to_string(j + 1),
+                                                               material->getName());
+            assign->setGeom(getGeomPath(j));
+        }
+    }
+
+    return doc;
+}
+
+} // namespace MaterialX
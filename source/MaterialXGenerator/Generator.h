@@ -0,0 +1,125 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#ifndef MATERIALX_GENERATOR_H
+#define MATERIALX_GENERATOR_H
+
+/// @file
+/// Synthetic document generation for scale and stress testing
+
+#include <MaterialXCore/Document.h>
+
+namespace MaterialX
+{
+
+/// @class GeneratorOptions
+/// A set of parameters controlling the size and shape of a generated document.
+/// @sa generateDocument
+class GeneratorOptions
+{
+  public:
+    GeneratorOptions() :
+        seed(0),
+        referenceLibrary(false),
+        nodeType("color3"),
+        nodeGraphCount(10),
+        nodesPerGraph(100),
+        graphDepth(10),
+        maxFanIn(2),
+        outputsPerGraph(1),
+        materialCount(10),
+        bindingsPerMaterial(4),
+        lookCount(1),
+        materialAssignsPerLook(1000),
+        geomInfoCount(100),
+        geomAttrsPerGeomInfo(4)
+    {
+    }
+    ~GeneratorOptions() { }
+
+  public:
+    /// The seed of the random number generator.  Generation is deterministic
+    /// for a given seed, library and set of options.
+    unsigned int seed;
+
+    /// If true, the library is referenced by the generated document rather
+    /// than imported into it.
+    /// @sa Document::addReferencedLibrary
+    bool referenceLibrary;
+
+    /// The output type of generated graph nodes, which must match the type
+    /// of one or more nodedefs in the library.
+    string nodeType;
+
+    /// @name Node Graphs
+    /// @{
+
+    /// The number of node graphs to generate.
+    size_t nodeGraphCount;
+
+    /// The number of nodes in each node graph.
+    size_t nodesPerGraph;
+
+    /// The number of layers into which the nodes of each graph are divided.
+    /// Nodes in the first layer have no upstream connections, and each node
+    /// in a later layer is connected to at least one node in the previous
+    /// layer.
+    size_t graphDepth;
+
+    /// The maximum number of connected inputs on each node.
+    size_t maxFanIn;
+
+    /// The number of outputs in each node graph.
+    size_t outputsPerGraph;
+
+    /// @}
+    /// @name Materials
+    /// @{
+
+    /// The number of materials to generate.
+    size_t materialCount;
+
+    /// The number of bind inputs in each material, each of which is bound
+    /// to a randomly chosen node graph output.
+    size_t bindingsPerMaterial;
+
+    /// @}
+    /// @name Looks and Geometry
+    /// @{
+
+    /// The number of looks to generate.
+    size_t lookCount;
+
+    /// The number of material assignments in each look.
+    size_t materialAssignsPerLook;
+
+    /// The number of geominfo elements to generate.
+    size_t geomInfoCount;
+
+    /// The number of geomattr elements in each geominfo.
+    size_t geomAttrsPerGeomInfo;
+
+    /// @}
+};
+
+/// Generate a synthetic document for scale and stress testing.
+///
+/// The given library is imported into or referenced by the new document,
+/// according to GeneratorOptions::referenceLibrary, and the nodes of
+/// each generated graph are drawn from the library nodedefs whose type
+/// matches GeneratorOptions::nodeType.  Materials instantiate a shader
+/// nodedef that is defined within the generated document, binding its
+/// inputs to the outputs of generated graphs.
+/// @param library A document containing the nodedefs from which graph nodes
+///    are drawn, such as the MaterialX standard library.
+/// @param options The parameters of the generated document.
+/// @throws Exception if the library contains no nodedefs of the requested
+///    node type.
+DocumentPtr generateDocument(ConstDocumentPtr library,
+                             const GeneratorOptions& options = GeneratorOptions());
+
+} // namespace MaterialX
+
+#endif
@@ -0,0 +1,114 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXGenerator/Generator.h>
+
+#include <MaterialXFormat/XmlIo.h>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace mx = MaterialX;
+
+namespace {
+
+void printUsage()
+{
+    mx::GeneratorOptions defaults;
+    std::cerr << "Usage: MaterialXGenerate [options] <output.mtlx>\n"
+                 "  --library <file>     Library from which nodes are drawn (default: mx_stdlib_defs.mtlx)\n"
+                 "  --searchPath <path>  Semicolon-separated search path for the library\n"
+                 "  --seed <n>           Random seed (default: " << defaults.seed << ")\n"
+                 "  --type <string>      Output type of graph nodes (default: " << defaults.nodeType << ")\n"
+                 "  --graphs <n>         Number of node graphs (default: " << defaults.nodeGraphCount << ")\n"
+                 "  --nodes <n>          Nodes per graph (default: " << defaults.nodesPerGraph << ")\n"
+                 "  --depth <n>          Layers per graph (default: " << defaults.graphDepth << ")\n"
+                 "  --fanIn <n>          Maximum connected inputs per node (default: " << defaults.maxFanIn << ")\n"
+                 "  --outputs <n>        Outputs per graph (default: " << defaults.outputsPerGraph << ")\n"
+                 "  --materials <n>      Number of materials (default: " << defaults.materialCount << ")\n"
+                 "  --bindings <n>       Bind inputs per material (default: " << defaults.bindingsPerMaterial << ")\n"
+                 "  --looks <n>          Number of looks (default: " << defaults.lookCount << ")\n"
+                 "  --assigns <n>        Material assignments per look (default: " << defaults.materialAssignsPerLook << ")\n"
+                 "  --geomInfos <n>      Number of geominfos (default: " << defaults.geomInfoCount << ")\n"
+                 "  --geomAttrs <n>      Geomattrs per geominfo (default: " << defaults.geomAttrsPerGeomInfo << ")\n";
+}
+
+size_t parseCount(const char* str)
+{
+    return (size_t) std::strtoul(str, nullptr, 10);
+}
+
+} // anonymous namespace
+
+int main(int argc, char* const argv[])
+{
+    mx::GeneratorOptions options;
+    std::string libraryFilename = "mx_stdlib_defs.mtlx";
+    std::string searchPath = "documents/Libraries";
+    std::string outputFilename;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--library" && hasValue)
+            libraryFilename = argv[++i];
+        else if (arg == "--searchPath" && hasValue)
+            searchPath = argv[++i];
+        else if (arg == "--seed" && hasValue)
+            options.seed = (unsigned int) parseCount(argv[++i]);
+        else if (arg == "--type" && hasValue)
+            options.nodeType = argv[++i];
+        else if (arg == "--graphs" && hasValue)
+            options.nodeGraphCount = parseCount(argv[++i]);
+        else if (arg == "--nodes" && hasValue)
+            options.nodesPerGraph = parseCount(argv[++i]);
+        else if (arg == "--depth" && hasValue)
+            options.graphDepth = parseCount(argv[++i]);
+        else if (arg == "--fanIn" && hasValue)
+            options.maxFanIn = parseCount(argv[++i]);
+        else if (arg == "--outputs" && hasValue)
+            options.outputsPerGraph = parseCount(argv[++i]);
+        else if (arg == "--materials" && hasValue)
+            options.materialCount = parseCount(argv[++i]);
+        else if (arg == "--bindings" && hasValue)
+            options.bindingsPerMaterial = parseCount(argv[++i]);
+        else if (arg == "--looks" && hasValue)
+            options.lookCount = parseCount(argv[++i]);
+        else if (arg == "--assigns" && hasValue)
+            options.materialAssignsPerLook = parseCount(argv[++i]);
+        else if (arg == "--geomInfos" && hasValue)
+            options.geomInfoCount = parseCount(argv[++i]);
+        else if (arg == "--geomAttrs" && hasValue)
+            options.geomAttrsPerGeomInfo = parseCount(argv[++i]);
+        else if (arg.compare(0, 2, "--") != 0 && outputFilename.empty())
+            outputFilename = arg;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (outputFilename.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    try
+    {
+        mx::DocumentPtr library = mx::createDocument();
+        mx::readFromXmlFile(library, libraryFilename, searchPath);
+        mx::DocumentPtr doc = mx::generateDocument(library, options);
+        mx::writeToXmlFile(doc, outputFilename);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXTest/Catch/catch.hpp>
+
+#include <MaterialXCore/Columnar.h>
+#include <MaterialXCore/Document.h>
+
+#include <set>
+
+namespace mx = MaterialX;
+
+TEST_CASE("Columnar", "[columnar]")
+{
+    // Create a document.
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    mx::NodePtr constant = nodeGraph->addNode("constant");
+    constant->setParameterValue("value", mx::Color3(0.5f, 0.5f, 0.5f));
+    mx::OutputPtr output = nodeGraph->addOutput();
+    output->setConnectedNode(constant);
+    mx::NodeDefPtr nodeDef = doc->addNodeDef("", "surfaceshader", "simpleSrf");
+    nodeDef->addInput("diffColor", "color3");
+
+    // Export the document to a columnar table.
+    mx::ColumnarTable table = mx::exportColumnarTable(doc);
+    std::vector<mx::ElementPtr> elems;
+    for (mx::ElementPtr elem : doc->traverseTree())
+    {
+        elems.push_back(elem);
+    }
+    REQUIRE(table.getElementCount() == elems.size());
+    REQUIRE(table.elementParents.size() == elems.size());
+    REQUIRE(table.elementCategories.size() == elems.size());
+    REQUIRE(table.elementParents[0] == -1);
+
+    // Verify element rows.
+    size_t attributeCount = 0;
+    for (size_t i = 0; i < elems.size(); i++)
+    {
+        REQUIRE(table.elementNames[i] == elems[i]->getName());
+        REQUIRE(table.categoryDictionary[table.elementCategories[i]] == elems[i]->getCategory());
+        if (i > 0)
+        {
+            REQUIRE(elems[table.elementParents[i]] == elems[i]->getParent());
+        }
+        attributeCount += elems[i]->getAttributeNames().size();
+    }
+
+    // Verify attribute rows.
+    REQUIRE(table.getAttributeCount() == attributeCount);
+    for (size_t i = 0; i < table.getAttributeCount(); i++)
+    {
+        mx::ElementPtr elem = elems[table.attributeElements[i]];
+        const std::string& attrName = table.attributeNameDictionary[table.attributeNames[i]];
+        REQUIRE(elem->getAttribute(attrName) == table.attributeValues[i]);
+    }
+
+    // Verify that dictionaries contain unique entries.
+    REQUIRE(std::set<std::string>(table.categoryDictionary.begin(), table.categoryDictionary.end()).size() ==
+            table.categoryDictionary.size());
+    REQUIRE(std::set<std::string>(table.attributeNameDictionary.begin(), table.attributeNameDictionary.end()).size() ==
+            table.attributeNameDictionary.size());
+
+    // Export a subtree.
+    table = mx::exportColumnarTable(nodeGraph);
+    REQUIRE(table.getElementCount() == 4);
+    REQUIRE(table.elementNames[0] == nodeGraph->getName());
+    REQUIRE(table.elementParents[1] == 0);
+}
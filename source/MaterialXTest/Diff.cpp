@@ -0,0 +1,93 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXTest/Catch/catch.hpp>
+
+#include <MaterialXCore/Diff.h>
+
+#include <MaterialXFormat/XmlIo.h>
+
+namespace mx = MaterialX;
+
+TEST_CASE("Diff and patch", "[diff]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::readFromXmlFile(doc, "MaterialGraphs.mtlx", "documents/Libraries;documents/Examples");
+
+    // Identical documents produce an empty patch.
+    mx::DocumentPtr modified = doc->copy();
+    REQUIRE(mx::diffDocuments(doc, modified).empty());
+
+    // Modify attributes, and add, remove and reorder elements.
+    mx::NodeGraphPtr nodeGraph = modified->getNodeGraphs()[0];
+    mx::NodePtr node = nodeGraph->getNodes()[0];
+    node->setAttribute("custom", "value");
+    node->removeAttribute(mx::Element::TYPE_ATTRIBUTE);
+    node->setType("color3");
+    mx::NodePtr addedNode = nodeGraph->addNode("constant", "addedConstant", "float");
+    addedNode->setParameterValue("value", 0.5f);
+    nodeGraph->setChildIndex(addedNode->getName(), 1);
+    nodeGraph->setChildIndex(nodeGraph->getChildren().back()->getName(), 0);
+    modified->removeMaterial(modified->getMaterials()[0]->getName());
+    modified->addLook("addedLook");
+    modified->setColorSpace("lin_rec709");
+
+    // Replace an element with one of a different category.
+    std::string replacedName = nodeGraph->getNodes().back()->getName();
+    nodeGraph->removeNode(replacedName);
+    nodeGraph->addOutput(replacedName, "float");
+
+    mx::DocumentPatch patch = mx::diffDocuments(doc, modified);
+    REQUIRE(!patch.empty());
+    for (const mx::ElementEdit& edit : patch)
+    {
+        REQUIRE(!edit.asString().empty());
+    }
+
+    // Applying the patch reproduces the modified document.
+    mx::DocumentPtr patched = doc->copy();
+    mx::applyPatch(patched, patch);
+    REQUIRE(*patched == *modified);
+    REQUIRE(mx::diffDocuments(patched, modified).empty());
+
+    // The reverse patch restores the original document.
+    mx::applyPatch(patched, mx::diffDocuments(modified, doc));
+    REQUIRE(*patched == *doc);
+
+    // Added content is copied into the patch, so later edits to the
+    // modified document do not affect it.
+    mx::DocumentPtr snapshot = modified->copy();
+    addedNode->setParameterValue("value", 1.0f);
+    modified->removeLook("addedLook");
+    patched = doc->copy();
+    mx::applyPatch(patched, patch);
+    REQUIRE(*patched == *snapshot);
+    size_t addCount = 0;
+    for (const mx::ElementEdit& edit : patch)
+    {
+        if (edit.type == mx::ElementEdit::TypeAddElement)
+        {
+            REQUIRE(edit.content->getDocument() != modified);
+            addCount++;
+        }
+    }
+    REQUIRE(addCount > 0);
+
+    // Small changes to a large document produce small patches.
+    mx::DocumentPtr lib = mx::createDocument();
+    mx::readFromXmlFile(lib, "mx_stdlib_defs.mtlx", "documents/Libraries");
+    mx::DocumentPtr libModified = lib->copy();
+    libModified->getNodeDefs()[10]->getInputs()[0]->setAttribute("value", "1.0");
+    patch = mx::diffDocuments(lib, libModified);
+    REQUIRE(patch.size() == 1);
+    REQUIRE(patch[0].type == mx::ElementEdit::TypeSetAttribute);
+    REQUIRE(patch[0].path == libModified->getNodeDefs()[10]->getInputs()[0]->getNamePath());
+
+    // Edits addressing missing elements throw an exception.
+    mx::ElementEdit edit;
+    edit.type = mx::ElementEdit::TypeRemoveElement;
+    edit.path = "missing/element";
+    REQUIRE_THROWS_AS(mx::applyPatch(lib, mx::DocumentPatch{ edit }), mx::Exception&);
+}
@@ -6,6 +6,7 @@
 #include <MaterialXTest/Catch/catch.hpp>
 
 #include <MaterialXCore/Document.h>
+#include <MaterialXCore/Observer.h>
 
 namespace mx = MaterialX;
 
@@ -93,3 +94,397 @@ TEST_CASE("Document", "[document]")
     }
     REQUIRE_THROWS_AS(orphan->getDocument(), mx::ExceptionOrphanedElement);    
 }
+
+TEST_CASE("Child names", "[document]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+
+    // Unnamed children are numbered in sequence.
+    for (int i = 1; i <= 100; i++)
+    {
+        REQUIRE(nodeGraph->addNode("add")->getName() == "node" + std::to_string(i));
+    }
+    REQUIRE(nodeGraph->addOutput()->getName() == "output1");
+
+    // Requested names are incremented from their numeric suffix.
+    nodeGraph->addNode("add", "add5");
+    REQUIRE(nodeGraph->createValidChildName("add") == "add");
+    REQUIRE(nodeGraph->createValidChildName("add5") == "add6");
+    REQUIRE(nodeGraph->createValidChildName("add5") == "add6");
+    nodeGraph->addNode("add", "add6");
+    REQUIRE(nodeGraph->createValidChildName("add5") == "add7");
+    REQUIRE(nodeGraph->createValidChildName("node1") == "node101");
+    REQUIRE(nodeGraph->createValidChildName("node 1") == "node_1");
+
+    // Suffixes of removed children are reused once all children are cleared.
+    nodeGraph->removeNode("node50");
+    REQUIRE(nodeGraph->addNode("add")->getName() == "node101");
+    nodeGraph->clearContent();
+    REQUIRE(nodeGraph->addNode("add")->getName() == "node1");
+    REQUIRE(nodeGraph->addNode("add")->getName() == "node2");
+}
+
+TEST_CASE("Child removal", "[document]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    for (int i = 0; i < 10; i++)
+    {
+        nodeGraph->addNode("add", "add" + std::to_string(i));
+    }
+    mx::OutputPtr output = nodeGraph->addOutput("out");
+    output->setConnectedNode(nodeGraph->getNode("add9"));
+
+    // Child indices track insertion, reordering and single removal.
+    REQUIRE(nodeGraph->getChildIndex("add3") == 3);
+    REQUIRE(nodeGraph->getChildIndex("out") == 10);
+    nodeGraph->setChildIndex("out", 0);
+    REQUIRE(nodeGraph->getChildIndex("out") == 0);
+    REQUIRE(nodeGraph->getChildIndex("add3") == 4);
+    nodeGraph->setChildIndex("out", 10);
+    REQUIRE(nodeGraph->getChildIndex("out") == 10);
+    nodeGraph->removeNode("add0");
+    REQUIRE(nodeGraph->getChildIndex("add3") == 2);
+    REQUIRE(nodeGraph->getChildIndex("add0") == -1);
+
+    // Remove the odd nodes in a single batch.
+    uint64_t revision = doc->getRevision();
+    size_t removed = nodeGraph->removeChildren([](mx::ElementPtr child)
+    {
+        return child->isA<mx::Node>() && (child->getName().back() - '0') % 2 == 1;
+    });
+    REQUIRE(removed == 5);
+    REQUIRE(doc->getRevision() == revision + 1);
+    REQUIRE(nodeGraph->getChildren().size() == 5);
+    REQUIRE(!nodeGraph->getNode("add3"));
+    const std::vector<std::string> expected = { "add2", "add4", "add6", "add8", "out" };
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        REQUIRE(nodeGraph->getChildren()[i]->getName() == expected[i]);
+        REQUIRE(nodeGraph->getChildIndex(expected[i]) == (int) i);
+    }
+    REQUIRE(doc->getMatchingPorts("add9").size() == 1);
+    REQUIRE(!output->getConnectedNode());
+
+    // Interface counts are maintained by bulk removal.
+    mx::NodeDefPtr nodeDef = doc->addNodeDef("ND_test", "float", "test");
+    nodeDef->addInput("in1", "float");
+    nodeDef->addInput("in2", "float");
+    nodeDef->addParameter("param1", "float");
+    nodeDef->removeChildren([](mx::ElementPtr child) { return child->getName() != "in2"; });
+    REQUIRE(nodeDef->getInputCount() == 1);
+    REQUIRE(nodeDef->getParameterCount() == 0);
+
+    // An empty batch leaves the document unchanged.
+    revision = doc->getRevision();
+    removed = nodeGraph->removeChildren([](mx::ElementPtr) { return false; });
+    REQUIRE(removed == 0);
+    REQUIRE(doc->getRevision() == revision);
+}
+
+TEST_CASE("Typed child views", "[document]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    nodeGraph->addNode("constant", "constant1");
+    nodeGraph->addOutput("out1");
+    nodeGraph->addNode("add", "add1");
+    nodeGraph->addNode("constant", "constant2");
+    nodeGraph->addOutput("out2");
+
+    // Views visit the same children as the equivalent vectors.
+    std::vector<mx::NodePtr> nodes;
+    for (mx::NodePtr node : nodeGraph->childrenOfType<mx::Node>())
+    {
+        nodes.push_back(node);
+    }
+    REQUIRE(nodes == nodeGraph->getNodes());
+    std::vector<mx::NodePtr> constants;
+    for (mx::NodePtr node : nodeGraph->childrenOfType<mx::Node>("constant"))
+    {
+        constants.push_back(node);
+    }
+    REQUIRE(constants == nodeGraph->getChildrenOfType<mx::Node>("constant"));
+    REQUIRE(constants.size() == 2);
+    mx::ChildView<mx::Output> outputs = nodeGraph->childrenOfType<mx::Output>();
+    REQUIRE(std::distance(outputs.begin(), outputs.end()) == 2);
+    REQUIRE((*outputs.begin())->getName() == "out1");
+
+    // Views with no matching children are empty.
+    REQUIRE(nodeGraph->childrenOfType<mx::Node>("multiply").empty());
+    REQUIRE(doc->childrenOfType<mx::Material>().empty());
+    REQUIRE(!doc->childrenOfType<mx::NodeGraph>().empty());
+}
+
+TEST_CASE("Element ids", "[document]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    REQUIRE(doc->getId() == 0);
+    REQUIRE(doc->getElementById(0) == doc);
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    std::vector<mx::NodePtr> nodes;
+    for (int i = 0; i < 10; i++)
+    {
+        nodes.push_back(nodeGraph->addNode("constant"));
+    }
+
+    // Ids are dense, and map back to their elements.
+    std::vector<bool> seen(doc->getElementIdBound(), false);
+    for (mx::ElementPtr elem : doc->traverseTree())
+    {
+        REQUIRE(elem->getId() < doc->getElementIdBound());
+        REQUIRE(!seen[elem->getId()]);
+        seen[elem->getId()] = true;
+        REQUIRE(doc->getElementById(elem->getId()) == elem);
+    }
+    REQUIRE(doc->getElementIdBound() == 12);
+
+    // Ids are stable under renaming and moving.
+    size_t id = nodes[3]->getId();
+    nodes[3]->setName("renamed");
+    nodes[3]->moveTo(doc->addNodeGraph());
+    REQUIRE(nodes[3]->getId() == id);
+    REQUIRE(doc->getElementById(id) == nodes[3]);
+
+    // Removed subtrees release their ids, which are reused.
+    size_t graphId = nodeGraph->getId();
+    size_t nodeId = nodes[0]->getId();
+    doc->removeNodeGraph(nodeGraph->getName());
+    REQUIRE(nodeGraph->getId() == mx::Element::INVALID_ID);
+    REQUIRE(nodes[0]->getId() == mx::Element::INVALID_ID);
+    REQUIRE(!doc->getElementById(graphId));
+    REQUIRE(!doc->getElementById(nodeId));
+    size_t bound = doc->getElementIdBound();
+    for (int i = 0; i < 10; i++)
+    {
+        doc->addNodeGraph();
+    }
+    REQUIRE(doc->getElementIdBound() == bound);
+    REQUIRE(doc->getElementById(graphId));
+    REQUIRE(!doc->getElementById(doc->getElementIdBound()));
+
+    // Children added to removed elements are not assigned ids, so lookups
+    // remain safe once the removed elements are destroyed.
+    mx::NodePtr detached = nodeGraph->addNode("constant");
+    REQUIRE(detached->getId() == mx::Element::INVALID_ID);
+    REQUIRE(!doc->getElementById(detached->getId()));
+    bound = doc->getElementIdBound();
+    detached.reset();
+    nodeGraph.reset();
+    nodes.clear();
+    for (size_t i = 0; i < bound; i++)
+    {
+        mx::ElementPtr elem = doc->getElementById(i);
+        REQUIRE((!elem || elem->getId() == i));
+    }
+
+    // Elements moved out of a removed subtree are assigned ids.
+    mx::NodeGraphPtr removedGraph = doc->addNodeGraph();
+    mx::NodePtr movedNode = removedGraph->addNode("constant");
+    doc->removeNodeGraph(removedGraph->getName());
+    REQUIRE_THROWS_AS(removedGraph->moveTo(doc), mx::Exception&);
+    movedNode->moveTo(doc->addNodeGraph());
+    REQUIRE(doc->getElementById(movedNode->getId()) == movedNode);
+
+    // Initializing the document restarts its ids.
+    doc->initialize();
+    REQUIRE(doc->getElementIdBound() == 1);
+    REQUIRE(doc->addNodeGraph()->getId() == 1);
+}
+
+TEST_CASE("Rename and move", "[document]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph("graph1");
+    mx::NodePtr constant = nodeGraph->addNode("constant", "constant1", "color3");
+    mx::NodePtr add = nodeGraph->addNode("add", "add1", "color3");
+    add->setConnectedNode("in1", constant);
+    mx::OutputPtr output = nodeGraph->addOutput("out", "color3");
+    output->setConnectedNode(add);
+
+    // Rename a node without updating its connections.
+    constant->setName("constant2");
+    REQUIRE(nodeGraph->getNode("constant2") == constant);
+    REQUIRE(!nodeGraph->getNode("constant1"));
+    REQUIRE(nodeGraph->getChildIndex("constant2") == 0);
+    REQUIRE(!add->getConnectedNode("in1"));
+
+    // Rename a node and its connections.
+    constant->setName("constant1");
+    add->setName("add2", true);
+    REQUIRE(add->getConnectedNode("in1") == constant);
+    REQUIRE(output->getNodeName() == "add2");
+    REQUIRE(output->getConnectedNode() == add);
+    REQUIRE_THROWS_AS(add->setName("constant1"), mx::Exception&);
+    REQUIRE_THROWS_AS(add->setName("invalid name"), mx::Exception&);
+    REQUIRE_THROWS_AS(add->setName("invalid/name"), mx::Exception&);
+    REQUIRE(add->getName() == "add2");
+    REQUIRE(doc->validate());
+
+    // Renaming updates the content hash and document indices.
+    uint64_t hash = nodeGraph->getContentHash();
+    mx::NodeDefPtr nodeDef = doc->addNodeDef("ND_test", "float", "test");
+    REQUIRE(doc->getNodeDef("ND_test"));
+    nodeDef->setName("ND_test2");
+    REQUIRE(!doc->getNodeDef("ND_test"));
+    REQUIRE(doc->getNodeDef("ND_test2") == nodeDef);
+    constant->setName("constant3", true);
+    REQUIRE(nodeGraph->getContentHash() != hash);
+
+    // Move a node into another graph, retaining its identity and content.
+    mx::NodeGraphPtr nodeGraph2 = doc->addNodeGraph("graph2");
+    nodeGraph2->addNode("constant", "constant1", "float");
+    hash = constant->getContentHash();
+    constant->moveTo(nodeGraph2, 0);
+    REQUIRE(constant->getParent() == nodeGraph2);
+    REQUIRE(nodeGraph2->getChildIndex("constant3") == 0);
+    REQUIRE(nodeGraph2->getChildIndex("constant1") == 1);
+    REQUIRE(!nodeGraph->getNode("constant3"));
+    REQUIRE(nodeGraph->getChildIndex("add2") == 0);
+    REQUIRE(constant->getNamePath() == "graph2/constant3");
+    REQUIRE(constant->getContentHash() == hash);
+    REQUIRE(constant->getDocument() == doc);
+
+    // Moving within a parent reorders its children.
+    constant->moveTo(nodeGraph2);
+    REQUIRE(nodeGraph2->getChildIndex("constant3") == 1);
+
+    // Interface counts follow moved children.
+    mx::InputPtr input = nodeDef->addInput("in", "float");
+    mx::NodeDefPtr nodeDef2 = doc->addNodeDef("ND_test3", "float", "test");
+    input->moveTo(nodeDef2);
+    REQUIRE(nodeDef->getInputCount() == 0);
+    REQUIRE(nodeDef2->getInputCount() == 1);
+
+    // Invalid moves are rejected.
+    REQUIRE_THROWS_AS(nodeGraph->moveTo(nodeGraph), mx::Exception&);
+    REQUIRE_THROWS_AS(nodeGraph2->moveTo(constant), mx::Exception&);
+    REQUIRE_THROWS_AS(doc->moveTo(nodeGraph), mx::Exception&);
+    REQUIRE_THROWS_AS(constant->moveTo(nodeGraph, 5), mx::Exception&);
+    REQUIRE_THROWS_AS(constant->moveTo(mx::createDocument()), mx::Exception&);
+    nodeGraph->addNode("constant", "constant3");
+    REQUIRE_THROWS_AS(constant->moveTo(nodeGraph), mx::Exception&);
+    REQUIRE(constant->getParent() == nodeGraph2);
+}
+
+TEST_CASE("Document memory usage", "[document]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::MemoryUsage emptyUsage = doc->getMemoryUsage();
+    REQUIRE(emptyUsage.elementCount == 1);
+    REQUIRE(emptyUsage.categoryCounts["materialx"] == 1);
+    REQUIRE(emptyUsage.getTotalBytes() > 0);
+
+    // Add elements with long names and values, whose string data is stored
+    // on the heap.
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    for (int i = 0; i < 100; i++)
+    {
+        mx::NodePtr node = nodeGraph->addNode("constant", "constant_node_with_a_long_name" + std::to_string(i));
+        node->setParameterValue("value", std::string("a parameter value long enough to require heap storage"));
+    }
+    mx::MemoryUsage usage = doc->getMemoryUsage();
+    REQUIRE(usage.elementCount == 202);
+    REQUIRE(usage.categoryCounts["constant"] == 100);
+    REQUIRE(usage.categoryCounts["parameter"] == 100);
+    REQUIRE(usage.elementBytes > emptyUsage.elementBytes);
+    REQUIRE(usage.attributeBytes > emptyUsage.attributeBytes);
+    REQUIRE(usage.childContainerBytes > emptyUsage.childContainerBytes);
+    REQUIRE(usage.stringBytes > emptyUsage.stringBytes);
+    REQUIRE(usage.getBytesPerElement() > 0.0);
+
+    size_t categoryTotal = 0;
+    for (const auto& pair : usage.categoryBytes)
+    {
+        categoryTotal += pair.second;
+    }
+    REQUIRE(categoryTotal + usage.cacheBytes == usage.getTotalBytes());
+
+    // Element objects are charged at the size of their own subclass.
+    mx::NodePtr node = nodeGraph->getNodes()[0];
+    REQUIRE(doc->getObjectSize() == sizeof(mx::Document));
+    REQUIRE(node->getObjectSize() == sizeof(mx::Node));
+    REQUIRE(node->getObjectSize() > sizeof(mx::Element));
+    REQUIRE(mx::ObservedDocument::createDocument<mx::ObservedDocument>()->getObjectSize() == sizeof(mx::ObservedDocument));
+
+    // The list of referenced libraries is included.
+    size_t childContainerBytes = doc->getMemoryUsage().childContainerBytes;
+    mx::DocumentPtr library = mx::createDocument();
+    doc->addReferencedLibrary(library);
+    REQUIRE(doc->getMemoryUsage().childContainerBytes > childContainerBytes);
+    doc->removeReferencedLibrary(library);
+
+    // Name counters allocated by name generation are included.
+    nodeGraph->createValidChildName(node->getName());
+    REQUIRE(doc->getMemoryUsage().childContainerBytes > usage.childContainerBytes);
+
+    // Populate the document cache.
+    nodeGraph->addOutput()->setConnectedNode(nodeGraph->getNode("constant_node_with_a_long_name0"));
+    size_t emptyCacheBytes = doc->getMemoryUsage().cacheBytes;
+    REQUIRE(doc->getMatchingPorts("constant_node_with_a_long_name0").size() == 1);
+    REQUIRE(doc->getMemoryUsage().cacheBytes > emptyCacheBytes);
+}
+
+TEST_CASE("Content hash", "[document]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph("nodegraph1");
+    mx::NodePtr constant = nodeGraph->addNode("constant");
+    constant->setParameterValue("value", mx::Color3(0.1f, 0.2f, 0.3f));
+    mx::NodePtr image = nodeGraph->addNode("image");
+    nodeGraph->addOutput()->setConnectedNode(image);
+
+    // Equal trees have equal hashes.
+    mx::DocumentPtr doc2 = doc->copy();
+    REQUIRE(doc2->getContentHash() == doc->getContentHash());
+    REQUIRE(*doc2 == *doc);
+
+    // Modifications to descendants are reflected in ancestor hashes.
+    uint64_t docHash = doc->getContentHash();
+    uint64_t graphHash = nodeGraph->getContentHash();
+    constant->setParameterValue("value", mx::Color3(0.4f, 0.5f, 0.6f));
+    REQUIRE(doc->getContentHash() != docHash);
+    REQUIRE(nodeGraph->getContentHash() != graphHash);
+    REQUIRE(*doc2 != *doc);
+    constant->setParameterValue("value", mx::Color3(0.1f, 0.2f, 0.3f));
+    REQUIRE(doc->getContentHash() == docHash);
+    REQUIRE(*doc2 == *doc);
+
+    // Child order, added children and removed attributes all affect the hash.
+    nodeGraph->setChildIndex(image->getName(), 0);
+    REQUIRE(doc->getContentHash() != docHash);
+    nodeGraph->setChildIndex(image->getName(), 1);
+    REQUIRE(doc->getContentHash() == docHash);
+    mx::NodePtr extra = nodeGraph->addNode("add");
+    REQUIRE(doc->getContentHash() != docHash);
+    nodeGraph->removeNode(extra->getName());
+    REQUIRE(doc->getContentHash() == docHash);
+    image->setColorSpace("lin_rec709");
+    REQUIRE(doc->getContentHash() != docHash);
+    image->removeAttribute(mx::Element::COLOR_SPACE_ATTRIBUTE);
+    REQUIRE(doc->getContentHash() == docHash);
+
+    // Deduplicate identical node graphs by hash.
+    for (int i = 0; i < 3; i++)
+    {
+        doc2->addNodeGraph("nodegraph" + std::to_string(i + 2))->copyContentFrom(nodeGraph);
+    }
+    doc2->getNodeGraph("nodegraph4")->getNodes()[0]->setParameterValue("value", 1.0f);
+    std::unordered_map<uint64_t, int> graphCounts;
+    for (mx::NodeGraphPtr graph : doc2->getNodeGraphs())
+    {
+        graphCounts[graph->getContentHash(false)]++;
+    }
+    REQUIRE(graphCounts.size() == 2);
+    REQUIRE(graphCounts[nodeGraph->getContentHash(false)] == 3);
+
+    // Graph names still distinguish the hashes that include them.
+    mx::NodeGraphPtr graph2 = doc2->getNodeGraph("nodegraph2");
+    REQUIRE(graph2->getContentHash() != nodeGraph->getContentHash());
+    REQUIRE(graph2->getContentHash(false) == nodeGraph->getContentHash(false));
+    uint64_t doc2Hash = doc2->getContentHash();
+    graph2->setName("renamedGraph");
+    REQUIRE(graph2->getContentHash(false) == nodeGraph->getContentHash(false));
+    REQUIRE(doc2->getContentHash() != doc2Hash);
+}
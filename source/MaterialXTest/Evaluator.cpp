@@ -0,0 +1,196 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXTest/Catch/catch.hpp>
+
+#include <MaterialXEval/Evaluator.h>
+#include <MaterialXEval/Noise.h>
+
+#include <MaterialXFormat/XmlIo.h>
+
+#include <cmath>
+
+namespace mx = MaterialX;
+
+namespace {
+
+bool isClose(const std::vector<float>& values, const std::vector<float>& expected, float tolerance = 1e-5f)
+{
+    if (values.size() != expected.size())
+        return false;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        if (std::abs(values[i] - expected[i]) > tolerance)
+            return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Evaluate node graphs", "[evaluator]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::readFromXmlFile(doc, "mx_stdlib_defs.mtlx", "documents/Libraries");
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+
+    // Math over texture coordinates.
+    mx::NodePtr texcoord = nodeGraph->addNode("texcoord", "texcoord1", "vector2");
+    mx::NodePtr swizzle = nodeGraph->addNode("swizzle", "swizzle1", "float");
+    swizzle->setConnectedNode("in", texcoord);
+    swizzle->getInput("in")->setType("vector2");
+    swizzle->setParameterValue("channels", std::string("y"));
+    mx::NodePtr multiply = nodeGraph->addNode("multiply", "multiply1", "float");
+    multiply->setConnectedNode("in1", swizzle);
+    multiply->addInput("in2", "float")->setValue(3.0f);
+    mx::NodePtr clamp = nodeGraph->addNode("clamp", "clamp1", "float");
+    clamp->setConnectedNode("in", multiply);
+    clamp->setParameterValue("high", 2.0f);
+    mx::OutputPtr output = nodeGraph->addOutput("out1", "float");
+    output->setConnectedNode(clamp);
+
+    mx::EvalProgramPtr program = mx::EvalProgram::compile(output);
+    REQUIRE(program->getType() == "float");
+    REQUIRE(program->getChannelCount() == 1);
+    REQUIRE(isClose(program->evaluateSample({ 0.9f, 0.25f }), { 0.75f }));
+    REQUIRE(isClose(program->evaluateSample({ 0.1f, 0.9f }), { 2.0f }));
+    REQUIRE(!program->asString().empty());
+
+    // Compositing of colors.
+    mx::NodePtr ramp = nodeGraph->addNode("ramplr", "ramplr1", "color4");
+    ramp->setParameterValue("valuel", mx::Color4(1.0f, 0.0f, 0.0f, 1.0f));
+    ramp->setParameterValue("valuer", mx::Color4(0.0f, 0.0f, 1.0f, 0.0f));
+    mx::NodePtr constant = nodeGraph->addNode("constant", "constant1", "color4");
+    constant->setParameterValue("value", mx::Color4(0.0f, 1.0f, 0.0f, 1.0f));
+    mx::NodePtr over = nodeGraph->addNode("over", "over1", "color4");
+    over->setConnectedNode("fg", ramp);
+    over->setConnectedNode("bg", constant);
+    mx::OutputPtr colorOutput = nodeGraph->addOutput("out2", "color4");
+    colorOutput->setConnectedNode(over);
+
+    program = mx::EvalProgram::compile(colorOutput);
+    REQUIRE(program->getChannelCount() == 4);
+    REQUIRE(isClose(program->evaluateSample({ 0.0f, 0.5f }), { 1.0f, 0.0f, 0.0f, 1.0f }));
+    REQUIRE(isClose(program->evaluateSample({ 0.75f, 0.5f }), { 0.25f, 0.75f, 0.75f, 1.0f }));
+
+    // Port channel swizzles and conditionals.
+    mx::NodePtr compare = nodeGraph->addNode("compare", "compare1", "color4");
+    compare->setConnectedNode("intest", over);
+    compare->getInput("intest")->setType("float");
+    compare->getInput("intest")->setChannels("r");
+    compare->setParameterValue("cutoff", 0.5f);
+    compare->setConnectedNode("in1", constant);
+    compare->setConnectedNode("in2", ramp);
+    colorOutput->setConnectedNode(compare);
+    program = mx::EvalProgram::compile(colorOutput);
+    REQUIRE(isClose(program->evaluateSample({ 0.25f, 0.5f }), { 0.75f, 0.0f, 0.25f, 0.75f }));
+    REQUIRE(isClose(program->evaluateSample({ 0.75f, 0.5f }), { 0.0f, 1.0f, 0.0f, 1.0f }));
+
+    // Unconnected outputs evaluate to their values.
+    mx::OutputPtr valueOutput = nodeGraph->addOutput("out3", "color3");
+    valueOutput->setValue(mx::Color3(0.1f, 0.2f, 0.3f));
+    program = mx::EvalProgram::compile(valueOutput);
+    REQUIRE(program->getInstructions().empty());
+    REQUIRE(isClose(program->evaluateSample({}), { 0.1f, 0.2f, 0.3f }));
+
+    // Nodes without evaluable definitions are rejected.
+    mx::NodePtr image = nodeGraph->addNode("image", "image1", "color3");
+    valueOutput->setConnectedNode(image);
+    REQUIRE_THROWS_AS(mx::EvalProgram::compile(valueOutput), mx::Exception&);
+}
+
+TEST_CASE("Evaluate sample batches", "[evaluator]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::readFromXmlFile(doc, "mx_stdlib_defs.mtlx", "documents/Libraries");
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+
+    // Build a noise pattern with a long chain of adjustments.
+    mx::NodePtr noise = nodeGraph->addNode("noise2d", "noise1", "color3");
+    noise->setParameterValue("amplitude", mx::Vector3(0.5f, 0.5f, 0.5f));
+    noise->setParameterValue("pivot", 0.5f);
+    mx::NodePtr cells = nodeGraph->addNode("cellnoise3d", "cellnoise1", "float");
+    mx::NodePtr previous = noise;
+    for (int i = 0; i < 50; i++)
+    {
+        mx::NodePtr mix = nodeGraph->addNode("mix", mx::EMPTY_STRING, "color3");
+        mix->setConnectedNode("fg", previous);
+        mix->addInput("bg", "color3")->setValue(mx::Color3(0.5f, 0.5f, 0.5f));
+        mix->setConnectedNode("mask", cells);
+        previous = mix;
+    }
+    mx::OutputPtr output = nodeGraph->addOutput("out", "color3");
+    output->setConnectedNode(previous);
+
+    // Registers are reused along the chain.
+    mx::EvalProgramPtr program = mx::EvalProgram::compile(output);
+    REQUIRE(program->getInstructions().size() > 150);
+    REQUIRE(program->getRegisterCount() < 20);
+
+    // Evaluate over an image grid, comparing threaded and serial results.
+    mx::SampleBatch samples;
+    samples.setGrid(64, 48);
+    REQUIRE(samples.getSampleCount() == 64 * 48);
+
+    mx::EvalOptions options;
+    options.threadCount = 1;
+    mx::SampleBuffer serial;
+    program->evaluate(samples, serial, options);
+    REQUIRE(serial.getSampleCount() == 64 * 48);
+    REQUIRE(serial.getChannelCount() == 3);
+
+    options.threadCount = 4;
+    options.tileSize = 100;
+    mx::SampleBuffer threaded;
+    program->evaluate(samples, threaded, options);
+    for (size_t channel = 0; channel < 3; channel++)
+    {
+        for (size_t sample = 0; sample < serial.getSampleCount(); sample++)
+        {
+            REQUIRE(serial.getValue(sample, channel) == threaded.getValue(sample, channel));
+            REQUIRE(serial.getValue(sample, channel) >= 0.0f);
+            REQUIRE(serial.getValue(sample, channel) <= 1.0f);
+        }
+    }
+
+    std::vector<float> texcoord = { samples.texcoord.getValue(100, 0), samples.texcoord.getValue(100, 1) };
+    std::vector<float> position = { samples.position.getValue(100, 0), samples.position.getValue(100, 1), 0.0f };
+    std::vector<float> single = program->evaluateSample(texcoord, position);
+    for (size_t channel = 0; channel < 3; channel++)
+    {
+        REQUIRE(single[channel] == serial.getValue(100, channel));
+    }
+
+    // Streams required by a program must cover the batch.
+    samples.position.resize(10, 3);
+    REQUIRE_THROWS_AS(program->evaluate(samples, serial), mx::Exception&);
+}
+
+TEST_CASE("Noise functions", "[evaluator]")
+{
+    float minValue = 0.0f;
+    float maxValue = 0.0f;
+    for (int i = 0; i < 10000; i++)
+    {
+        float x = (float) (i % 100) * 0.173f - 5.0f;
+        float y = (float) (i / 100) * 0.131f - 5.0f;
+        float n2 = mx::noise2d(x, y);
+        float n3 = mx::noise3d(x, y, x * y);
+        minValue = std::min(minValue, std::min(n2, n3));
+        maxValue = std::max(maxValue, std::max(n2, n3));
+
+        float cell = mx::cellNoise3d(x, y, 0.5f);
+        REQUIRE(cell >= 0.0f);
+        REQUIRE(cell < 1.0f);
+        REQUIRE(cell == mx::cellNoise3d(std::floor(x) + 0.25f, std::floor(y) + 0.75f, 0.0f));
+    }
+    REQUIRE(minValue >= -1.0f);
+    REQUIRE(maxValue <= 1.0f);
+    REQUIRE(maxValue - minValue > 1.0f);
+
+    // Noise vanishes at lattice points, and seeds produce distinct fields.
+    REQUIRE(mx::noise2d(3.0f, -2.0f) == 0.0f);
+    REQUIRE(mx::noise2d(0.5f, 0.5f, 0) != mx::noise2d(0.5f, 0.5f, 1));
+}
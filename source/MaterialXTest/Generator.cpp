@@ -0,0 +1,85 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXTest/Catch/catch.hpp>
+
+#include <MaterialXGenerator/Generator.h>
+
+#include <MaterialXFormat/XmlIo.h>
+
+namespace mx = MaterialX;
+
+TEST_CASE("Generate document", "[generator]")
+{
+    mx::DocumentPtr lib = mx::createDocument();
+    mx::readFromXmlFile(lib, "mx_stdlib_defs.mtlx", "documents/Libraries");
+
+    mx::GeneratorOptions options;
+    options.seed = 7;
+    options.nodeGraphCount = 4;
+    options.nodesPerGraph = 50;
+    options.graphDepth = 5;
+    options.maxFanIn = 2;
+    options.materialCount = 3;
+    options.lookCount = 2;
+    options.materialAssignsPerLook = 20;
+    options.geomInfoCount = 10;
+
+    // Validate the requested document structure.
+    mx::DocumentPtr doc = mx::generateDocument(lib, options);
+    REQUIRE(doc->validate());
+    REQUIRE(doc->getNodeGraphs().size() == 4);
+    REQUIRE(doc->getMaterials().size() == 3);
+    REQUIRE(doc->getLooks().size() == 2);
+    REQUIRE(doc->getGeomInfos().size() == 10);
+    for (mx::NodeGraphPtr graph : doc->getNodeGraphs())
+    {
+        REQUIRE(graph->getNodes().size() == 50);
+        for (mx::NodePtr node : graph->getNodes())
+        {
+            REQUIRE(node->getReferencedNodeDef());
+            REQUIRE(node->getInputs().size() <= options.maxFanIn);
+        }
+
+        // Verify the depth of each graph.
+        size_t maxDepth = 0;
+        for (mx::OutputPtr output : graph->getOutputs())
+        {
+            mx::GraphIterator it = output->traverseGraph().begin();
+            for (; it != mx::GraphIterator::end(); ++it)
+            {
+                maxDepth = std::max(maxDepth, it.getElementDepth());
+            }
+        }
+        REQUIRE(maxDepth == options.graphDepth);
+    }
+    for (mx::MaterialPtr material : doc->getMaterials())
+    {
+        mx::ShaderRefPtr shaderRef = material->getShaderRefs()[0];
+        REQUIRE(shaderRef->getReferencedShaderDef());
+        REQUIRE(shaderRef->getReferencedOutputs().size() > 0);
+    }
+    REQUIRE(doc->getLooks()[0]->getMaterialAssigns().size() == 20);
+
+    // Generation is deterministic for a given seed.
+    std::string xmlString = mx::writeToXmlString(doc);
+    REQUIRE(mx::writeToXmlString(mx::generateDocument(lib, options)) == xmlString);
+    options.seed = 8;
+    REQUIRE(mx::writeToXmlString(mx::generateDocument(lib, options)) != xmlString);
+
+    // A document referencing the library holds the same content as one
+    // importing it.
+    options.seed = 7;
+    options.referenceLibrary = true;
+    mx::DocumentPtr referencingDoc = mx::generateDocument(lib, options);
+    REQUIRE(referencingDoc->validate());
+    REQUIRE(referencingDoc->getNodeDefs().size() < doc->getNodeDefs().size());
+    REQUIRE(mx::writeToXmlString(referencingDoc) == xmlString);
+    REQUIRE(mx::writeToXmlString(referencingDoc, false) == mx::writeToXmlString(doc, false));
+
+    // Generation requires nodedefs of the requested type.
+    options.nodeType = "unknowntype";
+    REQUIRE_THROWS_AS(mx::generateDocument(lib, options), mx::Exception&);
+}
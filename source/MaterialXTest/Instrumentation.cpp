@@ -0,0 +1,70 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXTest/Catch/catch.hpp>
+
+#include <MaterialXCore/Instrumentation.h>
+
+#include <MaterialXFormat/XmlIo.h>
+
+namespace mx = MaterialX;
+
+TEST_CASE("Instrumentation", "[instrumentation]")
+{
+    // Nothing is recorded while instrumentation is disabled.
+    mx::Instrumentation::reset();
+    REQUIRE(!mx::Instrumentation::isEnabled());
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::readFromXmlFile(doc, "mx_stdlib_defs.mtlx", "documents/Libraries");
+    REQUIRE(mx::Instrumentation::getTimerStats().empty());
+    REQUIRE(mx::Instrumentation::getCounters().empty());
+
+    // Record timers and counters for document operations.
+    mx::Instrumentation::setEnabled(true);
+    doc = mx::createDocument();
+    mx::readFromXmlFile(doc, "mx_stdlib_defs.mtlx", "documents/Libraries");
+    doc->getMatchingNodeDefs("add");
+    doc->getMatchingNodeDefs("multiply");
+    REQUIRE(doc->validate());
+    mx::Instrumentation::setEnabled(false);
+
+    mx::TimerStatsMap timers = mx::Instrumentation::getTimerStats();
+    for (std::string name : { "readFromXmlFile", "xml/parse", "xml/xinclude", "xml/elements",
+                              "Document::upgradeVersion", "Document::Cache::refresh", "Document::validate" })
+    {
+        REQUIRE(timers.count(name));
+        REQUIRE(timers[name].count > 0);
+        REQUIRE(timers[name].minTime <= timers[name].maxTime);
+    }
+    REQUIRE(timers["readFromXmlFile"].totalTime >= timers["xml/elements"].totalTime);
+
+    mx::CounterMap counters = mx::Instrumentation::getCounters();
+    REQUIRE(counters["Document::Cache/miss"] == 1);
+    REQUIRE(counters["Document::Cache/hit"] >= 1);
+
+    // Export the recorded data.
+    std::string report = mx::Instrumentation::getReport();
+    REQUIRE(report.find("Document::Cache::refresh") != std::string::npos);
+    REQUIRE(report.find("Document::Cache/hit") != std::string::npos);
+    std::string trace = mx::Instrumentation::getChromeTrace();
+    REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(trace.find("\"name\":\"xml/parse\"") != std::string::npos);
+
+    mx::Instrumentation::reset();
+    REQUIRE(mx::Instrumentation::getTimerStats().empty());
+    REQUIRE(mx::Instrumentation::getChromeTrace().find("\"ph\"") == std::string::npos);
+
+    // Included files are parsed under their own label, which is nested
+    // within the XInclude timer rather than counted as a top-level parse.
+    mx::Instrumentation::setEnabled(true);
+    doc = mx::createDocument();
+    mx::readFromXmlFile(doc, "SubGraphs.mtlx", "documents/Examples;documents/Libraries");
+    mx::Instrumentation::setEnabled(false);
+    timers = mx::Instrumentation::getTimerStats();
+    REQUIRE(timers["xml/parse"].count == 1);
+    REQUIRE(timers["xml/xinclude/parse"].count > 0);
+    REQUIRE(timers["xml/xinclude"].totalTime >= timers["xml/xinclude/parse"].totalTime);
+    mx::Instrumentation::reset();
+}
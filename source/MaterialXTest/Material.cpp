@@ -6,6 +6,7 @@
 #include <MaterialXTest/Catch/catch.hpp>
 
 #include <MaterialXCore/Document.h>
+#include <MaterialXCore/MaterialCache.h>
 #include <MaterialXCore/Value.h>
 
 namespace mx = MaterialX;
@@ -91,3 +92,241 @@ TEST_CASE("Material", "[material]")
         doc->removeMaterial(material2->getName());
     }
 }
+
+TEST_CASE("Material signatures", "[material]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+
+    // Create a shader nodedef and a node graph.
+    mx::NodeDefPtr shaderDef = doc->addNodeDef("shader1", "surfaceshader", "simpleSrf");
+    shaderDef->addInput("diffColor", "color3");
+    shaderDef->addParameter("roughness", "float");
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    mx::NodePtr constant = nodeGraph->addNode("constant", "constant1", "color3");
+    constant->setParameterValue("value", mx::Color3(0.5f, 0.5f, 0.5f));
+    mx::OutputPtr output = nodeGraph->addOutput("out", "color3");
+    output->setConnectedNode(constant);
+
+    // Create materials differing only in bound values, and in the order in
+    // which bindings were added.
+    mx::MaterialPtr material1 = doc->addMaterial();
+    mx::ShaderRefPtr shaderRef1 = material1->addShaderRef("sr1", "simpleSrf");
+    shaderRef1->addBindParam("roughness", "float")->setValue(0.25f);
+    shaderRef1->addBindInput("diffColor", "color3")->setConnectedOutput(output);
+    material1->setOverrideValue("editRoughness", 0.1f);
+    mx::MaterialPtr material2 = doc->addMaterial();
+    mx::ShaderRefPtr shaderRef2 = material2->addShaderRef("sr2", "simpleSrf");
+    shaderRef2->addBindInput("diffColor", "color3")->setConnectedOutput(output);
+    shaderRef2->addBindParam("roughness", "float")->setValue(0.75f);
+    material2->setOverrideValue("editRoughness", 0.2f);
+
+    mx::MaterialSignature signature1 = mx::getMaterialSignature(material1);
+    mx::MaterialSignature signature2 = mx::getMaterialSignature(material2);
+    REQUIRE(signature1.topologyKey == signature2.topologyKey);
+    REQUIRE(signature1.getParameterCount() == 2);
+    REQUIRE(signature1.parameterNames[0] == "sr1/roughness");
+    REQUIRE(signature1.parameterNames[1] == "editRoughness");
+    REQUIRE(signature1.parameterValues[0]->asA<float>() == 0.25f);
+    REQUIRE(signature2.parameterValues[0]->asA<float>() == 0.75f);
+    REQUIRE(signature2.parameterValues[1]->asA<float>() == 0.2f);
+
+    // Inherited bindings are included in the signature.
+    mx::MaterialPtr derived = doc->addMaterial();
+    derived->setInheritsFrom(material1);
+    derived->setOverrideValue("editRoughness", 0.5f);
+    mx::MaterialSignature derivedSignature = mx::getMaterialSignature(derived);
+    REQUIRE(derivedSignature.topologyKey == signature1.topologyKey);
+    REQUIRE(derivedSignature.parameterValues[1]->asA<float>() == 0.5f);
+
+    // Binding a value in place of a graph changes the topology.
+    mx::MaterialPtr material3 = doc->addMaterial();
+    mx::ShaderRefPtr shaderRef3 = material3->addShaderRef("sr1", "simpleSrf");
+    shaderRef3->addBindParam("roughness", "float")->setValue(0.25f);
+    shaderRef3->addBindInput("diffColor", "color3")->setValue(mx::Color3(0.5f, 0.5f, 0.5f));
+    material3->setOverrideValue("editRoughness", 0.1f);
+    mx::MaterialSignature signature3 = mx::getMaterialSignature(material3);
+    REQUIRE(signature3.topologyKey != signature1.topologyKey);
+    REQUIRE(signature3.getParameterCount() == 3);
+    REQUIRE(signature1.hasMatchingLayout(signature2));
+    REQUIRE(!signature1.hasMatchingLayout(signature3));
+
+    // Binding a duplicate of the graph under another name keeps the topology.
+    mx::NodeGraphPtr graphCopy = doc->addNodeGraph();
+    graphCopy->copyContentFrom(nodeGraph);
+    mx::MaterialPtr material4 = doc->addMaterial();
+    mx::ShaderRefPtr shaderRef4 = material4->addShaderRef("sr1", "simpleSrf");
+    shaderRef4->addBindParam("roughness", "float")->setValue(0.5f);
+    shaderRef4->addBindInput("diffColor", "color3")->setConnectedOutput(graphCopy->getOutput("out"));
+    material4->setOverrideValue("editRoughness", 0.3f);
+    REQUIRE(mx::getMaterialSignature(material4).topologyKey == signature1.topologyKey);
+
+    // Materials share compiled artifacts by topology.
+    size_t compileCount = 0;
+    auto compile = [&compileCount](mx::MaterialPtr material, const mx::MaterialSignature&)
+    {
+        compileCount++;
+        return std::make_shared<std::string>(material->getName());
+    };
+    mx::MaterialCache<std::string> cache;
+    mx::MaterialSignature signature;
+    REQUIRE(*cache.getArtifact(material1, compile) == material1->getName());
+    REQUIRE(*cache.getArtifact(material2, compile, &signature) == material1->getName());
+    REQUIRE(signature.parameterValues[0]->asA<float>() == 0.75f);
+    REQUIRE(*cache.getArtifact(material3, compile) == material3->getName());
+    REQUIRE(compileCount == 2);
+    REQUIRE(cache.getArtifactCount() == 2);
+    REQUIRE(cache.getHitCount() == 1);
+    REQUIRE(cache.getMissCount() == 2);
+    REQUIRE(cache.getArtifact(signature3.topologyKey));
+
+    // Editing a bound graph or the shader nodedef changes the topology.
+    constant->setParameterValue("value", mx::Color3(1.0f, 0.0f, 0.0f));
+    REQUIRE(mx::getMaterialSignature(material1).topologyKey != signature1.topologyKey);
+    shaderDef->addParameter("metallic", "float");
+    REQUIRE(mx::getMaterialSignature(material3).topologyKey != signature3.topologyKey);
+    REQUIRE(*cache.getArtifact(material1, compile) == material1->getName());
+    REQUIRE(compileCount == 3);
+
+    cache.clear();
+    REQUIRE(cache.getArtifactCount() == 0);
+    REQUIRE(!cache.getArtifact(signature3.topologyKey));
+}
+
+TEST_CASE("Material inheritance resolution", "[material]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeDefPtr shaderDef = doc->addNodeDef("shader1", "surfaceshader", "simpleSrf");
+    shaderDef->addInput("diffColor", "color3");
+    shaderDef->addParameter("roughness", "float");
+
+    // Create a chain of three materials.
+    mx::MaterialPtr base = doc->addMaterial("base");
+    mx::ShaderRefPtr baseRef = base->addShaderRef("sr1", "simpleSrf");
+    baseRef->addBindParam("roughness", "float")->setValue(0.5f);
+    baseRef->addBindInput("diffColor", "color3")->setValue(mx::Color3(0.1f, 0.2f, 0.3f));
+    base->setOverrideValue("editRoughness", 0.1f);
+    base->setOverrideValue("editSpecular", 0.2f);
+    mx::MaterialPtr middle = doc->addMaterial("middle");
+    middle->setInheritsFrom(base);
+    middle->addShaderRef("sr1", "simpleSrf")->addBindParam("roughness", "float")->setValue(0.25f);
+    middle->addShaderRef("sr2", "simpleSrf");
+    mx::MaterialPtr derived = doc->addMaterial("derived");
+    derived->setInheritsFrom(middle);
+    derived->setOverrideValue("editRoughness", 0.3f);
+
+    // Derived content takes precedence, with bindings merged by name.
+    mx::ResolvedMaterialPtr resolved = derived->getResolvedMaterial();
+    REQUIRE(resolved->getMaterial() == derived);
+    REQUIRE(resolved->getInheritanceChain() == std::vector<mx::MaterialPtr>({ derived, middle, base }));
+    REQUIRE(resolved->getShaderRefs().size() == 2);
+    const mx::ResolvedShaderRef* shaderRef = resolved->getShaderRef("sr1");
+    REQUIRE(shaderRef->shaderRef->getParent() == middle);
+    REQUIRE(shaderRef->getBindParam("roughness")->getValue()->asA<float>() == 0.25f);
+    REQUIRE(shaderRef->getBindInput("diffColor")->getParent() == baseRef);
+    REQUIRE(resolved->getShaderRef("sr2"));
+    REQUIRE(!resolved->getShaderRef("sr3"));
+    REQUIRE(resolved->getOverrides().size() == 2);
+    REQUIRE(resolved->getOverride("editRoughness")->getValue()->asA<float>() == 0.3f);
+    REQUIRE(resolved->getOverride("editSpecular")->getParent() == base);
+
+    // Results are memoized until a material in the chain is edited.
+    REQUIRE(derived->getResolvedMaterial() == resolved);
+    mx::ResolvedMaterialPtr resolvedMiddle = middle->getResolvedMaterial();
+    doc->addMaterial("unrelated");
+    REQUIRE(derived->getResolvedMaterial() == resolved);
+    base->getOverride("editSpecular")->setValueString("0.4");
+    mx::ResolvedMaterialPtr updated = derived->getResolvedMaterial();
+    REQUIRE(updated != resolved);
+    REQUIRE(middle->getResolvedMaterial() != resolvedMiddle);
+    REQUIRE(updated->getOverride("editSpecular")->getValueString() == "0.4");
+
+    // Replacing elements with identical copies invalidates the results.
+    middle->removeShaderRef("sr2");
+    mx::ShaderRefPtr newRef = middle->addShaderRef("sr2", "simpleSrf");
+    resolved = derived->getResolvedMaterial();
+    REQUIRE(resolved != updated);
+    REQUIRE(resolved->getShaderRef("sr2")->shaderRef == newRef);
+    uint64_t baseHash = base->getContentHash();
+    baseRef->removeBindInput("diffColor");
+    mx::BindInputPtr newInput = baseRef->addBindInput("diffColor", "color3");
+    newInput->setValue(mx::Color3(0.1f, 0.2f, 0.3f));
+    REQUIRE(base->getContentHash() == baseHash);
+    REQUIRE(derived->getResolvedMaterial()->getShaderRef("sr1")->getBindInput("diffColor") == newInput);
+    derived->removeOverride("editRoughness");
+    mx::OverridePtr newOverride = derived->setOverrideValue("editRoughness", 0.3f);
+    updated = derived->getResolvedMaterial();
+    REQUIRE(updated->getOverride("editRoughness") == newOverride);
+
+    // Resolve all materials of the document in one call.
+    std::vector<mx::ResolvedMaterialPtr> allResolved = doc->getResolvedMaterials();
+    REQUIRE(allResolved.size() == 4);
+    REQUIRE(allResolved[2] == updated);
+
+    // Inheritance cycles are reported.
+    base->setInheritsFrom(derived);
+    REQUIRE_THROWS_AS(derived->getResolvedMaterial(), mx::ExceptionFoundCycle&);
+    base->setInheritsFrom(mx::MaterialPtr());
+    REQUIRE(derived->getResolvedMaterial()->getInheritanceChain().size() == 3);
+}
+
+TEST_CASE("Override bindings", "[material]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeDefPtr shaderDef = doc->addNodeDef("shader1", "surfaceshader", "simpleSrf");
+    mx::ParameterPtr roughness = shaderDef->addParameter("roughness", "float");
+    roughness->setValue(0.2f);
+    roughness->setPublicName("editRoughness");
+    mx::ParameterPtr specular = shaderDef->addParameter("specular", "float");
+    specular->setValue(0.5f);
+    specular->setPublicName("editSpecular");
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    mx::NodePtr constant = nodeGraph->addNode("constant", "constant1", "float");
+    mx::ParameterPtr value = constant->setParameterValue("value", 0.7f);
+    value->setPublicName("editRoughness");
+
+    mx::MaterialPtr base = doc->addMaterial();
+    base->addShaderRef("sr1", "simpleSrf");
+    base->setOverrideValue("editRoughness", 0.1f);
+    base->setOverrideValue("editMissing", 1.0f);
+    mx::MaterialPtr material = doc->addMaterial();
+    material->setInheritsFrom(base);
+    material->setOverrideValue("editSpecular", 0.9f);
+
+    // Overrides are bound to all receiving public elements, including
+    // those inherited from base materials.
+    mx::OverrideBindingTablePtr table = material->getOverrideBindings();
+    REQUIRE(table->getRevision() == doc->getRevision());
+    REQUIRE(table->getBindings().size() == 3);
+    REQUIRE(table->getReceivers("editRoughness").size() == 2);
+    REQUIRE(table->getReceivers("editSpecular") == std::vector<mx::ValueElementPtr>({ specular }));
+    REQUIRE(table->getReceivers("editMissing").empty());
+    REQUIRE(table->getUnboundOverrides().size() == 1);
+    REQUIRE(table->getUnboundOverrides()[0]->getName() == "editMissing");
+    const mx::OverrideBinding* binding = table->getBinding(value);
+    REQUIRE(binding->override == base->getOverride("editRoughness"));
+    REQUIRE(binding->effectiveValue->asA<float>() == 0.1f);
+    REQUIRE(table->getBinding(specular)->effectiveValue->asA<float>() == 0.9f);
+    REQUIRE(!table->getBinding(nullptr));
+
+    // Upstream edges and receivers agree with the table.
+    REQUIRE(value->getUpstreamElement(material) == base->getOverride("editRoughness"));
+    REQUIRE(roughness->getUpstreamElement(material) == base->getOverride("editRoughness"));
+    REQUIRE(specular->getUpstreamElement(material) == material->getOverride("editSpecular"));
+    REQUIRE(material->getOverride("editSpecular")->getReceiver() == specular);
+    REQUIRE(table->getBinding(base->getOverride("editRoughness")->getReceiver()->asA<mx::ValueElement>()));
+    REQUIRE(!base->getOverride("editMissing")->getReceiver());
+
+    // Public elements without overrides retain their own values.
+    mx::OverrideBindingTablePtr baseTable = base->getOverrideBindings();
+    REQUIRE(!baseTable->getBinding(specular)->override);
+    REQUIRE(baseTable->getBinding(specular)->effectiveValue->asA<float>() == 0.5f);
+
+    // Tables are reused until the document is edited.
+    REQUIRE(material->getOverrideBindings() == table);
+    uint64_t revision = doc->getRevision();
+    material->removeOverride("editSpecular");
+    REQUIRE(doc->getRevision() > revision);
+    table = material->getOverrideBindings();
+    REQUIRE(!table->getBinding(specular)->override);
+    REQUIRE(table->getRevision() == doc->getRevision());
+}
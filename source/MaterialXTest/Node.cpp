@@ -76,6 +76,91 @@ TEST_CASE("Node", "[node]")
     REQUIRE(doc->getNodeGraphs().empty());
 }
 
+TEST_CASE("Nodedef resolution", "[node]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::readFromXmlFile(doc, "mx_stdlib_defs.mtlx", "documents/Libraries");
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+
+    // Overloads are selected by output type and input types.
+    mx::NodePtr swizzle1 = nodeGraph->addNode("swizzle", "swizzle1", "float");
+    swizzle1->addInput("in", "color3");
+    mx::NodePtr swizzle2 = nodeGraph->addNode("swizzle", "swizzle2", "float");
+    swizzle2->addInput("in", "vector4");
+    mx::NodePtr add1 = nodeGraph->addNode("add", "add1", "color3");
+    add1->addInput("in2", "float");
+    mx::NodePtr add2 = nodeGraph->addNode("add", "add2", "color3");
+    mx::NodePtr invalid = nodeGraph->addNode("add", "add3", "color3");
+    invalid->addInput("in1", "string");
+    REQUIRE(swizzle1->getReferencedNodeDef()->getName() == "ND_swizzle__color3_float");
+    REQUIRE(swizzle2->getReferencedNodeDef()->getName() == "ND_swizzle__vector4_float");
+    REQUIRE(add1->getReferencedNodeDef()->getName() == "ND_add__color3FA");
+    REQUIRE(add2->getReferencedNodeDef()->getName() == "ND_add__color3");
+    REQUIRE(!invalid->getReferencedNodeDef());
+
+    // Nodes sharing a signature resolve to the same nodedef, in a batch.
+    mx::NodePtr swizzle3 = nodeGraph->addNode("swizzle", "swizzle3", "float");
+    swizzle3->addInput("in", "color3");
+    std::vector<mx::NodeDefPtr> nodeDefs = doc->getNodeDefsForNodes(nodeGraph->getNodes());
+    REQUIRE(nodeDefs.size() == 6);
+    REQUIRE(nodeDefs[0] == swizzle1->getReferencedNodeDef());
+    REQUIRE(nodeDefs[5] == nodeDefs[0]);
+    REQUIRE(!nodeDefs[4]);
+
+    // Edits to nodedefs are reflected in later resolutions.
+    mx::NodeDefPtr nodeDef = doc->getNodeDef("ND_swizzle__color3_float");
+    nodeDef->getInput("in")->setType("color4");
+    REQUIRE(!swizzle1->getReferencedNodeDef());
+}
+
+TEST_CASE("Node implementations", "[node]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::NodeDefPtr nodeDef = doc->addNodeDef("ND_custom", "color3", "custom");
+    mx::ImplementationPtr genericImpl = doc->addImplementation("IM_custom");
+    genericImpl->setNodeDef(nodeDef->getName());
+    mx::ImplementationPtr oslImpl = doc->addImplementation("IM_custom_osl");
+    oslImpl->setNodeDef(nodeDef->getName());
+    oslImpl->setLanguage("osl");
+    mx::ImplementationPtr glslImpl = doc->addImplementation("IM_custom_glsl");
+    glslImpl->setNodeDef(nodeDef->getName());
+    glslImpl->setLanguage("glsl");
+    mx::ImplementationPtr targetImpl = doc->addImplementation("IM_custom_target");
+    targetImpl->setNodeDef(nodeDef->getName());
+    targetImpl->setTarget("renderer1");
+
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+    mx::NodePtr custom1 = nodeGraph->addNode("custom", "custom1", "color3");
+    mx::NodePtr custom2 = nodeGraph->addNode("custom", "custom2", "color3");
+    mx::NodePtr unknown = nodeGraph->addNode("unknown", "unknown1", "color3");
+
+    // Target-specific implementations are preferred, falling back to generic
+    // implementations in document order.
+    REQUIRE(custom1->getImplementation() == genericImpl);
+    REQUIRE(custom1->getImplementation("renderer1") == targetImpl);
+    REQUIRE(custom1->getImplementation("renderer2") == genericImpl);
+    REQUIRE(!unknown->getImplementation());
+
+    // Languages select among implementations of equal target rank.
+    REQUIRE(custom1->getImplementation("", "osl") == oslImpl);
+    REQUIRE(custom1->getImplementation("", "glsl") == glslImpl);
+    REQUIRE(custom1->getImplementation("", "mdl") == genericImpl);
+    REQUIRE(custom1->getImplementation("renderer1", "glsl") == targetImpl);
+    targetImpl->setLanguage("osl");
+    REQUIRE(custom1->getImplementation("renderer1", "glsl") == glslImpl);
+
+    // Resolve a graph for one target in a single batch.
+    std::vector<mx::ElementPtr> implementations = doc->getImplementationsForNodes(nodeGraph->getNodes(), "renderer1", "osl");
+    REQUIRE(implementations.size() == 3);
+    REQUIRE(implementations[0] == targetImpl);
+    REQUIRE(implementations[1] == targetImpl);
+    REQUIRE(!implementations[2]);
+
+    // Removing an implementation is reflected in later resolutions.
+    doc->removeImplementation(targetImpl->getName());
+    REQUIRE(custom2->getImplementation("renderer1", "osl") == oslImpl);
+}
+
 TEST_CASE("Flatten", "[nodegraph]")
 {
     // Load the example file.
@@ -77,6 +77,13 @@ TEST_CASE("Observer", "[observer]")
             REQUIRE(_writeCount == 1);
         }
 
+        void verifyCountsPostRemove()
+        {
+            REQUIRE(_beginUpdateCount == 1);
+            REQUIRE(_endUpdateCount == 1);
+            REQUIRE(_removeElementCount == 2);
+        }
+
       protected:
         // Set of counts for verification.
         unsigned int _beginUpdateCount;
@@ -126,4 +133,9 @@ TEST_CASE("Observer", "[observer]")
 
     // Check that observer tracked the correct number of changes during initialize and read
     testObserver->verifyCountsPostRead();
+    testObserver->clear();
+
+    // Remove all children of the node graph in a single batch.
+    doc->getNodeGraphs()[0]->removeChildren([](mx::ElementPtr) { return true; });
+    testObserver->verifyCountsPostRemove();
 }
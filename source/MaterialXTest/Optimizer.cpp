@@ -0,0 +1,186 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <MaterialXTest/Catch/catch.hpp>
+
+#include <MaterialXEval/Evaluator.h>
+#include <MaterialXEval/Optimizer.h>
+
+#include <MaterialXFormat/XmlIo.h>
+
+#include <cmath>
+
+namespace mx = MaterialX;
+
+TEST_CASE("Optimize node graphs", "[optimizer]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::readFromXmlFile(doc, "mx_stdlib_defs.mtlx", "documents/Libraries");
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+
+    // A constant chain feeding a varying branch.
+    mx::NodePtr constant = nodeGraph->addNode("constant", "constant1", "color3");
+    constant->setParameterValue("value", mx::Color3(0.1f, 0.2f, 0.3f));
+    mx::NodePtr multiply = nodeGraph->addNode("multiply", "multiply1", "color3");
+    multiply->setConnectedNode("in1", constant);
+    multiply->addInput("in2", "color3")->setValue(mx::Color3(2.0f, 2.0f, 2.0f));
+    mx::NodePtr contrast = nodeGraph->addNode("contrast", "contrast1", "color3");
+    contrast->setConnectedNode("in", multiply);
+    contrast->setParameterValue("amount", mx::Color3(1.5f, 1.5f, 1.5f));
+    mx::NodePtr noise = nodeGraph->addNode("noise2d", "noise1", "color3");
+    mx::NodePtr mix = nodeGraph->addNode("mix", "mix1", "color3");
+    mix->setConnectedNode("fg", contrast);
+    mix->setConnectedNode("bg", noise);
+    mix->addInput("mask", "float")->setValue(0.25f);
+
+    // A switch with a constant selector, and a compare with a constant test.
+    mx::NodePtr ramp = nodeGraph->addNode("ramplr", "ramp1", "color3");
+    ramp->setParameterValue("valuer", mx::Color3(1.0f, 1.0f, 1.0f));
+    mx::NodePtr switchNode = nodeGraph->addNode("switch", "switch1", "color3");
+    switchNode->setConnectedNode("in1", mix);
+    switchNode->setConnectedNode("in2", ramp);
+    switchNode->setParameterValue("which", 1.0f);
+    mx::NodePtr test = nodeGraph->addNode("constant", "test1", "float");
+    test->setParameterValue("value", 0.75f);
+    mx::NodePtr compare = nodeGraph->addNode("compare", "compare1", "color3");
+    compare->setConnectedNode("intest", test);
+    compare->setParameterValue("cutoff", 0.5f);
+    compare->setConnectedNode("in1", ramp);
+    compare->setConnectedNode("in2", switchNode);
+    mx::OutputPtr output = nodeGraph->addOutput("out", "color3");
+    output->setConnectedNode(compare);
+
+    // An unconnected branch.
+    mx::NodePtr unused = nodeGraph->addNode("add", "unused1", "color3");
+    unused->setConnectedNode("in1", noise);
+
+    // Record the values of the unoptimized graph.
+    mx::SampleBatch samples;
+    samples.setGrid(16, 16);
+    mx::SampleBuffer original;
+    mx::EvalProgram::compile(output)->evaluate(samples, original);
+
+    mx::OptimizerStats stats = mx::optimizeNodeGraph(nodeGraph);
+    REQUIRE(stats.nodeCount == 10);
+    REQUIRE(stats.foldedNodes == 2);
+    REQUIRE(stats.collapsedConditionals == 2);
+    REQUIRE(stats.removedNodes == 9);
+    REQUIRE(doc->validate());
+
+    // The output now reads the ramp directly, and no other nodes remain.
+    REQUIRE(output->getConnectedNode() == ramp);
+    REQUIRE(nodeGraph->getNodes().size() == 1);
+
+    mx::SampleBuffer optimized;
+    mx::EvalProgram::compile(output)->evaluate(samples, optimized);
+    for (size_t channel = 0; channel < 3; channel++)
+    {
+        for (size_t sample = 0; sample < samples.getSampleCount(); sample++)
+        {
+            REQUIRE(optimized.getValue(sample, channel) == original.getValue(sample, channel));
+        }
+    }
+
+    // Select the varying branch, and verify that its constant subgraph is
+    // folded in place.
+    mx::NodePtr multiply2 = nodeGraph->addNode("multiply", "multiply2", "color3");
+    multiply2->addInput("in1", "color3")->setValue(mx::Color3(0.5f, 0.5f, 0.5f));
+    multiply2->addInput("in2", "color3")->setValue(mx::Color3(0.2f, 0.4f, 0.6f));
+    mx::NodePtr noise2 = nodeGraph->addNode("noise2d", "noise2", "color3");
+    mx::NodePtr add = nodeGraph->addNode("add", "add1", "color3");
+    add->setConnectedNode("in1", multiply2);
+    add->setConnectedNode("in2", noise2);
+    output->setConnectedNode(add);
+
+    mx::EvalProgram::compile(output)->evaluate(samples, original);
+    stats = mx::optimizeNodeGraph(nodeGraph);
+    REQUIRE(stats.foldedNodes == 1);
+    REQUIRE(stats.removedNodes == 1);
+    REQUIRE(multiply2->getCategory() == "constant");
+    REQUIRE(multiply2->getParameterValue("value")->asA<mx::Color3>() == mx::Color3(0.1f, 0.2f, 0.3f));
+    REQUIRE(noise2->getCategory() == "noise2d");
+    REQUIRE(add->getCategory() == "add");
+
+    mx::EvalProgram::compile(output)->evaluate(samples, optimized);
+    for (size_t sample = 0; sample < samples.getSampleCount(); sample++)
+    {
+        REQUIRE(std::abs(optimized.getValue(sample, 1) - original.getValue(sample, 1)) < 1e-6f);
+    }
+
+    // Graphs without outputs retain all of their nodes.
+    mx::NodeGraphPtr emptyGraph = doc->addNodeGraph();
+    emptyGraph->addNode("noise3d", "noise1", "float");
+    stats = mx::optimizeNodeGraph(emptyGraph);
+    REQUIRE(stats.removedNodes == 0);
+    REQUIRE(emptyGraph->getNodes().size() == 1);
+}
+
+TEST_CASE("Eliminate common subexpressions", "[optimizer]")
+{
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::readFromXmlFile(doc, "mx_stdlib_defs.mtlx", "documents/Libraries");
+    mx::NodeGraphPtr nodeGraph = doc->addNodeGraph();
+
+    // Two identical branches, differing only in node names and port order.
+    mx::NodePtr texcoord1 = nodeGraph->addNode("texcoord", "texcoord1", "vector2");
+    mx::NodePtr texcoord2 = nodeGraph->addNode("texcoord", "texcoord2", "vector2");
+    mx::NodePtr noise1 = nodeGraph->addNode("noise2d", "noise1", "float");
+    noise1->setConnectedNode("texcoord", texcoord1);
+    noise1->setParameterValue("amplitude", 0.5f);
+    noise1->setParameterValue("pivot", 0.5f);
+    mx::NodePtr noise2 = nodeGraph->addNode("noise2d", "noise2", "float");
+    noise2->setParameterValue("pivot", 0.5f);
+    noise2->setParameterValue("amplitude", 0.5f);
+    noise2->setConnectedNode("texcoord", texcoord2);
+
+    // A third branch with a different parameter value.
+    mx::NodePtr noise3 = nodeGraph->addNode("noise2d", "noise3", "float");
+    noise3->setConnectedNode("texcoord", texcoord2);
+    noise3->setParameterValue("amplitude", 0.25f);
+    noise3->setParameterValue("pivot", 0.5f);
+
+    mx::NodePtr add1 = nodeGraph->addNode("add", "add1", "float");
+    add1->setConnectedNode("in1", noise1);
+    add1->setConnectedNode("in2", noise3);
+    mx::NodePtr add2 = nodeGraph->addNode("add", "add2", "float");
+    add2->setConnectedNode("in1", noise2);
+    add2->setConnectedNode("in2", noise3);
+    mx::NodePtr multiply = nodeGraph->addNode("multiply", "multiply1", "float");
+    multiply->setConnectedNode("in1", add1);
+    multiply->setConnectedNode("in2", add2);
+    mx::OutputPtr output1 = nodeGraph->addOutput("out1", "float");
+    output1->setConnectedNode(multiply);
+    mx::OutputPtr output2 = nodeGraph->addOutput("out2", "float");
+    output2->setConnectedNode(add2);
+
+    mx::SampleBatch samples;
+    samples.setGrid(16, 16);
+    mx::SampleBuffer original;
+    mx::EvalProgram::compile(output1)->evaluate(samples, original);
+
+    mx::OptimizerOptions options;
+    options.foldConstants = false;
+    mx::OptimizerStats stats = mx::optimizeNodeGraph(nodeGraph, options);
+    REQUIRE(stats.mergedNodes == 3);
+    REQUIRE(stats.removedNodes == 0);
+    REQUIRE(nodeGraph->getNodes().size() == 5);
+    REQUIRE(doc->validate());
+
+    // Downstream ports, including graph outputs, reference the merged nodes.
+    REQUIRE(multiply->getConnectedNode("in1") == multiply->getConnectedNode("in2"));
+    REQUIRE(output2->getConnectedNode() == multiply->getConnectedNode("in1"));
+    REQUIRE(noise3->getConnectedNode("texcoord") == multiply->getConnectedNode("in1")->getConnectedNode("in1")->getConnectedNode("texcoord"));
+
+    mx::SampleBuffer optimized;
+    mx::EvalProgram::compile(output1)->evaluate(samples, optimized);
+    for (size_t sample = 0; sample < samples.getSampleCount(); sample++)
+    {
+        REQUIRE(optimized.getValue(sample, 0) == original.getValue(sample, 0));
+    }
+
+    // Optimization is idempotent.
+    stats = mx::optimizeNodeGraph(nodeGraph, options);
+    REQUIRE(stats.mergedNodes == 0);
+}
@@ -24,6 +24,11 @@ TEST_CASE("String utilities", "[util]")
 
     REQUIRE(mx::splitString("robot1, robot2", ", ") == (std::vector<std::string>{"robot1", "robot2"}));
     REQUIRE(mx::splitString("[one...two...three]", "[.]") == (std::vector<std::string>{"one", "two", "three"}));
+
+    REQUIRE(mx::escapeJsonString("plain") == "plain");
+    REQUIRE(mx::escapeJsonString("a\"b\\c") == "a\\\"b\\\\c");
+    REQUIRE(mx::escapeJsonString("line\n\ttab") == "line\\n\\ttab");
+    REQUIRE(mx::escapeJsonString(std::string(1, '\x01')) == "\\u0001");
 }
 
 TEST_CASE("Print utilities", "[util]")
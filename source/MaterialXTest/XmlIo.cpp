@@ -7,6 +7,9 @@
 
 #include <MaterialXFormat/XmlIo.h>
 
+#include <mutex>
+#include <thread>
+
 namespace mx = MaterialX;
 
 TEST_CASE("Load content", "[xmlio]")
@@ -133,3 +136,171 @@ TEST_CASE("Load content", "[xmlio]")
         }
     }
 }
+
+TEST_CASE("Referenced libraries", "[xmlio]")
+{
+    std::string searchPath = "documents/Libraries";
+    mx::DocumentPtr lib = mx::createDocument();
+    mx::readFromXmlFile(lib, "mx_stdlib_defs.mtlx", searchPath);
+
+    // Reference the library from two documents.
+    mx::DocumentPtr doc1 = mx::createDocument();
+    mx::DocumentPtr doc2 = mx::createDocument();
+    doc1->addReferencedLibrary(lib);
+    doc2->addReferencedLibrary(lib);
+    REQUIRE(doc1->getReferencedLibraries().size() == 1);
+    REQUIRE(doc1->getNodeDefs().empty());
+    REQUIRE(doc1->getMemoryUsage().elementCount == 1);
+
+    // Lookups consult the library.
+    mx::NodeDefPtr addDef = doc1->getNodeDef("ND_add__color3");
+    REQUIRE(addDef);
+    REQUIRE(addDef == doc2->getNodeDef("ND_add__color3"));
+    REQUIRE(addDef->getDocument() == lib);
+    REQUIRE(doc1->getMatchingNodeDefs("add").size() == lib->getMatchingNodeDefs("add").size());
+    mx::NodeGraphPtr nodeGraph = doc1->addNodeGraph();
+    mx::NodePtr add = nodeGraph->addNode("add", "add1", "color3");
+    REQUIRE(add->getReferencedNodeDef() == addDef);
+
+    // Definitions in the document take precedence over those of the library.
+    mx::NodeDefPtr localDef = doc1->addNodeDef("ND_add_color3_local", "color3", "add");
+    REQUIRE(add->getReferencedNodeDef() == localDef);
+    doc1->removeNodeDef(localDef->getName());
+    REQUIRE(add->getReferencedNodeDef() == addDef);
+
+    // Edits to the library are reflected in referencing documents.
+    lib->addNodeDef("ND_custom", "color3", "custom");
+    REQUIRE(doc1->getMatchingNodeDefs("custom").size() == 1);
+    lib->removeNodeDef("ND_custom");
+    REQUIRE(doc1->getMatchingNodeDefs("custom").empty());
+
+    // References added to the library are followed by referencing documents.
+    mx::DocumentPtr extraLib = mx::createDocument();
+    extraLib->addNodeDef("ND_extra", "color3", "extra");
+    lib->addReferencedLibrary(extraLib);
+    REQUIRE(doc1->getMatchingNodeDefs("extra").size() == 1);
+    lib->removeReferencedLibrary(extraLib);
+    REQUIRE(doc1->getMatchingNodeDefs("extra").empty());
+
+    // Traversal visits the document followed by the library.
+    auto countElements = [](mx::TreeIterator iter)
+    {
+        size_t count = 0;
+        for (mx::ElementPtr elem : iter)
+        {
+            count++;
+        }
+        return count;
+    };
+    REQUIRE(countElements(doc1->traverseTreeWithLibraries()) ==
+            countElements(doc1->traverseTree()) + countElements(lib->traverseTree()));
+
+    // Cyclic references are rejected.
+    REQUIRE_THROWS_AS(lib->addReferencedLibrary(doc1), mx::ExceptionFoundCycle&);
+    REQUIRE_THROWS_AS(doc1->addReferencedLibrary(doc1), mx::ExceptionFoundCycle&);
+
+    // Referenced libraries are written as XIncludes, or as explicit data.
+    std::string xmlString = mx::writeToXmlString(doc1);
+    REQUIRE(xmlString.find("xi:include href=\"mx_stdlib_defs.mtlx\"") != std::string::npos);
+    mx::DocumentPtr doc3 = mx::createDocument();
+    mx::readFromXmlString(doc3, xmlString);
+    REQUIRE(!doc3->getNodeDef("ND_add__color3"));
+    mx::DocumentPtr doc4 = mx::createDocument();
+    mx::readFromXmlString(doc4, mx::writeToXmlString(doc1, false));
+    REQUIRE(doc4->getNodeDef("ND_add__color3"));
+    REQUIRE(doc4->getNodeGraph(nodeGraph->getName()));
+
+    // Copies share the references of the original.
+    mx::DocumentPtr copy = doc1->copy();
+    REQUIRE(copy->getNodeDef("ND_add__color3") == addDef);
+    REQUIRE(*copy == *doc1);
+
+    doc1->removeReferencedLibrary(lib);
+    REQUIRE(!doc1->hasReferencedLibraries());
+    REQUIRE(!doc1->getNodeDef("ND_add__color3"));
+    REQUIRE(!add->getReferencedNodeDef());
+}
+
+TEST_CASE("Asynchronous loading", "[xmlio]")
+{
+    std::string searchPath = "documents/Libraries;documents/Examples";
+    std::string filename = "MaterialGraphs.mtlx";
+    mx::DocumentPtr doc = mx::createDocument();
+    mx::readFromXmlFile(doc, filename, searchPath);
+
+    // Load a document along with its includes, recording progress.
+    std::mutex progressMutex;
+    std::vector<std::string> progressFiles;
+    std::vector<size_t> progressCounts;
+    size_t progressTotal = 0;
+    mx::XmlLoadOptions options;
+    options.searchPath = searchPath;
+    options.validate = true;
+    options.index = true;
+    options.progress = [&](const std::string& readFilename, size_t filesRead, size_t fileCount)
+    {
+        std::lock_guard<std::mutex> lock(progressMutex);
+        progressFiles.push_back(readFilename);
+        progressCounts.push_back(filesRead);
+        progressTotal = fileCount;
+    };
+    mx::XmlLoadTaskPtr task = mx::readFromXmlFileAsync(filename, options);
+    mx::DocumentPtr asyncDoc = task->get();
+    REQUIRE(task->isReady());
+    REQUIRE(*asyncDoc == *doc);
+    REQUIRE(asyncDoc->getSourceUri() == filename);
+    REQUIRE(progressFiles.size() == 3);
+    REQUIRE(progressFiles[0] == filename);
+    REQUIRE(progressCounts == std::vector<size_t>({ 1, 2, 3 }));
+    REQUIRE(progressTotal == 3);
+
+    // Load several documents concurrently, with completion callbacks.
+    std::atomic<size_t> completeCount(0);
+    options = mx::XmlLoadOptions();
+    options.searchPath = searchPath;
+    options.complete = [&](mx::XmlLoadTaskPtr)
+    {
+        completeCount++;
+    };
+    std::vector<mx::XmlLoadTaskPtr> tasks;
+    for (int i = 0; i < 8; i++)
+    {
+        tasks.push_back(mx::readFromXmlFileAsync(filename, options));
+    }
+    for (mx::XmlLoadTaskPtr loadTask : tasks)
+    {
+        REQUIRE(*loadTask->get() == *doc);
+    }
+    while (completeCount < tasks.size())
+    {
+        std::this_thread::yield();
+    }
+
+    // Exceptions thrown by completion callbacks do not affect the load.
+    std::atomic<bool> throwingCompleted(false);
+    options.complete = [&](mx::XmlLoadTaskPtr)
+    {
+        throwingCompleted = true;
+        throw mx::Exception("Completion failure");
+    };
+    REQUIRE(*mx::readFromXmlFileAsync(filename, options)->get() == *doc);
+    while (!throwingCompleted)
+    {
+        std::this_thread::yield();
+    }
+
+    // Failures and cancellations are reported through the future.  The
+    // completion callback references local state, so it is cleared before
+    // loads that may outlive this scope.
+    options.complete = nullptr;
+    task = mx::readFromXmlFileAsync("NonExistent.mtlx", options);
+    REQUIRE_THROWS_AS(task->get(), mx::ExceptionFileMissing&);
+    options.progress = [](const std::string&, size_t, size_t)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    };
+    task = mx::readFromXmlFileAsync(filename, options);
+    task->cancel();
+    REQUIRE(task->isCancelled());
+    REQUIRE_THROWS_AS(task->get(), mx::ExceptionLoadCancelled&);
+}
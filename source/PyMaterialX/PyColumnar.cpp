@@ -0,0 +1,88 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <PyMaterialX/PyMaterialX.h>
+
+#include <MaterialXCore/Columnar.h>
+#include <MaterialXCore/Element.h>
+
+#include <PyBind11/numpy.h>
+#include <PyBind11/stl.h>
+
+namespace py = pybind11;
+namespace mx = MaterialX;
+
+namespace {
+
+// Return a NumPy view of the given integer column, which shares storage with
+// the owning table and keeps it alive for the lifetime of the view.
+py::array_t<int> getColumnView(const std::vector<int>& column, py::object owner)
+{
+    return py::array_t<int>(column.size(), column.data(), owner);
+}
+
+// Return the given string column in the layout of an Arrow string array, as
+// a NumPy array of N + 1 offsets and a bytes object holding the concatenated
+// UTF-8 data, so that no per-string Python objects are created.
+py::tuple getStringBuffers(const std::vector<std::string>& column)
+{
+    py::array_t<int> offsets(column.size() + 1);
+    std::string data;
+    {
+        py::gil_scoped_release release;
+        size_t dataSize = 0;
+        for (const std::string& str : column)
+            dataSize += str.size();
+        data.reserve(dataSize);
+
+        int* offsetPtr = offsets.mutable_data();
+        for (const std::string& str : column)
+        {
+            *offsetPtr++ = (int) data.size();
+            data += str;
+        }
+        *offsetPtr = (int) data.size();
+    }
+    return py::make_tuple(offsets, py::bytes(data));
+}
+
+} // anonymous namespace
+
+void bindPyColumnar(py::module& mod)
+{
+    py::class_<mx::ColumnarTable>(mod, "ColumnarTable")
+        .def(py::init<>())
+        .def("getElementCount", &mx::ColumnarTable::getElementCount)
+        .def("getAttributeCount", &mx::ColumnarTable::getAttributeCount)
+        .def("clear", &mx::ColumnarTable::clear)
+        .def_property_readonly("elementParents", [](py::object self)
+            {
+                return getColumnView(self.cast<mx::ColumnarTable&>().elementParents, self);
+            })
+        .def_property_readonly("elementCategories", [](py::object self)
+            {
+                return getColumnView(self.cast<mx::ColumnarTable&>().elementCategories, self);
+            })
+        .def_property_readonly("attributeElements", [](py::object self)
+            {
+                return getColumnView(self.cast<mx::ColumnarTable&>().attributeElements, self);
+            })
+        .def_property_readonly("attributeNames", [](py::object self)
+            {
+                return getColumnView(self.cast<mx::ColumnarTable&>().attributeNames, self);
+            })
+        .def_property_readonly("elementNames", [](const mx::ColumnarTable& table)
+            {
+                return getStringBuffers(table.elementNames);
+            })
+        .def_property_readonly("attributeValues", [](const mx::ColumnarTable& table)
+            {
+                return getStringBuffers(table.attributeValues);
+            })
+        .def_readonly("categoryDictionary", &mx::ColumnarTable::categoryDictionary)
+        .def_readonly("attributeNameDictionary", &mx::ColumnarTable::attributeNameDictionary);
+
+    mod.def("exportColumnarTable", withoutGil(&mx::exportColumnarTable));
+}
@@ -0,0 +1,39 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <PyMaterialX/PyMaterialX.h>
+
+#include <MaterialXCore/Diff.h>
+
+#include <PyBind11/stl.h>
+
+namespace py = pybind11;
+namespace mx = MaterialX;
+
+void bindPyDiff(py::module& mod)
+{
+    py::class_<mx::ElementEdit> elementEdit(mod, "ElementEdit");
+    elementEdit
+        .def(py::init<>())
+        .def("asString", &mx::ElementEdit::asString)
+        .def_readwrite("type", &mx::ElementEdit::type)
+        .def_readwrite("path", &mx::ElementEdit::path)
+        .def_readwrite("category", &mx::ElementEdit::category)
+        .def_readwrite("index", &mx::ElementEdit::index)
+        .def_readwrite("attribute", &mx::ElementEdit::attribute)
+        .def_readwrite("value", &mx::ElementEdit::value)
+        .def_readwrite("content", &mx::ElementEdit::content);
+
+    py::enum_<mx::ElementEdit::Type>(elementEdit, "Type")
+        .value("TypeAddElement", mx::ElementEdit::TypeAddElement)
+        .value("TypeRemoveElement", mx::ElementEdit::TypeRemoveElement)
+        .value("TypeMoveElement", mx::ElementEdit::TypeMoveElement)
+        .value("TypeSetAttribute", mx::ElementEdit::TypeSetAttribute)
+        .value("TypeRemoveAttribute", mx::ElementEdit::TypeRemoveAttribute)
+        .export_values();
+
+    mod.def("diffDocuments", withoutGil(&mx::diffDocuments));
+    mod.def("applyPatch", &mx::applyPatch);
+}
@@ -16,14 +16,40 @@ void bindPyDocument(py::module& mod)
 {
     mod.def("createDocument", &mx::createDocument);
 
+    py::class_<mx::MemoryUsage>(mod, "MemoryUsage")
+        .def("getTotalBytes", &mx::MemoryUsage::getTotalBytes)
+        .def("getBytesPerElement", &mx::MemoryUsage::getBytesPerElement)
+        .def_readonly("elementCount", &mx::MemoryUsage::elementCount)
+        .def_readonly("categoryCounts", &mx::MemoryUsage::categoryCounts)
+        .def_readonly("categoryBytes", &mx::MemoryUsage::categoryBytes)
+        .def_readonly("elementBytes", &mx::MemoryUsage::elementBytes)
+        .def_readonly("attributeBytes", &mx::MemoryUsage::attributeBytes)
+        .def_readonly("childContainerBytes", &mx::MemoryUsage::childContainerBytes)
+        .def_readonly("cacheBytes", &mx::MemoryUsage::cacheBytes)
+        .def_readonly("stringBytes", &mx::MemoryUsage::stringBytes);
+
     py::class_<mx::Document, mx::DocumentPtr, mx::Element>(mod, "Document", py::metaclass())
         .def("initialize", &mx::Document::initialize)
         .def("copy", &mx::Document::copy)
         .def("importLibrary", &mx::Document::importLibrary)
+        .def("addReferencedLibrary", &mx::Document::addReferencedLibrary)
+        .def("removeReferencedLibrary", &mx::Document::removeReferencedLibrary)
+        .def("hasReferencedLibraries", &mx::Document::hasReferencedLibraries)
+        .def("getReferencedLibraries", [](const mx::Document& doc)
+            {
+                std::vector<mx::DocumentPtr> libraries;
+                for (mx::ConstDocumentPtr library : doc.getReferencedLibraries())
+                {
+                    libraries.push_back(std::const_pointer_cast<mx::Document>(library));
+                }
+                return libraries;
+            })
+        .def("traverseTreeWithLibraries", &mx::Document::traverseTreeWithLibraries)
         .def("setVersionString", &mx::Document::setVersionString)
         .def("hasVersionString", &mx::Document::hasVersionString)
         .def("getVersionString", &mx::Document::getVersionString)
         .def("getVersionIntegers", &mx::Document::getVersionIntegers)
+        .def("upgradeVersion", &mx::Document::upgradeVersion)
         .def("addNodeGraph", &mx::Document::addNodeGraph,
             py::arg("name") = mx::EMPTY_STRING)
         .def("getNodeGraph", &mx::Document::getNodeGraph)
@@ -61,6 +87,12 @@ void bindPyDocument(py::module& mod)
         .def("getNodeDefs", &mx::Document::getNodeDefs)
         .def("removeNodeDef", &mx::Document::removeNodeDef)
         .def("getMatchingNodeDefs", &mx::Document::getMatchingNodeDefs)
+        .def("getNodeDefForNode", &mx::Document::getNodeDefForNode)
+        .def("getNodeDefsForNodes", withoutGil(&mx::Document::getNodeDefsForNodes))
+        .def("getImplementationForNode", &mx::Document::getImplementationForNode,
+            py::arg("node"), py::arg("target") = mx::EMPTY_STRING, py::arg("language") = mx::EMPTY_STRING)
+        .def("getImplementationsForNodes", withoutGil(&mx::Document::getImplementationsForNodes),
+            py::arg("nodes"), py::arg("target") = mx::EMPTY_STRING, py::arg("language") = mx::EMPTY_STRING)
         .def("addPropertySet", &mx::Document::addPropertySet,
             py::arg("name") = mx::EMPTY_STRING)
         .def("getPropertySet", &mx::Document::getPropertySet)
@@ -73,6 +105,10 @@ void bindPyDocument(py::module& mod)
         .def("removeImplementation", &mx::Document::removeImplementation)
         .def("getPublicElement", &mx::Document::getPublicElement)
         .def("getPublicElements", &mx::Document::getPublicElements)
+        .def("getAllPublicElements", &mx::Document::getAllPublicElements)
+        .def("getRevision", &mx::Document::getRevision)
+        .def("getElementById", &mx::Document::getElementById)
+        .def("getElementIdBound", &mx::Document::getElementIdBound)
         .def("setRequireString", &mx::Document::setRequireString)
         .def("hasRequireString", &mx::Document::hasRequireString)
         .def("getRequireString", &mx::Document::getRequireString)
@@ -83,6 +119,7 @@ void bindPyDocument(py::module& mod)
         .def("setColorManagementConfig", &mx::Document::setColorManagementConfig)
         .def("hasColorManagementConfig", &mx::Document::hasColorManagementConfig)
         .def("getColorManagementConfig", &mx::Document::getColorManagementConfig)
+        .def("getMemoryUsage", withoutGil(&mx::Document::getMemoryUsage))
         .def("getFilenameStringMap", &mx::Document::getFilenameStringMap)
         .def("applyStringSubstitutions", &mx::Document::applyStringSubstitutions);
 }
@@ -12,9 +12,13 @@
 #include <MaterialXCore/Node.h>
 #include <MaterialXCore/Traversal.h>
 
+#include <PyBind11/numpy.h>
 #include <PyBind11/operators.h>
 #include <PyBind11/stl.h>
 
+#include <limits>
+#include <sstream>
+
 #define BIND_ELEMENT_FUNC_INSTANCE(T)                                                                           \
 .def("_addChild" #T, &mx::Element::addChild<mx::T>)                                                             \
 .def("_getChildOfType" #T, &mx::Element::getChildOfType<mx::T>)                                                 \
@@ -27,6 +31,179 @@
 namespace py = pybind11;
 namespace mx = MaterialX;
 
+namespace {
+
+// Return the number of float components in the given value type, or zero
+// if the type cannot be represented as an array of floats.
+size_t getFloatComponentCount(const std::string& type)
+{
+    if (type == mx::getTypeString<float>())
+        return 1;
+    if (type == mx::getTypeString<mx::Color2>() || type == mx::getTypeString<mx::Vector2>())
+        return 2;
+    if (type == mx::getTypeString<mx::Color3>() || type == mx::getTypeString<mx::Vector3>())
+        return 3;
+    if (type == mx::getTypeString<mx::Color4>() || type == mx::getTypeString<mx::Vector4>())
+        return 4;
+    if (type == mx::getTypeString<mx::Matrix3x3>())
+        return 9;
+    if (type == mx::getTypeString<mx::Matrix4x4>())
+        return 16;
+    return 0;
+}
+
+template <class T> bool copyVectorData(const mx::Value& value, float* dest)
+{
+    if (!value.isA<T>())
+        return false;
+    T data = value.asA<T>();
+    std::copy(data.data.begin(), data.data.end(), dest);
+    return true;
+}
+
+// Copy the components of the given value to the destination buffer.
+bool copyValueData(const mx::Value& value, float* dest)
+{
+    if (value.isA<float>())
+    {
+        *dest = value.asA<float>();
+        return true;
+    }
+    return copyVectorData<mx::Color2>(value, dest) ||
+           copyVectorData<mx::Color3>(value, dest) ||
+           copyVectorData<mx::Color4>(value, dest) ||
+           copyVectorData<mx::Vector2>(value, dest) ||
+           copyVectorData<mx::Vector3>(value, dest) ||
+           copyVectorData<mx::Vector4>(value, dest) ||
+           copyVectorData<mx::Matrix3x3>(value, dest) ||
+           copyVectorData<mx::Matrix4x4>(value, dest);
+}
+
+// Format the components in the source buffer as a value string, matching
+// the formatting of Value::getValueString.
+std::string formatValueString(const float* src, size_t componentCount, std::ostringstream& stream)
+{
+    stream.str(std::string());
+    for (size_t i = 0; i < componentCount; i++)
+    {
+        if (i)
+            stream << ", ";
+        stream << src[i];
+    }
+    return stream.str();
+}
+
+// Return the values of the given elements as an (N, k) array of floats,
+// where k is the number of components in the given type.  If no type is
+// specified, then the type of the first element is used.  Elements without
+// a valid value are returned as rows of NaN.
+py::array_t<float> getValuesAsArray(const std::vector<mx::ValueElementPtr>& elems, std::string type)
+{
+    if (type.empty() && !elems.empty())
+        type = elems[0]->getType();
+    size_t componentCount = getFloatComponentCount(type);
+    if (!componentCount)
+        throw mx::Exception("Unsupported type for array conversion: " + type);
+
+    py::array_t<float> array(std::vector<size_t>{ elems.size(), componentCount });
+    float* data = array.mutable_data();
+    {
+        py::gil_scoped_release release;
+        for (size_t i = 0; i < elems.size(); i++)
+        {
+            if (elems[i]->getType() != type)
+                throw mx::Exception("Mismatched type in array conversion: " + elems[i]->asString());
+            float* row = data + i * componentCount;
+            mx::ValuePtr value = elems[i]->getValue();
+            if (!value || !copyValueData(*value, row))
+                std::fill(row, row + componentCount, std::numeric_limits<float>::quiet_NaN());
+        }
+    }
+    return array;
+}
+
+// Set the values of the given elements from an (N, k) array of floats, where
+// k is the number of components in the given type.
+void setValuesFromArray(const std::vector<mx::ValueElementPtr>& elems,
+                        py::array_t<float, py::array::c_style | py::array::forcecast> array,
+                        const std::string& type)
+{
+    size_t componentCount = getFloatComponentCount(type);
+    if (!componentCount)
+        throw mx::Exception("Unsupported type for array conversion: " + type);
+    size_t rowSize = array.ndim() == 2 ? array.shape(1) : 1;
+    if (array.ndim() < 1 || array.ndim() > 2 || array.shape(0) != elems.size() || rowSize != componentCount)
+        throw mx::Exception("Array shape does not match the given elements and type: " + type);
+
+    // Format the value strings without the GIL, and then assign them with
+    // the GIL held, since the elements are modified.
+    const float* data = array.data();
+    std::vector<std::string> valueStrings(elems.size());
+    {
+        py::gil_scoped_release release;
+        std::ostringstream stream;
+        for (size_t i = 0; i < elems.size(); i++)
+            valueStrings[i] = formatValueString(data + i * componentCount, componentCount, stream);
+    }
+    for (size_t i = 0; i < elems.size(); i++)
+    {
+        elems[i]->setType(type);
+        elems[i]->setValueString(valueStrings[i]);
+    }
+}
+
+// Return the elements of the given subtree in pre-order, gathered in a single
+// native call rather than one iterator step at a time.
+std::vector<mx::ElementPtr> traverseTreeAsList(const mx::Element& elem)
+{
+    py::gil_scoped_release release;
+    std::vector<mx::ElementPtr> elems;
+    for (mx::ElementPtr child : elem.traverseTree())
+        elems.push_back(child);
+    return elems;
+}
+
+// Return the elements of the given subtree in pre-order as parallel lists of
+// parent indices, depths, categories, and names, allowing large documents to
+// be summarized without creating a Python wrapper for each element.  The
+// parent index of the traversal root is -1.
+py::tuple traverseTreeAsArrays(const mx::Element& elem)
+{
+    std::vector<int> parentIndices;
+    std::vector<int> depths;
+    std::vector<std::string> categories;
+    std::vector<std::string> names;
+    {
+        py::gil_scoped_release release;
+        std::vector<int> ancestorIndices;
+        for (mx::TreeIterator it = elem.traverseTree().begin(); it != mx::TreeIterator::end(); ++it)
+        {
+            mx::ElementPtr child = it.getElement();
+            size_t depth = it.getElementDepth();
+            ancestorIndices.resize(depth);
+            parentIndices.push_back(depth ? ancestorIndices.back() : -1);
+            depths.push_back((int) depth);
+            categories.push_back(child->getCategory());
+            names.push_back(child->getName());
+            ancestorIndices.push_back((int) names.size() - 1);
+        }
+    }
+    return py::make_tuple(parentIndices, depths, categories, names);
+}
+
+// Return the edges of the dataflow graph upstream of the given element in
+// pre-order, gathered in a single native call.
+std::vector<mx::Edge> traverseGraphAsList(const mx::Element& elem, mx::MaterialPtr material)
+{
+    py::gil_scoped_release release;
+    std::vector<mx::Edge> edges;
+    for (mx::Edge edge : elem.traverseGraph(material))
+        edges.push_back(edge);
+    return edges;
+}
+
+} // anonymous namespace
+
 void bindPyElement(py::module& mod)
 {
     py::class_<mx::Element, mx::ElementPtr>(mod, "Element", py::metaclass())
@@ -34,9 +211,14 @@ void bindPyElement(py::module& mod)
         .def(py::self != py::self)
         .def("setCategory", &mx::Element::setCategory)
         .def("getCategory", &mx::Element::getCategory)
+        .def("setName", &mx::Element::setName,
+            py::arg("name"), py::arg("updateConnections") = false)
         .def("getName", &mx::Element::getName)
+        .def("getId", &mx::Element::getId)
         .def("getNamePath", &mx::Element::getNamePath,
             py::arg("relativeTo") = mx::ConstElementPtr())
+        .def("getContentHash", withoutGil(&mx::Element::getContentHash),
+            py::arg("includeName") = true)
         .def("setFilePrefix", &mx::Element::setFilePrefix)
         .def("hasFilePrefix", &mx::Element::hasFilePrefix)
         .def("getFilePrefix", &mx::Element::getFilePrefix)
@@ -55,6 +237,8 @@ void bindPyElement(py::module& mod)
         .def("getChildren", &mx::Element::getChildren)
         .def("setChildIndex", &mx::Element::setChildIndex)
         .def("getChildIndex", &mx::Element::getChildIndex)
+        .def("moveTo", &mx::Element::moveTo,
+            py::arg("parent"), py::arg("index") = -1)
         .def("removeChild", &mx::Element::removeChild)
         .def("setAttribute", &mx::Element::setAttribute)
         .def("hasAttribute", &mx::Element::hasAttribute)
@@ -68,6 +252,10 @@ void bindPyElement(py::module& mod)
         .def("traverseTree", &mx::Element::traverseTree)
         .def("traverseGraph", &mx::Element::traverseGraph,
             py::arg("material") = mx::MaterialPtr())
+        .def("traverseTreeAsList", &traverseTreeAsList)
+        .def("traverseTreeAsArrays", &traverseTreeAsArrays)
+        .def("traverseGraphAsList", &traverseGraphAsList,
+            py::arg("material") = mx::MaterialPtr())
         .def("getUpstreamEdge", &mx::Element::getUpstreamEdge,
             py::arg("material") = mx::MaterialPtr(), py::arg("index") = 0)
         .def("getUpstreamEdgeCount", &mx::Element::getUpstreamEdgeCount)
@@ -79,6 +267,7 @@ void bindPyElement(py::module& mod)
         .def("getSourceUri", &mx::Element::getSourceUri)
         .def("validate", [](mx::Element& elem)
             {
+                py::gil_scoped_release release;
                 std::string message;
                 bool res = elem.validate(&message);
                 return std::pair<bool, std::string>(res, message);
@@ -147,6 +336,11 @@ void bindPyElement(py::module& mod)
         BIND_VALUE_ELEMENT_FUNC_INSTANCE(matrix44, mx::Matrix4x4)
         BIND_VALUE_ELEMENT_FUNC_INSTANCE(string, std::string);
 
+    mod.def("getValuesAsArray", &getValuesAsArray,
+        py::arg("elements"), py::arg("type") = mx::EMPTY_STRING);
+    mod.def("setValuesFromArray", &setValuesFromArray,
+        py::arg("elements"), py::arg("array"), py::arg("type"));
+
     py::class_<mx::ElementPredicate>(mod, "ElementPredicate");
 
     py::register_exception<mx::ExceptionOrphanedElement>(mod, "ExceptionOrphanedElement");
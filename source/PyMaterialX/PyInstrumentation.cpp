@@ -0,0 +1,33 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <PyMaterialX/PyMaterialX.h>
+
+#include <MaterialXCore/Instrumentation.h>
+
+#include <PyBind11/stl.h>
+
+namespace py = pybind11;
+namespace mx = MaterialX;
+
+void bindPyInstrumentation(py::module& mod)
+{
+    py::class_<mx::TimerStats>(mod, "TimerStats")
+        .def_readonly("count", &mx::TimerStats::count)
+        .def_readonly("totalTime", &mx::TimerStats::totalTime)
+        .def_readonly("minTime", &mx::TimerStats::minTime)
+        .def_readonly("maxTime", &mx::TimerStats::maxTime);
+
+    py::class_<mx::Instrumentation>(mod, "Instrumentation")
+        .def_static("setEnabled", &mx::Instrumentation::setEnabled)
+        .def_static("isEnabled", &mx::Instrumentation::isEnabled)
+        .def_static("incrementCounter", &mx::Instrumentation::incrementCounter,
+            py::arg("name"), py::arg("amount") = 1)
+        .def_static("reset", &mx::Instrumentation::reset)
+        .def_static("getTimerStats", &mx::Instrumentation::getTimerStats)
+        .def_static("getCounters", &mx::Instrumentation::getCounters)
+        .def_static("getReport", &mx::Instrumentation::getReport)
+        .def_static("getChromeTrace", &mx::Instrumentation::getChromeTrace);
+}
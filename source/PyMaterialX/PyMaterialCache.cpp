@@ -0,0 +1,26 @@
+//
+// TM & (c) 2017 Lucasfilm Entertainment Company Ltd. and Lucasfilm Ltd.
+// All rights reserved.  See LICENSE.txt for license.
+//
+
+#include <PyMaterialX/PyMaterialX.h>
+
+#include <MaterialXCore/MaterialCache.h>
+
+#include <PyBind11/stl.h>
+
+namespace py = pybind11;
+namespace mx = MaterialX;
+
+void bindPyMaterialCache(py::module& mod)
+{
+    py::class_<mx::MaterialSignature>(mod, "MaterialSignature")
+        .def(py::init<>())
+        .def("getParameterCount", &mx::MaterialSignature::getParameterCount)
+        .def("hasMatchingLayout", &mx::MaterialSignature::hasMatchingLayout)
+        .def_readwrite("topologyKey", &mx::MaterialSignature::topologyKey)
+        .def_readwrite("parameterNames", &mx::MaterialSignature::parameterNames)
+        .def_readwrite("parameterValues", &mx::MaterialSignature::parameterValues);
+
+    mod.def("getMaterialSignature", &mx::getMaterialSignature);
+}
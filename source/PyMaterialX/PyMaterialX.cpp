@@ -15,14 +15,18 @@
 namespace py = pybind11;
 
 // Forward Declared Binding Functions
+void bindPyColumnar(py::module& mod);
 void bindPyDefinition(py::module& mod);
+void bindPyDiff(py::module& mod);
 void bindPyDocument(py::module& mod);
 void bindPyElement(py::module& mod);
 void bindPyException(py::module& mod);
 void bindPyGeom(py::module& mod);
+void bindPyInstrumentation(py::module& mod);
 void bindPyInterface(py::module& mod);
 void bindPyLook(py::module& mod);
 void bindPyMaterial(py::module& mod);
+void bindPyMaterialCache(py::module& mod);
 void bindPyNode(py::module& mod);
 void bindPyProperty(py::module& mod);
 void bindPyTraversal(py::module& mod);
@@ -50,6 +54,10 @@ PYBIND11_PLUGIN(PyMaterialX)
     bindPyUtil(mod);
     bindPyException(mod);
     bindPyXmlIo(mod);
+    bindPyColumnar(mod);
+    bindPyInstrumentation(mod);
+    bindPyDiff(mod);
+    bindPyMaterialCache(mod);
 
     return mod.ptr();
 }
@@ -17,6 +17,53 @@
 
 #include <PyBind11/pybind11.h>
 
+#include <functional>
+
 PYBIND11_DECLARE_HOLDER_TYPE(holder, std::shared_ptr<holder>);
 
+//
+// The following helpers wrap a C++ function in a callable that releases the
+// Python GIL for the duration of the call, allowing long-running operations
+// to execute concurrently with other Python threads.  Arguments are converted
+// before the GIL is released, and return values are converted after it has
+// been reacquired.
+//
+// As in C++, a document may be read from multiple threads at once, but must
+// not be modified while any other thread accesses it.  The GIL is released
+// by queries whose cost outweighs that of releasing and reacquiring it,
+// including queries that lazily rebuild the caches of a document, since
+// these caches are synchronized internally.  Operations that modify a
+// document hold the GIL, as they notify its observers, with the exception
+// of reads from XML into a new document owned by the calling thread.
+// Python callbacks, such as element predicates, reacquire the GIL for the
+// duration of each call.
+//
+
+template <class R, class... Args> std::function<R(Args...)> withoutGil(R (*func)(Args...))
+{
+    return [func](Args... args) -> R
+    {
+        pybind11::gil_scoped_release release;
+        return func(std::forward<Args>(args)...);
+    };
+}
+
+template <class R, class C, class... Args> std::function<R(C&, Args...)> withoutGil(R (C::*func)(Args...))
+{
+    return [func](C& self, Args... args) -> R
+    {
+        pybind11::gil_scoped_release release;
+        return (self.*func)(std::forward<Args>(args)...);
+    };
+}
+
+template <class R, class C, class... Args> std::function<R(const C&, Args...)> withoutGil(R (C::*func)(Args...) const)
+{
+    return [func](const C& self, Args... args) -> R
+    {
+        pybind11::gil_scoped_release release;
+        return (self.*func)(std::forward<Args>(args)...);
+    };
+}
+
 #endif
@@ -20,7 +20,8 @@ void bindPyNode(py::module& mod)
         .def("setConnectedNodeName", &mx::Node::setConnectedNodeName)
         .def("getConnectedNodeName", &mx::Node::getConnectedNodeName)
         .def("getReferencedNodeDef", &mx::Node::getReferencedNodeDef)
-        .def("getImplementation", &mx::Node::getImplementation)
+        .def("getImplementation", &mx::Node::getImplementation,
+            py::arg("target") = mx::EMPTY_STRING, py::arg("language") = mx::EMPTY_STRING)
         .def("getDownstreamPorts", &mx::Node::getDownstreamPorts)
         .def_readonly_static("CATEGORY", &mx::Node::CATEGORY);
 
@@ -40,5 +41,6 @@ void bindPyNode(py::module& mod)
         .def("removeOutput", &mx::NodeGraph::removeOutput)
         .def("flattenSubgraphs", &mx::NodeGraph::flattenSubgraphs,
             py::arg("target") = mx::EMPTY_STRING)
+        .def("topologicalSort", withoutGil(&mx::NodeGraph::topologicalSort))
         .def_readonly_static("CATEGORY", &mx::NodeGraph::CATEGORY);
 }
@@ -19,6 +19,9 @@ void bindPyObserver(py::module& mod)
     py::class_<mx::Observer, std::shared_ptr<mx::Observer> >(mod, "Observer")
         .def("onAddElement", &mx::Observer::onAddElement)
         .def("onRemoveElement", &mx::Observer::onRemoveElement)
+        .def("onRemoveElements", &mx::Observer::onRemoveElements)
+        .def("onRenameElement", &mx::Observer::onRenameElement)
+        .def("onMoveElement", &mx::Observer::onMoveElement)
         .def("onSetAttribute", &mx::Observer::onSetAttribute)
         .def("onRemoveAttribute", &mx::Observer::onSetAttribute)
         .def("onInitialize", &mx::Observer::onInitialize)
@@ -15,11 +15,32 @@
 namespace py = pybind11;
 namespace mx = MaterialX;
 
+namespace {
+
+// Return a buffer description for the given vector, allowing its data to be
+// viewed through the Python buffer protocol without copying.
+template <class V> py::buffer_info vectorBuffer(V& vec)
+{
+    return py::buffer_info(vec.data.data(), sizeof(float), py::format_descriptor<float>::format(),
+                           1, { vec.data.size() }, { sizeof(float) });
+}
+
+// Return a buffer description for the given square matrix, with rows and
+// columns exposed as the two dimensions of the buffer.
+template <class M, size_t N> py::buffer_info matrixBuffer(M& mat)
+{
+    return py::buffer_info(mat.data.data(), sizeof(float), py::format_descriptor<float>::format(),
+                           2, { N, N }, { N * sizeof(float), sizeof(float) });
+}
+
+} // anonymous namespace
+
 void bindPyTypes(py::module& mod)
 {
     py::class_<mx::VectorBase>(mod, "VectorBase");
 
-    py::class_<mx::Vector2, mx::VectorBase>(mod, "Vector2")
+    py::class_<mx::Vector2, mx::VectorBase>(mod, "Vector2", py::buffer_protocol())
+        .def_buffer(&vectorBuffer<mx::Vector2>)
         .def(py::init<>())
         .def(py::init<float, float>())
         .def(py::init<const mx::Vector2&>())
@@ -41,7 +62,8 @@ void bindPyTypes(py::module& mod)
             }
         );
 
-    py::class_<mx::Vector3, mx::VectorBase>(mod, "Vector3")
+    py::class_<mx::Vector3, mx::VectorBase>(mod, "Vector3", py::buffer_protocol())
+        .def_buffer(&vectorBuffer<mx::Vector3>)
         .def(py::init<>())
         .def(py::init<float, float, float>())
         .def(py::init<const mx::Vector3&>())
@@ -63,7 +85,8 @@ void bindPyTypes(py::module& mod)
             }
         );
 
-    py::class_<mx::Vector4, mx::VectorBase>(mod, "Vector4")
+    py::class_<mx::Vector4, mx::VectorBase>(mod, "Vector4", py::buffer_protocol())
+        .def_buffer(&vectorBuffer<mx::Vector4>)
         .def(py::init<>())
         .def(py::init<float, float, float, float>())
         .def(py::init<const mx::Vector4&>())
@@ -85,7 +108,8 @@ void bindPyTypes(py::module& mod)
             }
         );
 
-    py::class_<mx::Matrix3x3, mx::VectorBase>(mod, "Matrix3x3")
+    py::class_<mx::Matrix3x3, mx::VectorBase>(mod, "Matrix3x3", py::buffer_protocol())
+        .def_buffer(&matrixBuffer<mx::Matrix3x3, 3>)
         .def(py::init<>())
         .def(py::init<const mx::Matrix3x3&>())
         .def(py::init<const std::array<float, 9>&>())
@@ -105,7 +129,8 @@ void bindPyTypes(py::module& mod)
             }
         );
 
-    py::class_<mx::Matrix4x4, mx::VectorBase>(mod, "Matrix4x4")
+    py::class_<mx::Matrix4x4, mx::VectorBase>(mod, "Matrix4x4", py::buffer_protocol())
+        .def_buffer(&matrixBuffer<mx::Matrix4x4, 4>)
         .def(py::init<>())
         .def(py::init<const mx::Matrix4x4&>())
         .def(py::init<const std::array<float, 16>&>())
@@ -125,7 +150,8 @@ void bindPyTypes(py::module& mod)
             }
         );
 
-    py::class_<mx::Color2, mx::Vector2>(mod, "Color2")
+    py::class_<mx::Color2, mx::Vector2>(mod, "Color2", py::buffer_protocol())
+        .def_buffer(&vectorBuffer<mx::Color2>)
         .def(py::init<>())
         .def(py::init<float, float>())
         .def(py::init<const mx::Color2&>())
@@ -134,7 +160,8 @@ void bindPyTypes(py::module& mod)
         .def(py::self == py::self)
         .def(py::self != py::self);
 
-    py::class_<mx::Color3, mx::Vector3>(mod, "Color3")
+    py::class_<mx::Color3, mx::Vector3>(mod, "Color3", py::buffer_protocol())
+        .def_buffer(&vectorBuffer<mx::Color3>)
         .def(py::init<>())
         .def(py::init<float, float, float>())
         .def(py::init<const mx::Color3&>())
@@ -143,7 +170,8 @@ void bindPyTypes(py::module& mod)
         .def(py::self == py::self)
         .def(py::self != py::self);
 
-    py::class_<mx::Color4, mx::Vector4>(mod, "Color4")
+    py::class_<mx::Color4, mx::Vector4>(mod, "Color4", py::buffer_protocol())
+        .def_buffer(&vectorBuffer<mx::Color4>)
         .def(py::init<>())
         .def(py::init<float, float, float, float>())
         .def(py::init<const mx::Color4&>())
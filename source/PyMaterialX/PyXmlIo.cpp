@@ -15,12 +15,12 @@ namespace mx = MaterialX;
 
 void bindPyXmlIo(py::module& mod)
 {
-    mod.def("readFromXmlFileBase", &mx::readFromXmlFile,
+    mod.def("readFromXmlFileBase", withoutGil(&mx::readFromXmlFile),
         py::arg("doc"), py::arg("filename"), py::arg("searchPath") = mx::EMPTY_STRING, py::arg("readXIncludes") = true);
-    mod.def("readFromXmlString", &mx::readFromXmlString);
-    mod.def("writeToXmlFile", mx::writeToXmlFile,
+    mod.def("readFromXmlString", withoutGil(&mx::readFromXmlString));
+    mod.def("writeToXmlFile", withoutGil(&mx::writeToXmlFile),
         py::arg("doc"), py::arg("filename"), py::arg("writeXIncludes") = true, py::arg("predicate") = mx::ElementPredicate());
-    mod.def("writeToXmlString", mx::writeToXmlString,
+    mod.def("writeToXmlString", withoutGil(&mx::writeToXmlString),
         py::arg("doc"), py::arg("writeXIncludes") = true, py::arg("predicate") = mx::ElementPredicate());
     mod.def("prependXInclude", mx::prependXInclude);
 